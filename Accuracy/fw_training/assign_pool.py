@@ -0,0 +1,40 @@
+#re-assign the weights of a trained network to a weight pool on the CPU and write the runtime index arrays
+#usage: python3 assign_pool.py --weights ../weight_pool_weights/resnet14_cifar_zdim64.pth
+#           --pool ../cluster_centers/resnet14_cifar_clustercenter_zdim64.npy --name resnet_14_index --out resnet_14_index_data.h
+#layers are numbered by their position among the conv weights of the state dict, so the dense first layer is layer_1
+#and is skipped (its input channels are not a multiple of 8), like in Runtime/index_data
+import argparse
+import re
+import time
+import numpy as np
+import torch
+import lut_emulator
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--weights", help="state dict of the network (.pth)", required = True)
+parser.add_argument("--pool", help="cluster centers of the weight pool (.npy), shape [N,8]", required = True)
+parser.add_argument("--name", help="array name prefix, e.g. resnet_14_index", required = True)
+parser.add_argument("--out", help="output header", required = True)
+parser.add_argument("--metric", help="l2, cossim or mixednorm", default = "cossim")
+parser.add_argument("--skip", help="regex of weight names to leave out (e.g. downsample)", default = None)
+parser.add_argument("--threads", help="number of CPU threads", type = int, default = 0)
+args = parser.parse_args()
+
+if args.threads > 0:
+    torch.set_num_threads(args.threads)
+state_dict = torch.load(args.weights, map_location = 'cpu')
+if 'state_dict' in state_dict:
+    state_dict = state_dict['state_dict']
+pool = torch.from_numpy(np.load(args.pool)).float()
+
+convs = [(name, w) for name, w in state_dict.items() if name.endswith('weight') and w.dim() == 4]
+layers = []
+start = time.time()
+for layer_cnt, (name, w) in enumerate(convs, 1):
+    if args.skip is not None and re.search(args.skip, name):
+        continue
+    for _, index in lut_emulator.assign_layers([(name, w)], pool, args.metric):
+        layers.append((layer_cnt, index))
+        print("layer_{} {} {} -> {} indices".format(layer_cnt, name, tuple(w.shape), index.size))
+print("assigned {} layers in {:.2f} s".format(len(layers), time.time() - start))
+lut_emulator.write_index_header(args.out, args.name, layers)
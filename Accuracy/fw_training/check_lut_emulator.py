@@ -0,0 +1,76 @@
+#parity check of the native LUT emulator (lut_emulator.conv2d_lut_zdim) against the python window loop of
+#conv2d_lut_zdim_stride in the *_prec_sweep_lut.py scripts, on random bit streams and pool weights
+#usage: python3 check_lut_emulator.py [--seed 0]
+#covers the output geometry of every script (trim = k_size - k_size // 2 for resnet, k_size - 1 for tinyconv, 0 for
+#mobilenetv2) with stride 1 and 2. The pool weights are multiples of 1/64, so the partial sums are exact in float
+#and both sides must agree on every quantisation step
+import argparse
+import math
+import torch
+import lut_emulator
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--seed", help="random seed", type = int, default = 0)
+args = parser.parse_args()
+
+def quantization_n(input, n = 8, rangeq = 1):
+    intv = (rangeq*2)/(2**n-1)
+    qunt = torch.round(torch.mul(input,(1/intv)))
+    out = torch.mul(qunt,intv)
+    out = torch.clamp(out, min=-rangeq, max=rangeq)
+    return(out)
+
+def reference_conv2d_lut_zdim(input, weight, max_val, act_prec, stride, trim, psumbw, maxval):
+    #the window loop of conv2d_lut_zdim_stride, with the script specific output size and window range as trim
+    group_size = 8
+    scale_vec = torch.zeros(act_prec)
+    for i in range(act_prec):
+        scale_vec[i] = 1 if i == 0 else scale_vec[i-1]*2
+    scale_vec = torch.flip(scale_vec,[0])
+    scale_vec = scale_vec/(torch.max(scale_vec)/(max_val/2))
+    input_shape = input.shape
+    k_size = weight.shape[2]
+    output = torch.zeros(input_shape[0], weight.shape[0], int((input_shape[2]-trim)/stride), int((input_shape[3]-trim)/stride))
+    sign = input[...,0].unsqueeze(-1)
+    input = input[...,1:] * sign.repeat(1,1,1,1,act_prec)
+    input = input.permute(0,4,1,2,3)
+    input = input.reshape(input.shape[0],input.shape[1],int(input.shape[2]/group_size),group_size,input.shape[3],input.shape[4])
+    weight = weight.reshape(weight.shape[0],int(weight.shape[1]/group_size),group_size,weight.shape[2],weight.shape[3])
+    input = input.permute(0,2,4,5,1,3).unsqueeze(1)
+    weight = weight.permute(0,1,3,4,2).unsqueeze(4)
+    for win_x in range(0,input_shape[2]-trim, stride):
+        for win_y in range(0, input_shape[3]-trim, stride):
+            input_patch = input[...,win_x:win_x+k_size,win_y:win_y+k_size,:,:]
+            psum_z = torch.sum(input_patch * weight, (-1))
+            psum_z.data = quantization_n(psum_z.data,psumbw,maxval)
+            psum_bit = torch.sum(psum_z*scale_vec, -1)
+            output[...,int(win_x/stride),int(win_y/stride)] = torch.sum(psum_bit, (-1,-2,-3))
+    return output
+
+if not lut_emulator.available():
+    raise SystemExit("the native lut_emulator extension is not available")
+
+torch.manual_seed(args.seed)
+act_prec, max_val, psumbw, maxval = 5, 2.0, 5, 1.0
+#(script, k_size, stride, input size), the input sizes are the padded sizes the scripts pass
+cases = [("resnet", 3, 1, 10), ("resnet", 3, 2, 10), ("resnet", 1, 1, 8), ("resnet", 1, 2, 9),
+         ("tinyconv", 5, 1, 12), ("tinyconv", 5, 2, 12), ("mobilenetv2", 1, 1, 8), ("mobilenetv2", 1, 2, 8)]
+failed = 0
+for script, k_size, stride, size in cases:
+    trim = {"resnet": k_size - k_size // 2, "tinyconv": k_size - 1, "mobilenetv2": 0}[script]
+    B, C, F = 2, 16, 12
+    bits = torch.randint(0, 2, (B, C, size, size, 1 + act_prec)).float()
+    bits[..., 0] = 1
+    pool = torch.randint(-32, 33, (16, 8)).float() / 64
+    choice = torch.randint(0, pool.shape[0], (F, C // 8, k_size, k_size))
+    weight = pool[choice].permute(0, 1, 4, 2, 3).reshape(F, C, k_size, k_size)
+
+    ref = reference_conv2d_lut_zdim(bits, weight, max_val, act_prec, stride, trim, psumbw, maxval)
+    out = lut_emulator.conv2d_lut_zdim(bits, weight, None, max_val, stride, psumbw, maxval, trim)
+    ok = out.shape == ref.shape and torch.allclose(out, ref, rtol = 1e-5, atol = 1e-5)
+    failed += not ok
+    diff = (out - ref).abs().max().item() if out.shape == ref.shape else math.inf
+    print("{:<12} k {} stride {} input {:>2}: output {} reference {} max diff {:.2e} {}".format(
+        script, k_size, stride, size, list(out.shape[2:]), list(ref.shape[2:]), diff, "ok" if ok else "MISMATCH"))
+if failed:
+    raise SystemExit("{} of {} cases differ".format(failed, len(cases)))
@@ -0,0 +1,49 @@
+#generate weight pools from a trained network on the CPU (k-means of all 8-wide weight vectors)
+#usage: python3 gen_pool.py --weights ../weights/resnet14_cifar.pth --name resnet14_cifar --sizes 32 64 128
+#writes <name>_clustercenter_zdim<size>.npy (what the *_wp_zdim_auto.py scripts load) and, with --header,
+#<name>_pool<size>.h with the int8 pool vectors for LUT generation
+import argparse
+import os
+import time
+import numpy as np
+import torch
+import lut_emulator
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--weights", help="state dict of the trained network (.pth)", required = True)
+parser.add_argument("--name", help="output name prefix, e.g. resnet14_cifar", required = True)
+parser.add_argument("--out-dir", help="output folder", default = "../cluster_centers")
+parser.add_argument("--sizes", help="pool sizes", type = int, nargs = '+', default = [32, 64, 128])
+parser.add_argument("--distance", help="cosine or euclidean", default = "cosine")
+parser.add_argument("--tol", type = float, default = 1e-4)
+parser.add_argument("--batch-size", help="mini-batch size, 0 for full batch", type = int, default = 0)
+parser.add_argument("--seed", type = int, default = 0)
+parser.add_argument("--header", help="also write the C header of every pool", action = 'store_true')
+parser.add_argument("--threads", help="number of CPU threads", type = int, default = 0)
+args = parser.parse_args()
+
+if args.threads > 0:
+    torch.set_num_threads(args.threads)
+state_dict = torch.load(args.weights, map_location = 'cpu')
+if 'state_dict' in state_dict:
+    state_dict = state_dict['state_dict']
+
+#same vectors as the original_model_training scripts: conv weights permuted to (K,X,Y,C), 8 channels per vector.
+#the dense first layer (input channels not a multiple of 8) is left out
+vectors = []
+for name, w in state_dict.items():
+    if name.endswith('weight') and w.dim() == 4 and w.shape[1] % 8 == 0:
+        vectors.append(w.permute(0, 2, 3, 1).reshape(-1, 8).float())
+x = torch.cat(vectors, 0)
+print("{} weight vectors from {} layers".format(x.shape[0], len(vectors)))
+
+os.makedirs(args.out_dir, exist_ok = True)
+for n_cluster in args.sizes:
+    start = time.time()
+    _, centers = lut_emulator.kmeans(x, n_cluster, distance = args.distance, tol = args.tol,
+                                     batch_size = args.batch_size, seed = args.seed)
+    print("pool {}: {:.2f} s".format(n_cluster, time.time() - start))
+    np.save(os.path.join(args.out_dir, args.name + "_clustercenter_zdim" + str(n_cluster) + ".npy"), centers.numpy())
+    if args.header:
+        lut_emulator.write_pool_header(os.path.join(args.out_dir, args.name + "_pool" + str(n_cluster) + ".h"),
+                                       args.name + "_pool" + str(n_cluster), centers)
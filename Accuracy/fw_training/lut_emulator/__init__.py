@@ -0,0 +1,107 @@
+#native CPU tools for weight pool networks: LUT convolution emulator (lut_emulator.h), pool assignment (pool_assign.h)
+#and pool generation (kmeans8.h)
+#uses the extension built by setup.py, otherwise compiles it on first import (needs a C++ compiler)
+import os
+import numpy as np
+import torch
+
+_native = None
+try:
+    from . import _lut_emulator as _native
+except ImportError:
+    try:
+        from torch.utils.cpp_extension import load
+        _src = os.path.dirname(os.path.abspath(__file__))
+        _native = load(name='_lut_emulator', sources=[os.path.join(_src, 'lut_emulator.cpp')],
+                       extra_cflags=['-O3'], verbose=False)
+    except Exception as e:
+        print("lut_emulator: native extension not available ({}), using the python window loop".format(e))
+
+def available():
+    return _native is not None
+
+def conv2d_lut_zdim(input, weight, bias, max_val, stride, psumbw, maxval, trim):
+    #drop-in for conv2d_lut_zdim_stride of the *_prec_sweep_lut.py scripts, input is the [B,C,X,Y,1+act_prec]
+    #bit stream of bit_stream_gen_pos_round (already padded) and weight the pool-selected [F,C,x,y] weight.
+    #the output is int((X - trim) / stride) wide, trim is k_size - k_offset of the resnet and tinyconv scripts and 0
+    #in mobilenetv2
+    output = _native.conv2d_lut_zdim(input, weight, float(max_val), int(stride), int(trim), int(psumbw),
+                                     float(maxval)).to(input.device)
+    if bias is not None:
+        output = output + bias.reshape(1, bias.shape[0], 1, 1)
+    return output
+
+def conv2d_lut_index(input, kernel_idx, lut, out_ch, kernel_size, stride=1, padding=0, input_offset=0, prec=5, wrap16=False):
+    #int32 accumulators of lut_conv_zdim_v1/v2 (before bias and requantization) for an int8 NHWC input, kernel_idx
+    #and lut in the runtime layout (index_data/*, lut_zdim64_data.h). wrap16=True reproduces the 16-bit holder
+    return _native.conv2d_lut_index(input, kernel_idx, lut, int(out_ch), int(kernel_size), int(kernel_size),
+                                    int(stride), int(padding), int(input_offset), int(prec), bool(wrap16))
+
+METRICS = {'l2': 0, 'cossim': 1, 'mixednorm': 2}
+
+def pool_assign(groups, kernel_pool, metric='cossim'):
+    #index of the nearest pool vector for every 8-wide group, same choice as find_optimal_l2/cossim/mixednorm
+    #groups [..., 8], kernel_pool [N, 8], returns int64 [groups.numel()/8] on the groups' device
+    return _native.pool_assign(groups, kernel_pool, METRICS[metric]).long().to(groups.device)
+
+def select_kernel_channelwise(input, kernel_pool, metric='cossim'):
+    #drop-in for select_kernel_channelwise of the *_wp_zdim_auto.py scripts, input is (K,X,Y,C)
+    idx = pool_assign(input, kernel_pool, metric)
+    return kernel_pool.to(input.device)[idx].reshape(input.shape).to(input.dtype)
+
+def layer_index(weight, kernel_pool, metric='cossim'):
+    #runtime index array of a conv layer, weight is the torch [F,C,KY,KX] weight. Entry [block*F + f] is the pool
+    #vector of block (ky, kx, channel group) of filter f, the order lut_conv_zdim_* read kernel_idx in
+    assert kernel_pool.shape[0] <= 256, "runtime indices are uint8"
+    w = weight.detach().permute(2, 3, 1, 0) #[KY,KX,C,F]
+    ky, kx, c, f = w.shape
+    groups = w.reshape(ky, kx, c // 8, 8, f).permute(0, 1, 2, 4, 3) #[KY,KX,CG,F,8]
+    return pool_assign(groups, kernel_pool, metric).cpu().numpy().astype(np.uint8)
+
+def assign_layers(named_weights, kernel_pool, metric='cossim', min_channels=8):
+    #streaming assignment over a network, one layer in memory at a time: yields (name, runtime index array) for
+    #every conv weight whose input channels are a multiple of 8, e.g. assign_layers(model.named_parameters(), pool)
+    for name, weight in named_weights:
+        if weight.dim() == 4 and weight.shape[1] >= min_channels and weight.shape[1] % 8 == 0:
+            yield name, layer_index(weight, kernel_pool, metric)
+
+def write_index_header(path, name, layers):
+    #write index arrays in the Runtime/index_data format, layers is a list of (layer number, index array):
+    #const uint8_t <name>_layer_<n>[size] = {...};
+    with open(path, "w+") as f:
+        f.write("#pragma once\n")
+        f.write("#include <stdint.h>\n\n")
+        for layer_cnt, w in layers:
+            w = np.asarray(w).ravel()
+            f.write("const uint8_t " + name + '_' + "layer_" + str(layer_cnt) + "[%d] =\n{\n" % w.size)
+            for i in range(w.size - 1):
+                f.write("  %d,\n" % w[i])
+            f.write("  %d\n" % w[w.size - 1])
+            f.write("};\n")
+
+KMEANS_DISTANCES = {'euclidean': 0, 'cosine': 1}
+
+def kmeans(X, num_clusters, distance='euclidean', tol=1e-4, max_iter=1000, batch_size=0, seed=0, verbose=True):
+    #drop-in for kmeans_pytorch.kmeans on [N,8] weight vectors, on the CPU: returns (cluster_ids, cluster_centers)
+    #k-means++ seeding, batch_size > 0 switches to mini-batch updates for very large networks
+    ids, centers, iters = _native.kmeans(X, int(num_clusters), KMEANS_DISTANCES[distance], float(tol), int(max_iter),
+                                         int(batch_size), int(seed))
+    if verbose:
+        print("kmeans: {} vectors, {} clusters, {} iterations".format(ids.numel(), num_clusters, iters))
+    return ids.long(), centers
+
+def write_pool_header(path, name, centers):
+    #write a weight pool as input for the LUT generation: the int8 pool vectors, one row per pool entry,
+    #and the float scale that maps them back (centers ~= <name>_scale * <name>[i])
+    c = np.asarray(centers, dtype=np.float32).reshape(-1, 8)
+    scale = float(np.abs(c).max()) / 127 if np.abs(c).max() > 0 else 1.0
+    q = np.clip(np.round(c / scale), -127, 127).astype(np.int8)
+    with open(path, "w+") as f:
+        f.write("#pragma once\n")
+        f.write("#include <stdint.h>\n\n")
+        f.write("#define " + name.upper() + "_SIZE %d\n" % c.shape[0])
+        f.write("static const float " + name + "_scale = %.9ef;\n\n" % scale)
+        f.write("const int8_t " + name + "[%d][8] =\n{\n" % c.shape[0])
+        for i in range(c.shape[0]):
+            f.write("  {" + ", ".join("%d" % v for v in q[i]) + "}" + ("," if i < c.shape[0] - 1 else "") + "\n")
+        f.write("};\n")
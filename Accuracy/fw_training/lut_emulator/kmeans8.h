@@ -0,0 +1,182 @@
+// k-means on 8-wide weight vectors, used to generate weight pools.
+// It replaces kmeans_pytorch in the original_model_training scripts and needs no GPU.
+// Same loop as kmeans_pytorch: assign to the nearest center, move each center to the mean of its points, and stop
+// when (sum of center shifts)^2 < tol. Additions:
+//  - k-means++ seeding instead of random points (D^2 sampling, 1 - cos for the cosine distance)
+//  - optional mini-batch updates (per center learning rate 1 / count) for very large networks
+//  - the assignment step is pool_assign (vectorised over centers, multi-threaded)
+// Empty clusters are re-seeded with a random point. Results are deterministic for a given seed and thread count.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "pool_assign.h"
+
+namespace lut_emu
+{
+
+struct kmeans_params
+{
+  int k;
+  int metric;     // METRIC_L2 or METRIC_COSSIM
+  double tol;     // on (sum of center shifts)^2, like kmeans_pytorch
+  int max_iter;
+  int batch_size; // 0 for full batch (Lloyd) iterations
+  uint64_t seed;
+};
+
+// distance used by the seeding, consistent with the assignment metric
+inline float kmeans_dist(const float *x, const float *c, const int metric)
+{
+  float d2 = 0, dot = 0, nx = 0, nc = 0;
+  for (int j = 0; j < ASSIGN_DIM; j++)
+  {
+    const float d = x[j] - c[j];
+    d2 += d * d;
+    dot += x[j] * c[j];
+    nx += x[j] * x[j];
+    nc += c[j] * c[j];
+  }
+  if (metric != METRIC_COSSIM)
+  {
+    return d2;
+  }
+  const float n = std::sqrt(nx * nc);
+  return n > 0 ? 1.0f - dot / n : 1.0f;
+}
+
+// k-means++ seeding, centers: [k][8]
+template <class ParallelFor>
+void kmeans_seed(const float *x, const int64_t n, const kmeans_params &p, float *centers, std::mt19937_64 &rng,
+                 ParallelFor parallel_for)
+{
+  std::vector<float> dist(n, std::numeric_limits<float>::infinity());
+  std::uniform_int_distribution<int64_t> first(0, n - 1);
+  const int64_t start = first(rng);
+  std::copy(x + start * ASSIGN_DIM, x + (start + 1) * ASSIGN_DIM, centers);
+  for (int c = 1; c < p.k; c++)
+  {
+    const float *last = centers + (size_t)(c - 1) * ASSIGN_DIM;
+    parallel_for(0, n, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++)
+      {
+        dist[i] = std::min(dist[i], kmeans_dist(x + i * ASSIGN_DIM, last, p.metric));
+      }
+    });
+    // both distances already behave like a squared distance (1 - cos is |a - b|^2 / 2 on unit vectors)
+    double total = 0;
+    for (int64_t i = 0; i < n; i++)
+    {
+      total += dist[i];
+    }
+    int64_t pick = first(rng);
+    if (total > 0)
+    {
+      double r = std::uniform_real_distribution<double>(0, total)(rng);
+      for (pick = 0; pick < n - 1; pick++)
+      {
+        r -= dist[pick];
+        if (r <= 0)
+        {
+          break;
+        }
+      }
+    }
+    std::copy(x + pick * ASSIGN_DIM, x + (pick + 1) * ASSIGN_DIM, centers + (size_t)c * ASSIGN_DIM);
+  }
+}
+
+// x: [n][8], centers: [k][8] (output), ids: [n] (output). Returns the number of iterations run.
+template <class ParallelFor>
+int kmeans(const float *x, const int64_t n, const kmeans_params &p, float *centers, int32_t *ids,
+           ParallelFor parallel_for)
+{
+  std::mt19937_64 rng(p.seed);
+  std::uniform_int_distribution<int64_t> any(0, n - 1);
+  const bool mini_batch = p.batch_size > 0 && p.batch_size < n;
+  const int64_t m = mini_batch ? p.batch_size : n;
+
+  kmeans_seed(x, n, p, centers, rng, parallel_for);
+
+  std::vector<float> batch(mini_batch ? (size_t)m * ASSIGN_DIM : 0);
+  std::vector<int32_t> batch_ids(m);
+  std::vector<double> sum((size_t)p.k * ASSIGN_DIM);
+  std::vector<int64_t> count(p.k), total_count(p.k, 0);
+  std::vector<float> previous((size_t)p.k * ASSIGN_DIM);
+
+  int iter = 0;
+  while (iter < p.max_iter)
+  {
+    iter++;
+    const float *pts = x;
+    if (mini_batch)
+    {
+      for (int64_t i = 0; i < m; i++)
+      {
+        const int64_t s = any(rng);
+        std::copy(x + s * ASSIGN_DIM, x + (s + 1) * ASSIGN_DIM, &batch[(size_t)i * ASSIGN_DIM]);
+      }
+      pts = batch.data();
+    }
+    pool_assign(pts, m, centers, p.k, p.metric, batch_ids.data(), parallel_for);
+    std::copy(centers, centers + (size_t)p.k * ASSIGN_DIM, previous.begin());
+
+    std::fill(sum.begin(), sum.end(), 0.0);
+    std::fill(count.begin(), count.end(), 0);
+    for (int64_t i = 0; i < m; i++)
+    {
+      const int c = batch_ids[i];
+      count[c]++;
+      for (int j = 0; j < ASSIGN_DIM; j++)
+      {
+        sum[(size_t)c * ASSIGN_DIM + j] += pts[i * ASSIGN_DIM + j];
+      }
+    }
+    for (int c = 0; c < p.k; c++)
+    {
+      float *center = centers + (size_t)c * ASSIGN_DIM;
+      if (count[c] == 0)
+      {
+        if (!mini_batch || total_count[c] == 0)
+        {
+          const int64_t s = any(rng);
+          std::copy(x + s * ASSIGN_DIM, x + (s + 1) * ASSIGN_DIM, center);
+        }
+        continue;
+      }
+      // full batch: mean of the points. mini-batch: running mean over every batch seen so far
+      total_count[c] = mini_batch ? total_count[c] + count[c] : count[c];
+      const double rate = (double)count[c] / total_count[c];
+      for (int j = 0; j < ASSIGN_DIM; j++)
+      {
+        const double mean = sum[(size_t)c * ASSIGN_DIM + j] / count[c];
+        center[j] = (float)(center[j] + rate * (mean - center[j]));
+      }
+    }
+
+    double shift = 0;
+    for (int c = 0; c < p.k; c++)
+    {
+      double s = 0;
+      for (int j = 0; j < ASSIGN_DIM; j++)
+      {
+        const double d = centers[(size_t)c * ASSIGN_DIM + j] - previous[(size_t)c * ASSIGN_DIM + j];
+        s += d * d;
+      }
+      shift += std::sqrt(s);
+    }
+    if (shift * shift < p.tol)
+    {
+      break;
+    }
+  }
+  pool_assign(x, n, centers, p.k, p.metric, ids, parallel_for);
+  return iter;
+}
+
+} // namespace lut_emu
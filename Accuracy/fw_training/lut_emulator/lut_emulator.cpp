@@ -0,0 +1,110 @@
+// PyTorch CPU bindings of lut_emulator.h, pool_assign.h and kmeans8.h.
+// Threads come from the ATen pool, set with torch.set_num_threads.
+// Build with `python3 setup.py build_ext --inplace` in this directory. __init__.py can also compile it on first use.
+#include <torch/extension.h>
+#include <ATen/Parallel.h>
+
+#include "kmeans8.h"
+#include "lut_emulator.h"
+#include "pool_assign.h"
+
+static void aten_parallel_for(const int64_t begin, const int64_t end, const std::function<void(int64_t, int64_t)> &fn)
+{
+  at::parallel_for(begin, end, 1, fn);
+}
+
+torch::Tensor conv2d_lut_zdim(torch::Tensor bits, torch::Tensor weight, const double max_val, const int64_t stride,
+                              const int64_t trim, const int64_t psumbw, const double maxval)
+{
+  TORCH_CHECK(bits.dim() == 5, "bits must be [B, C, X, Y, 1 + act_prec]");
+  TORCH_CHECK(weight.dim() == 4, "weight must be [F, C, KX, KY]");
+  TORCH_CHECK(bits.size(1) == weight.size(1) && bits.size(1) % lut_emu::GROUP == 0,
+              "channels must match and be a multiple of 8");
+  TORCH_CHECK(bits.select(4, 0).min().item<float>() >= 0, "activations must be non-negative");
+  bits = bits.to(torch::kCPU, torch::kFloat).contiguous();
+  weight = weight.detach().to(torch::kCPU, torch::kFloat).contiguous();
+
+  const int B = bits.size(0), C = bits.size(1), X = bits.size(2), Y = bits.size(3), P = bits.size(4) - 1;
+  const int F = weight.size(0), KX = weight.size(2), KY = weight.size(3);
+  const int OX = (X - trim) / stride, OY = (Y - trim) / stride;
+  TORCH_CHECK(OX > 0 && OY > 0 && (OX - 1) * stride + KX <= X && (OY - 1) * stride + KY <= Y,
+              "the windows of this trim do not fit the input");
+  auto out = torch::empty({B, F, OX, OY}, bits.options());
+  lut_emu::conv2d_lut_zdim(bits.data_ptr<float>(), weight.data_ptr<float>(), out.data_ptr<float>(),
+                           B, C, X, Y, P, F, KX, KY, stride, trim, max_val, psumbw, maxval, aten_parallel_for);
+  return out;
+}
+
+torch::Tensor conv2d_lut_index(torch::Tensor input, torch::Tensor kernel_idx, torch::Tensor lut,
+                               const int64_t out_ch, const int64_t kernel_h, const int64_t kernel_w,
+                               const int64_t stride, const int64_t padding, const int64_t input_offset,
+                               const int64_t prec, const bool wrap16)
+{
+  TORCH_CHECK(input.dim() == 4 && input.scalar_type() == torch::kInt8, "input must be int8 [B, H, W, C]");
+  TORCH_CHECK(input.size(3) % lut_emu::GROUP == 0, "channels must be a multiple of 8");
+  TORCH_CHECK(kernel_idx.scalar_type() == torch::kUInt8 && lut.scalar_type() == torch::kUInt8,
+              "kernel_idx and lut must be uint8");
+  TORCH_CHECK(prec >= 1 && prec <= 8, "prec must be 1..8");
+  TORCH_CHECK(lut.numel() % lut_emu::ROWS == 0, "lut must have 256 rows");
+  input = input.contiguous();
+  kernel_idx = kernel_idx.contiguous();
+  lut = lut.contiguous();
+
+  const int B = input.size(0), H = input.size(1), W = input.size(2), C = input.size(3);
+  const int OH = (H + 2 * padding - kernel_h) / stride + 1;
+  const int OW = (W + 2 * padding - kernel_w) / stride + 1;
+  const int lut_size = lut.numel() / lut_emu::ROWS;
+  TORCH_CHECK(kernel_idx.numel() >= kernel_h * kernel_w * (C / lut_emu::GROUP) * out_ch, "kernel_idx is too small");
+  TORCH_CHECK(kernel_idx.max().item<uint8_t>() < lut_size, "kernel_idx addresses a column outside the lut");
+
+  auto out = torch::empty({B, OH, OW, out_ch}, torch::dtype(torch::kInt32));
+  lut_emu::conv2d_lut_index(input.data_ptr<int8_t>(), kernel_idx.data_ptr<uint8_t>(), lut.data_ptr<uint8_t>(),
+                            out.data_ptr<int32_t>(), B, H, W, C, out_ch, kernel_h, kernel_w, stride, stride,
+                            padding, padding, OH, OW, input_offset, prec, lut_size, wrap16, aten_parallel_for);
+  return out;
+}
+
+torch::Tensor pool_assign(torch::Tensor groups, torch::Tensor pool, const int64_t metric)
+{
+  TORCH_CHECK(groups.size(-1) == lut_emu::ASSIGN_DIM && pool.dim() == 2 && pool.size(1) == lut_emu::ASSIGN_DIM,
+              "groups must be [..., 8] and pool [K, 8]");
+  TORCH_CHECK(metric >= lut_emu::METRIC_L2 && metric <= lut_emu::METRIC_MIXEDNORM, "unknown metric");
+  groups = groups.detach().to(torch::kCPU, torch::kFloat).reshape({-1, lut_emu::ASSIGN_DIM}).contiguous();
+  pool = pool.detach().to(torch::kCPU, torch::kFloat).contiguous();
+
+  auto idx = torch::empty({groups.size(0)}, torch::dtype(torch::kInt32));
+  lut_emu::pool_assign(groups.data_ptr<float>(), groups.size(0), pool.data_ptr<float>(), pool.size(0), metric,
+                       idx.data_ptr<int32_t>(),
+                       [](const int64_t begin, const int64_t end, const std::function<void(int64_t, int64_t)> &fn) {
+                         at::parallel_for(begin, end, 1024, fn);
+                       });
+  return idx;
+}
+
+std::tuple<torch::Tensor, torch::Tensor, int64_t> kmeans(torch::Tensor x, const int64_t k, const int64_t metric,
+                                                        const double tol, const int64_t max_iter,
+                                                        const int64_t batch_size, const int64_t seed)
+{
+  TORCH_CHECK(x.size(-1) == lut_emu::ASSIGN_DIM, "x must be [..., 8]");
+  TORCH_CHECK(metric == lut_emu::METRIC_L2 || metric == lut_emu::METRIC_COSSIM, "k-means metric must be l2 or cossim");
+  x = x.detach().to(torch::kCPU, torch::kFloat).reshape({-1, lut_emu::ASSIGN_DIM}).contiguous();
+  TORCH_CHECK(k >= 1 && k <= x.size(0), "num_clusters must be between 1 and the number of vectors");
+
+  auto centers = torch::empty({k, lut_emu::ASSIGN_DIM}, torch::dtype(torch::kFloat));
+  auto ids = torch::empty({x.size(0)}, torch::dtype(torch::kInt32));
+  const lut_emu::kmeans_params p = {(int)k, (int)metric, tol, (int)max_iter, (int)batch_size, (uint64_t)seed};
+  const int iters = lut_emu::kmeans(x.data_ptr<float>(), x.size(0), p, centers.data_ptr<float>(), ids.data_ptr<int32_t>(),
+                                    [](const int64_t begin, const int64_t end,
+                                       const std::function<void(int64_t, int64_t)> &fn) {
+                                      at::parallel_for(begin, end, 1024, fn);
+                                    });
+  return std::make_tuple(ids, centers, (int64_t)iters);
+}
+
+PYBIND11_MODULE(TORCH_EXTENSION_NAME, m)
+{
+  m.def("conv2d_lut_zdim", &conv2d_lut_zdim, "bit-serial weight pool conv with quantised partial sums");
+  m.def("conv2d_lut_index", &conv2d_lut_index, "integer accumulators of the runtime LUT conv kernels");
+  m.def("pool_assign", &pool_assign, "index of the nearest pool vector of every 8-wide group");
+  m.def("kmeans", &kmeans, "k-means of 8-wide weight vectors (k-means++ seeding, optional mini-batches)");
+}
@@ -0,0 +1,226 @@
+// CPU emulation of the bit-serial weight pool (LUT) convolution.
+// Plain C++ with no torch dependency. lut_emulator.cpp binds it to PyTorch, and it can also be built on its own
+// to check the MCU kernels.
+//
+// conv2d_lut_zdim: same result as conv2d_lut_zdim_stride in the *_prec_sweep_lut.py scripts.
+//   Every 8-channel weight block of a pool network is one of a few pool kernels. The quantised bit-plane partial
+//   sums are computed once per (bit-plane row, pool kernel) into a LUT with 256 rows, like the runtime's
+//   filter_pool_data. The conv is then a table lookup per block, and the CUDA window loop is not needed.
+// conv2d_lut_index: integer accumulators of lut_conv_zdim_v1/v2, from the runtime index and LUT layout.
+//   Used as a bit-exact oracle for the MCU kernels.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace lut_emu
+{
+
+const int GROUP = 8;   // channels per weight block, FW_GRAN in the runtime
+const int ROWS = 256;  // one LUT row per bit pattern of a block
+
+// quantization_n of the scripts, in float like torch.
+// The scalars are cast to float because the Python code passes them as doubles.
+inline float quantize_psum(const float v, const double intv, const float rangeq)
+{
+  const float q = std::nearbyint(v * (float)(1.0 / intv)) * (float)intv; // round half to even, like torch.round
+  return std::min(std::max(q, -rangeq), rangeq);
+}
+
+// bits:   [B, C, X, Y, 1 + P] 0/1 floats from bit_stream_gen_pos_round. Entry 0 is the sign and is not used,
+//         because the activations are non-negative. Entry 1 is the MSB.
+// weight: [F, C, KX, KY], already replaced by pool kernels
+// out:    [B, F, OX, OY], OX = (X - trim) / stride like the output of the scripts: trim is k_size - k_size // 2 in
+//         the resnet scripts, k_size - 1 in tinyconv and 0 in mobilenetv2. Window ox starts at input column ox * stride
+// parallel_for(begin, end, fn) runs fn(b, e) on sub-ranges of [begin, end)
+template <class ParallelFor>
+void conv2d_lut_zdim(const float *bits, const float *weight, float *out,
+                     const int B, const int C, const int X, const int Y, const int P,
+                     const int F, const int KX, const int KY, const int stride, const int trim,
+                     const double max_val, const int psumbw, const double maxval,
+                     ParallelFor parallel_for)
+{
+  const int CG = C / GROUP;
+  const int OX = (X - trim) / stride;
+  const int OY = (Y - trim) / stride;
+  const double intv = (maxval * 2) / (std::pow(2.0, psumbw) - 1);
+
+  // bit-plane rows, [B][X][Y][CG][P], bit j of a row is channel cg * 8 + j
+  std::vector<uint8_t> rows((size_t)B * X * Y * CG * P);
+  parallel_for(0, B * X, [&](int64_t begin, int64_t end) {
+    for (int64_t bx = begin; bx < end; bx++)
+    {
+      const int b = (int)(bx / X), x = (int)(bx % X);
+      for (int y = 0; y < Y; y++)
+        for (int cg = 0; cg < CG; cg++)
+          for (int p = 0; p < P; p++)
+          {
+            uint8_t row = 0;
+            for (int j = 0; j < GROUP; j++)
+            {
+              const size_t i = ((((size_t)b * C + cg * GROUP + j) * X + x) * Y + y) * (P + 1) + 1 + p;
+              row |= (bits[i] > 0.5f) << j;
+            }
+            rows[((((size_t)bx * Y) + y) * CG + cg) * P + p] = row;
+          }
+    }
+  });
+
+  // physical kernels of the layer and the logical -> physical index, [KX][KY][CG][F] so filters are contiguous
+  std::map<std::array<float, GROUP>, int> pool_map;
+  std::vector<std::array<float, GROUP>> pool;
+  std::vector<int32_t> idx((size_t)KX * KY * CG * F);
+  for (int f = 0; f < F; f++)
+    for (int cg = 0; cg < CG; cg++)
+      for (int kx = 0; kx < KX; kx++)
+        for (int ky = 0; ky < KY; ky++)
+        {
+          std::array<float, GROUP> w;
+          for (int j = 0; j < GROUP; j++)
+          {
+            w[j] = weight[(((size_t)f * C + cg * GROUP + j) * KX + kx) * KY + ky];
+          }
+          auto it = pool_map.find(w);
+          if (it == pool_map.end())
+          {
+            it = pool_map.emplace(w, (int)pool.size()).first;
+            pool.push_back(w);
+          }
+          idx[(((size_t)kx * KY + ky) * CG + cg) * F + f] = it->second;
+        }
+  const int U = (int)pool.size();
+
+  // quantised partial sum of every (row, physical kernel), [ROWS][U]
+  std::vector<float> lut((size_t)ROWS * U);
+  parallel_for(0, ROWS, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++)
+      for (int u = 0; u < U; u++)
+      {
+        float s = 0;
+        for (int j = 0; j < GROUP; j++)
+        {
+          s += ((r >> j) & 1) ? pool[u][j] : 0.0f;
+        }
+        lut[r * U + u] = quantize_psum(s, intv, (float)maxval);
+      }
+  });
+
+  std::vector<double> scale(P);
+  for (int p = 0; p < P; p++)
+  {
+    scale[p] = max_val / std::pow(2.0, p + 1); // scale_vec of the scripts, MSB first
+  }
+
+  parallel_for(0, B * OX, [&](int64_t begin, int64_t end) {
+    std::vector<double> acc(F);
+    std::vector<double> result_mem(U); // all bit planes of one block, shared by the filters (v2 double lookup)
+    for (int64_t bo = begin; bo < end; bo++)
+    {
+      const int b = (int)(bo / OX), ox = (int)(bo % OX);
+      for (int oy = 0; oy < OY; oy++)
+      {
+        std::fill(acc.begin(), acc.end(), 0.0);
+        for (int kx = 0; kx < KX; kx++)
+          for (int ky = 0; ky < KY; ky++)
+          {
+            const int x = ox * stride + kx, y = oy * stride + ky;
+            for (int cg = 0; cg < CG; cg++)
+            {
+              const uint8_t *r = &rows[((((size_t)b * X + x) * Y + y) * CG + cg) * P];
+              std::fill(result_mem.begin(), result_mem.end(), 0.0);
+              for (int p = 0; p < P; p++)
+              {
+                const float *l = &lut[(size_t)r[p] * U];
+                for (int u = 0; u < U; u++)
+                {
+                  result_mem[u] += l[u] * scale[p];
+                }
+              }
+              const int32_t *blk = &idx[(((size_t)kx * KY + ky) * CG + cg) * F];
+              for (int f = 0; f < F; f++)
+              {
+                acc[f] += result_mem[blk[f]];
+              }
+            }
+          }
+        for (int f = 0; f < F; f++)
+        {
+          out[(((size_t)b * F + f) * OX + ox) * OY + oy] = (float)acc[f];
+        }
+      }
+    }
+  });
+}
+
+// Accumulators of lut_conv_zdim_v1 before bias and requantisation.
+// input:      [B, H, W, C] int8, NHWC like the runtime
+// kernel_idx: runtime layout, kernel_idx[F * block + f]. block counts the 8-channel blocks of the kernel
+//             positions inside the input in (ky, kx, channel) order, so border pixels use the first blocks,
+//             as on the MCU
+// lut:        filter_pool_data, [256][lut_size]
+// out:        [B, OH, OW, F]
+// wrap16 emulates the 16-bit holder of v1/v2 (the MCU also adds the bias in it)
+template <class ParallelFor>
+void conv2d_lut_index(const int8_t *input, const uint8_t *kernel_idx, const uint8_t *lut, int32_t *out,
+                      const int B, const int H, const int W, const int C, const int F,
+                      const int KY, const int KX, const int stride_y, const int stride_x,
+                      const int pad_y, const int pad_x, const int OH, const int OW,
+                      const int input_offset, const int prec, const int lut_size, const bool wrap16,
+                      ParallelFor parallel_for)
+{
+  parallel_for(0, B * OH, [&](int64_t begin, int64_t end) {
+    std::vector<int32_t> acc(F);
+    std::vector<int32_t> result_mem(lut_size);
+    uint16_t index[8];
+    for (int64_t bo = begin; bo < end; bo++)
+    {
+      const int b = (int)(bo / OH), oy = (int)(bo % OH);
+      for (int ox = 0; ox < OW; ox++)
+      {
+        std::fill(acc.begin(), acc.end(), 0);
+        int block = 0;
+        const int base_y = oy * stride_y - pad_y, base_x = ox * stride_x - pad_x;
+        for (int ky = std::max(0, -base_y); ky < std::min(KY, H - base_y); ky++)
+          for (int kx = std::max(0, -base_x); kx < std::min(KX, W - base_x); kx++)
+          {
+            const int8_t *px = input + (((size_t)b * H + base_y + ky) * W + base_x + kx) * C;
+            for (int c = 0; c < C; c += GROUP, block++)
+            {
+              // lut_nn_bitplane_index
+              std::fill(index, index + prec, 0);
+              for (int j = 0; j < GROUP; j++)
+              {
+                const uint8_t val = (uint8_t)(px[c + j] + input_offset);
+                for (int p = 0; p < prec; p++)
+                {
+                  index[p] |= ((val >> p) & 1) << j;
+                }
+              }
+              for (int k = 0; k < lut_size; k++)
+              {
+                int32_t s = 0;
+                for (int p = 0; p < prec; p++)
+                {
+                  s += (int32_t)lut[index[p] * lut_size + k] << p;
+                }
+                result_mem[k] = s;
+              }
+              const uint8_t *blk = kernel_idx + (size_t)F * block;
+              for (int f = 0; f < F; f++)
+              {
+                acc[f] = wrap16 ? (int16_t)(acc[f] + result_mem[blk[f]]) : acc[f] + result_mem[blk[f]];
+              }
+            }
+          }
+        std::memcpy(out + (((size_t)b * OH + oy) * OW + ox) * F, acc.data(), F * sizeof(int32_t));
+      }
+    }
+  });
+}
+
+} // namespace lut_emu
@@ -0,0 +1,114 @@
+// Nearest pool vector assignment of 8-wide weight groups.
+// It replaces find_optimal_l2 / find_optimal_cossim / find_optimal_mixednorm of the *_wp_zdim_auto.py scripts,
+// which build a groups x pool x 8 tensor. Here memory stays O(pool).
+// The pool is stored transposed ([8][K]), so the distance to all pool vectors is a few vector ops per weight
+// component. The compiler vectorises these loops over K. The pool is processed in tiles that stay in L1, and the
+// groups are split over threads.
+// Ties go to the lowest pool index, like torch.argmin / argmax.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace lut_emu
+{
+
+enum assign_metric
+{
+  METRIC_L2 = 0,        // find_optimal_l2: min sum (p - x)^2
+  METRIC_COSSIM = 1,    // find_optimal_cossim: max cosine similarity
+  METRIC_MIXEDNORM = 2, // find_optimal_mixednorm: min (sum (p - x))^2 + sum (p - x)^2
+};
+
+const int ASSIGN_DIM = 8;
+const int ASSIGN_POOL_TILE = 256; // 8 KB of transposed pool per tile
+
+// groups: [n][8], pool: [k][8], idx: [n]
+template <class ParallelFor>
+void pool_assign(const float *groups, const int64_t n, const float *pool, const int k, const int metric,
+                 int32_t *idx, ParallelFor parallel_for)
+{
+  // transposed pool and per vector constants
+  std::vector<float> pool_t((size_t)ASSIGN_DIM * k);
+  std::vector<float> inv_norm(k);
+  for (int i = 0; i < k; i++)
+  {
+    float norm = 0;
+    for (int j = 0; j < ASSIGN_DIM; j++)
+    {
+      pool_t[(size_t)j * k + i] = pool[(size_t)i * ASSIGN_DIM + j];
+      norm += pool[(size_t)i * ASSIGN_DIM + j] * pool[(size_t)i * ASSIGN_DIM + j];
+    }
+    inv_norm[i] = norm > 0 ? 1.0f / std::sqrt(norm) : 0.0f;
+  }
+
+  parallel_for(0, n, [&](int64_t begin, int64_t end) {
+    float score[ASSIGN_POOL_TILE]; // local arrays, so the compiler knows they do not alias the pool
+    float sum[ASSIGN_POOL_TILE];
+    std::vector<float> best(end - begin, std::numeric_limits<float>::infinity());
+    for (int k0 = 0; k0 < k; k0 += ASSIGN_POOL_TILE)
+    {
+      const int kt = std::min(ASSIGN_POOL_TILE, k - k0);
+      for (int64_t g = begin; g < end; g++)
+      {
+        const float *x = groups + g * ASSIGN_DIM;
+        std::fill(score, score + kt, 0.0f);
+        if (metric == METRIC_COSSIM)
+        {
+          for (int j = 0; j < ASSIGN_DIM; j++)
+          {
+            const float *p = &pool_t[(size_t)j * k + k0];
+            for (int i = 0; i < kt; i++)
+            {
+              score[i] += p[i] * x[j];
+            }
+          }
+          // |x| is the same for every pool vector, only the pool norm matters for the argmax
+          for (int i = 0; i < kt; i++)
+          {
+            score[i] = -score[i] * inv_norm[k0 + i];
+          }
+        }
+        else
+        {
+          std::fill(sum, sum + kt, 0.0f);
+          for (int j = 0; j < ASSIGN_DIM; j++)
+          {
+            const float *p = &pool_t[(size_t)j * k + k0];
+            for (int i = 0; i < kt; i++)
+            {
+              const float d = p[i] - x[j];
+              score[i] += d * d;
+              sum[i] += d;
+            }
+          }
+          if (metric == METRIC_MIXEDNORM)
+          {
+            for (int i = 0; i < kt; i++)
+            {
+              score[i] += sum[i] * sum[i];
+            }
+          }
+        }
+        float &b = best[g - begin];
+        if (k0 == 0)
+        {
+          idx[g] = 0;
+        }
+        for (int i = 0; i < kt; i++)
+        {
+          if (score[i] < b)
+          {
+            b = score[i];
+            idx[g] = k0 + i;
+          }
+        }
+      }
+    }
+  });
+}
+
+} // namespace lut_emu
@@ -0,0 +1,9 @@
+#build the CPU LUT emulator in place: python3 setup.py build_ext --inplace
+from setuptools import setup
+from torch.utils.cpp_extension import BuildExtension, CppExtension
+
+setup(
+    name='lut_emulator',
+    ext_modules=[CppExtension('_lut_emulator', ['lut_emulator.cpp'], extra_compile_args=['-O3'])],
+    cmdclass={'build_ext': BuildExtension},
+)
@@ -22,6 +22,7 @@ from torch.nn import init
 from torch.nn.modules import Module
 from torch.nn.modules.utils import _single, _pair, _triple
 import torch.nn.functional as F
+device = torch.device('cuda' if torch.cuda.is_available() else 'cpu') #falls back to the CPU on GPU-less build servers
 import numpy as np
 import torchvision
 from torchvision.transforms import Compose
@@ -229,8 +230,8 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
         kernelpool = torch.normal(0, 0.5, size=(pool_size,kernel_size))
         return kernelpool
 
-    #kernelpool = kernelpool_gen_random(9,50).cuda() #generate 50 random kernels
-    kernelpool = clustercenter.cuda()#load kernel pool using cluster centers from K means clustering
+    #kernelpool = kernelpool_gen_random(9,50).to(device) #generate 50 random kernels
+    kernelpool = clustercenter.to(device)#load kernel pool using cluster centers from K means clustering
 
     coeff_groupsize = 1 #number of kernels to share a same coeff
 
@@ -348,7 +349,7 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
             out = out.view(out.size(0), -1)
             out = self.linear(out)
             return out
-    model = MobileNetV2().cuda()
+    model = MobileNetV2().to(device)
 
     print_freq = 1000
     def train(train_loader, model, criterion, optimizer, epoch):
@@ -371,8 +372,8 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
             input = input.view(-1, 1, 28, 28)
             input /= 255.0
 
-            input = input.cuda()
-            target = target.cuda()
+            input = input.to(device)
+            target = target.to(device)
 
             # compute output
             output = model(input)
@@ -420,8 +421,8 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
             #print('new batch')
             input = input.view(-1, 1, 28, 28)
             input /= 255.0
-            input = input.cuda()
-            target = target.cuda()
+            input = input.to(device)
+            target = target.to(device)
 
             # compute output
             with torch.no_grad():
@@ -506,7 +507,7 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
         print('Learning rate = %f'%lrate)
         for param_group in optimizer.param_groups:
           param_group['lr'] = lrate
-    criterion = nn.CrossEntropyLoss(size_average=True).cuda()
+    criterion = nn.CrossEntropyLoss(size_average=True).to(device)
 
     def load_dataset(root, mtype):
         num_classes = 0
@@ -29,6 +29,7 @@ from torch.nn import init
 from torch.nn.modules import Module
 from torch.nn.modules.utils import _single, _pair, _triple
 import torch.nn.functional as F
+device = torch.device('cuda' if torch.cuda.is_available() else 'cpu') #falls back to the CPU on GPU-less build servers
 from torchvision.transforms import Compose
 
 parser = argparse.ArgumentParser()
@@ -318,7 +319,7 @@ for act_prec in [8,7,6,5,4,3]:
           kernelpool = torch.normal(0, 0.5, size=(pool_size,kernel_size))
           return kernelpool
 
-      kernelpool = clustercenter.cuda()#load kernel pool using cluster centers from K means clustering
+      kernelpool = clustercenter.to(device)#load kernel pool using cluster centers from K means clustering
       coeff_groupsize = 1 #number of kernels to share a same coeff
 
       class Conv2d_q(_ConvNd):    
@@ -790,8 +791,8 @@ for act_prec in [8,7,6,5,4,3]:
                         pretrained, progress, **kwargs)
 
 
-      model = resnet_cifar10(pretrained = False).cuda()
-      #model = resnet50(pretrained = True).cuda()
+      model = resnet_cifar10(pretrained = False).to(device)
+      #model = resnet50(pretrained = True).to(device)
 
       def train(train_loader, model, criterion, optimizer, epoch):
           """
@@ -811,8 +812,8 @@ for act_prec in [8,7,6,5,4,3]:
               # measure data loading time
               data_time.update(time.time() - end)
 
-              input = input.cuda()
-              target = target.cuda()
+              input = input.to(device)
+              target = target.to(device)
 
               # compute output
               output = model(input)
@@ -862,8 +863,8 @@ for act_prec in [8,7,6,5,4,3]:
               datatime = time.time()
               #print("data loading time is ", datatime - end)
               #print('new batch')
-              input = input.cuda()
-              target = target.cuda()
+              input = input.to(device)
+              target = target.to(device)
               #the transfer time to gpu is not slow
               starttime = time.time()
               # compute output
@@ -945,7 +946,7 @@ for act_prec in [8,7,6,5,4,3]:
               correct_k = correct[:k].view(-1).float().sum(0)
               res.append(correct_k.mul_(100.0 / batch_size))
           return res
-      criterion = nn.CrossEntropyLoss(size_average=True).cuda()
+      criterion = nn.CrossEntropyLoss(size_average=True).to(device)
 
 
       train_transform = Compose([
@@ -28,6 +28,8 @@ from torch.nn import init
 from torch.nn.modules import Module
 from torch.nn.modules.utils import _single, _pair, _triple
 import torch.nn.functional as F
+import lut_emulator
+device = torch.device('cuda' if torch.cuda.is_available() else 'cpu') #falls back to the CPU on GPU-less build servers
 from torchvision.transforms import Compose
 #os.environ['CUDA_VISIBLE_DEVICES']='2'
 
@@ -191,6 +193,9 @@ for act_prec in [8]:
             return result #result should have a dimension of n contains a sign bit and n-1 actual bit
 
         def conv2d_lut_zdim_stride(input, weight, bias, max_val, act_prec, stride = 1):
+            if not input.is_cuda and lut_emulator.available():
+                #native CPU emulator (lut_emulator/), same result without the window loop below
+                return lut_emulator.conv2d_lut_zdim(input, weight, bias, max_val, stride, psumbw, maxval, weight.shape[2] - weight.shape[2] // 2)
             #version for z dimension weight sharing, modified from the code for xy dimension.
             #input should have 5 dimensions, the last dimension is the bit dimension, weight is still normal weight, doesn't need to be bit-serialized
             #inpud shape: [B,C,X,Y,bit], weight shape: [F,C,x,y]
@@ -199,7 +204,7 @@ for act_prec in [8]:
             #generate the scale vector for summing the bits , -1 because sign bit is excluded
             group_size = 8 #number of channels in a group that stored in the lookup table
             #scale_vec = torch.zeros(act_prec-1)
-            scale_vec =  torch.cuda.FloatTensor(act_prec).fill_(0)#(act_prec-1 for signed version)
+            scale_vec =  torch.zeros(act_prec, device=input.device)#(act_prec-1 for signed version)
             for i in range(act_prec):#use (act_prec-1 for signed version)
                 if i == 0:
                     scale_vec[i] = 1
@@ -219,7 +224,7 @@ for act_prec in [8]:
             #define the output, size should be [B,F,X,Y] 
             #output = torch.zeros(input_shape[0], weig ht_shape[0], input_shape[2]-(k_size-k_offset), input_shape[3]-(k_size-k_offset))
             #output = torch.zeros(input_shape[0], weight_shape[0], int((input_shape[2]-(k_size-k_offset))/stride), int((input_shape[3]-(k_size-k_offset))/stride))
-            output = torch.cuda.FloatTensor(input_shape[0], weight_shape[0], int((input_shape[2]-(k_size-k_offset))/stride), int((input_shape[3]-(k_size-k_offset))/stride)).fill_(0)
+            output = torch.zeros(input_shape[0], weight_shape[0], int((input_shape[2]-(k_size-k_offset))/stride), int((input_shape[3]-(k_size-k_offset))/stride), device=input.device)
             #input = input.reshape(input_shape[0], input_shape[1], input_shape[2]*input_shape[3, input_shape[4]]).permute(0,1,3,2)
             #weight = weight.reshape(weight_shape[0], weight_shape[1], weight_shape[2]*weight_shape[3],weight_shape[4]).permute(0,1,3,2)
             sign = input[...,0].unsqueeze(-1)#extract the sign of input, shape is [B,C,X,Y,1]
@@ -350,7 +355,7 @@ for act_prec in [8]:
             kernelpool = torch.normal(0, 0.5, size=(pool_size,kernel_size))
             return kernelpool
 
-        kernelpool = clustercenter.cuda()#load kernel pool using cluster centers from K means clustering
+        kernelpool = clustercenter.to(device)#load kernel pool using cluster centers from K means clustering
         coeff_groupsize = 1 #number of kernels to share a same coeff
 
         class Conv2d_q(_ConvNd):    
@@ -811,8 +816,8 @@ for act_prec in [8]:
                           pretrained, progress, **kwargs)
 
 
-        model = resnet_cifar10(pretrained = False).cuda()
-        #model = resnet50(pretrained = True).cuda()
+        model = resnet_cifar10(pretrained = False).to(device)
+        #model = resnet50(pretrained = True).to(device)
 
         def train(train_loader, model, criterion, optimizer, epoch):
             """
@@ -832,8 +837,8 @@ for act_prec in [8]:
                 # measure data loading time
                 data_time.update(time.time() - end)
 
-                input = input.cuda()
-                target = target.cuda()
+                input = input.to(device)
+                target = target.to(device)
 
                 # compute output
                 output = model(input)
@@ -883,8 +888,8 @@ for act_prec in [8]:
                 datatime = time.time()
                 #print("data loading time is ", datatime - end)
                 #print('new batch')
-                input = input.cuda()
-                target = target.cuda()
+                input = input.to(device)
+                target = target.to(device)
                 #the transfer time to gpu is not slow
                 starttime = time.time()
                 # compute output
@@ -966,7 +971,7 @@ for act_prec in [8]:
                 correct_k = correct[:k].view(-1).float().sum(0)
                 res.append(correct_k.mul_(100.0 / batch_size))
             return res
-        criterion = nn.CrossEntropyLoss(size_average=True).cuda()
+        criterion = nn.CrossEntropyLoss(size_average=True).to(device)
 
 
         train_transform = Compose([
@@ -22,6 +22,7 @@ from torch.nn import init
 from torch.nn.modules import Module
 from torch.nn.modules.utils import _single, _pair, _triple
 import torch.nn.functional as F
+device = torch.device('cuda' if torch.cuda.is_available() else 'cpu') #falls back to the CPU on GPU-less build servers
 import numpy as np
 import torchvision
 from torchvision.transforms import Compose
@@ -206,8 +207,8 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
         kernelpool = torch.normal(0, 0.5, size=(pool_size,kernel_size))
         return kernelpool
 
-    #kernelpool = kernelpool_gen_random(9,50).cuda() #generate 50 random kernels
-    kernelpool = clustercenter.cuda()#load kernel pool using cluster centers from K means clustering
+    #kernelpool = kernelpool_gen_random(9,50).to(device) #generate 50 random kernels
+    kernelpool = clustercenter.to(device)#load kernel pool using cluster centers from K means clustering
 
     coeff_groupsize = 1 #number of kernels to share a same coeff
 
@@ -302,7 +303,7 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
             return x
 
     model = CONV_tiny_quant()
-    model.cuda()
+    model.to(device)
 
     print_freq = 1000
     def train(train_loader, model, criterion, optimizer, epoch):
@@ -325,8 +326,8 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
             input = input.view(-1, 1, 28, 28)
             input /= 255.0
 
-            input = input.cuda()
-            target = target.cuda()
+            input = input.to(device)
+            target = target.to(device)
 
             # compute output
             output = model(input)
@@ -374,8 +375,8 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
             #print('new batch')
             input = input.view(-1, 1, 28, 28)
             input /= 255.0
-            input = input.cuda()
-            target = target.cuda()
+            input = input.to(device)
+            target = target.to(device)
 
             # compute output
             with torch.no_grad():
@@ -460,7 +461,7 @@ for idx, act_prec in enumerate([8,7,6,5,4,3]):
         print('Learning rate = %f'%lrate)
         for param_group in optimizer.param_groups:
           param_group['lr'] = lrate
-    criterion = nn.CrossEntropyLoss(size_average=True).cuda()
+    criterion = nn.CrossEntropyLoss(size_average=True).to(device)
 
     def load_dataset(root, mtype):
         num_classes = 0
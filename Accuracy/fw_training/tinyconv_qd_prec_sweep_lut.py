@@ -28,6 +28,8 @@ from torch.nn import init
 from torch.nn.modules import Module
 from torch.nn.modules.utils import _single, _pair, _triple
 import torch.nn.functional as F
+import lut_emulator
+device = torch.device('cuda' if torch.cuda.is_available() else 'cpu') #falls back to the CPU on GPU-less build servers
 from torchvision.transforms import Compose
 
 parser = argparse.ArgumentParser()
@@ -175,6 +177,9 @@ for act_prec in [8]:
 
 
         def conv2d_lut_zdim_stride(input, weight, bias, max_val, act_prec, stride = 1):
+            if not input.is_cuda and lut_emulator.available():
+                #native CPU emulator (lut_emulator/), same result without the window loop below
+                return lut_emulator.conv2d_lut_zdim(input, weight, bias, max_val, stride, psumbw, maxval, weight.shape[2] - 1)
             #version for z dimension weight sharing, modified from the code for xy dimension.
             #input should have 5 dimensions, the last dimension is the bit dimension, weight is still normal weight, doesn't need to be bit-serialized
             #inpud shape: [B,C,X,Y,bit], weight shape: [F,C,x,y]
@@ -183,7 +188,7 @@ for act_prec in [8]:
             #generate the scale vector for summing the bits , -1 because sign bit is excluded
             group_size = 8 #number of channels in a group that stored in the lookup table
             #scale_vec = torch.zeros(act_prec-1)
-            scale_vec =  torch.cuda.FloatTensor(act_prec).fill_(0)#(act_prec-1 for signed version)
+            scale_vec =  torch.zeros(act_prec, device=input.device)#(act_prec-1 for signed version)
             for i in range(act_prec):#use (act_prec-1 for signed version)
                 if i == 0:
                     scale_vec[i] = 1
@@ -204,7 +209,7 @@ for act_prec in [8]:
             #define the output, size should be [B,F,X,Y] 
             #output = torch.zeros(input_shape[0], weig ht_shape[0], input_shape[2]-(k_size-k_offset), input_shape[3]-(k_size-k_offset))
             #output = torch.zeros(input_shape[0], weight_shape[0], int((input_shape[2]-(k_size-k_offset))/stride), int((input_shape[3]-(k_size-k_offset))/stride))
-            output = torch.cuda.FloatTensor(input_shape[0], weight_shape[0], int((input_shape[2]-(k_size-k_offset))/stride), int((input_shape[3]-(k_size-k_offset))/stride)).fill_(0)
+            output = torch.zeros(input_shape[0], weight_shape[0], int((input_shape[2]-(k_size-k_offset))/stride), int((input_shape[3]-(k_size-k_offset))/stride), device=input.device)
             #input = input.reshape(input_shape[0], input_shape[1], input_shape[2]*input_shape[3, input_shape[4]]).permute(0,1,3,2)
             #weight = weight.reshape(weight_shape[0], weight_shape[1], weight_shape[2]*weight_shape[3],weight_shape[4]).permute(0,1,3,2)
             sign = input[...,0].unsqueeze(-1)#extract the sign of input, shape is [B,C,X,Y,1]
@@ -334,7 +339,7 @@ for act_prec in [8]:
             kernelpool = torch.normal(0, 0.5, size=(pool_size,kernel_size))
             return kernelpool
 
-        kernelpool = clustercenter.cuda()#load kernel pool using cluster centers from K means clustering
+        kernelpool = clustercenter.to(device)#load kernel pool using cluster centers from K means clustering
         coeff_groupsize = 1 #number of kernels to share a same coeff
 
         class Conv2d_q(_ConvNd):    
@@ -451,7 +456,7 @@ for act_prec in [8]:
                 return x
 
         model = CONV_tiny_quant()
-        model.cuda()
+        model.to(device)
 
         def train(train_loader, model, criterion, optimizer, epoch):
             """
@@ -473,8 +478,8 @@ for act_prec in [8]:
                 input = input.view(-1, 1, 28, 28)
                 input /= 255.0
 
-                input = input.cuda()
-                target = target.cuda()
+                input = input.to(device)
+                target = target.to(device)
 
                 # compute output
                 output = model(input)
@@ -522,8 +527,8 @@ for act_prec in [8]:
                 #print('new batch')
                 input = input.view(-1, 1, 28, 28)
                 input /= 255.0
-                input = input.cuda()
-                target = target.cuda()
+                input = input.to(device)
+                target = target.to(device)
 
                 # compute output
                 with torch.no_grad():
@@ -602,7 +607,7 @@ for act_prec in [8]:
                 correct_k = correct[:k].view(-1).float().sum(0)
                 res.append(correct_k.mul_(100.0 / batch_size))
             return res
-        criterion = nn.CrossEntropyLoss(size_average=True).cuda()
+        criterion = nn.CrossEntropyLoss(size_average=True).to(device)
 
 
         def load_dataset(root, mtype):
@@ -646,7 +646,9 @@ for epoch in range(n_epoch):
     total_time_h = total_time/3600
     print("epoch time is: ", elapsedtime, " s")
 
-from kmeans_pytorch import kmeans
+import sys
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'fw_training'))
+from lut_emulator import kmeans
 import torch.utils.model_zoo
 from torch import utils
 #state_dict = utils.model_zoo.load_url('https://download.pytorch.org/models/resnet18-5c106cde.pth',progress=True)
@@ -686,7 +688,7 @@ for n_cluster in [32,64,128]:
 
     # kmeans 
     cluster_ids_x, cluster_centers_cos = kmeans(
-        X=x, num_clusters=num_clusters, distance='cosine', device=torch.device('cuda:0'), tol = tol
+        X=x, num_clusters=num_clusters, distance='cosine', tol = tol
     )
     ccname = "resnet14_cifar_clustercenter_zdim" + str(n_cluster) + ".npy"
     output_path = os.path.join(ccfolder,ccname)
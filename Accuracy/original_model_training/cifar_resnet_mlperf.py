@@ -646,7 +646,9 @@ for epoch in range(n_epoch):
     print("epoch time is: ", elapsedtime, " s")
 
 
-from kmeans_pytorch import kmeans
+import sys
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'fw_training'))
+from lut_emulator import kmeans
 import torch.utils.model_zoo
 from torch import utils
 """Code for channel-wise pool"""
@@ -683,7 +685,7 @@ for n_cluster in [32,64,128]:
 
     # kmeans 
     cluster_ids_x, cluster_centers_cos = kmeans(
-        X=x, num_clusters=num_clusters, distance='cosine', device=torch.device('cuda:0'), tol = tol
+        X=x, num_clusters=num_clusters, distance='cosine', tol = tol
     )
     ccname = "resnet_mlperf_cifar_clustercenter_zdim" + str(n_cluster) + ".npy"
     output_path = os.path.join(ccfolder,ccname)
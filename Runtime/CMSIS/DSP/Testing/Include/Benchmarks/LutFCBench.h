@@ -0,0 +1,49 @@
+#include "Test.h"
+#include "Pattern.h"
+#include "arm_nnfunctions.h"
+class LutFCBench:public Client::Suite
+    {
+        public:
+            LutFCBench(Testing::testID_t id);
+            virtual void setUp(Testing::testID_t,std::vector<Testing::param_t>& params,Client::PatternMgr *mgr);
+            virtual void tearDown(Testing::testID_t,Client::PatternMgr *mgr);
+        private:
+            #include "LutFCBench_decl.h"
+            
+            Client::Pattern<q7_t> input;
+            Client::Pattern<q7_t> index;
+            Client::Pattern<q7_t> lut;
+            Client::Pattern<q31_t> bias;
+
+            Client::LocalPattern<uint8_t> lutTable;
+            Client::LocalPattern<uint8_t> kernelIdx;
+            Client::LocalPattern<uint8_t> coeffs;
+            Client::LocalPattern<q31_t> mult;
+            Client::LocalPattern<q31_t> shift;
+            Client::LocalPattern<q7_t> output;
+            Client::LocalPattern<q7_t> buffer;
+
+            cmsis_nn_context ctx;
+            cmsis_nn_fc_params fc_params;
+            cmsis_nn_per_channel_quant_params quant_params;
+            cmsis_nn_dims input_dims;
+            cmsis_nn_dims filter_dims;
+            cmsis_nn_dims bias_dims;
+            cmsis_nn_dims output_dims;
+
+            // Shape from the parameters: batch size, accumulation depth, neurons
+            // and number of pool vectors used by the layer.
+            // LUT_PREC and LUT_SIZE are build options of the kernels.
+            int nbBatches;
+            int inChannels;
+            int outChannels;
+            int poolSize;
+
+            q7_t *inp;
+            uint8_t *idxp;
+            uint8_t *lutp;
+            q31_t *biasp;
+            uint8_t *coeffp;
+            q7_t *outp;
+            
+    };
@@ -8,6 +8,7 @@ import Decimate
 import Distance
 import FastMath
 import FIR
+import LutNN
 import Matrix
 import Softmax 
 import Stats
@@ -25,6 +26,7 @@ Decimate.generatePatterns()
 Distance.generatePatterns()
 FastMath.generatePatterns()
 FIR.generatePatterns()
+LutNN.generatePatterns()
 Interpolate.generatePatterns()
 Matrix.generatePatterns()
 Softmax.generatePatterns()
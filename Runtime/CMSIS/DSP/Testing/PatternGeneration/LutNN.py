@@ -0,0 +1,37 @@
+import os.path
+import Tools
+import numpy as np
+
+# Random data for the weight pool (LUT) benchmarks.
+# The conv and FC suites share the same folder and patterns.
+# The suites only read the first samples they need, so each pattern
+# is sized for the largest configuration of bench.txt.
+NBINPUTS = 4096      # 8x8x64 conv input, 4x512 FC input
+NBINDEXES = 8192     # 3x3x(64/8)x64 conv, (512/8)x128 FC
+NBLUT = 256 * 32     # 256 rows of the default LUT_SIZE, tiled by the benchmarks for larger LUT_SIZE
+NBBIAS = 128
+
+def writeTests(config):
+    inputs = np.random.randint(-128, 128, NBINPUTS)
+    # Reinterpreted as uint8 by the benchmarks
+    indexes = np.random.randint(-128, 128, NBINDEXES)
+    lut = np.random.randint(-128, 128, NBLUT)
+    bias = np.random.randint(-1000, 1000, NBBIAS)
+
+    config.writeInputS8(1, inputs, "Input")
+    config.writeInputS8(1, indexes, "Index")
+    config.writeInputS8(1, lut, "Lut")
+    config.writeInputS32(1, bias, "Bias")
+
+def generatePatterns():
+    np.random.seed(0)
+    PATTERNDIR = os.path.join("Patterns","NN","Lut")
+    PARAMDIR = os.path.join("Parameters","NN","Lut")
+
+    configs8=Tools.Config(PATTERNDIR,PARAMDIR,"s8")
+
+    writeTests(configs8)
+
+
+if __name__ == '__main__':
+  generatePatterns()
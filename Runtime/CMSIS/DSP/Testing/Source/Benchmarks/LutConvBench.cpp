@@ -0,0 +1,147 @@
+#include "LutConvBench.h"
+#include "Error.h"
+#include "arm_nnsupportfunctions.h"
+
+/* LUT_SIZE comes from arm_nnsupportfunctions.h, the bench must be built with the same LUT_SIZE as the kernels */
+
+#define LUT_ROWS 256
+/* Row width of the shared Lut1_s8 pattern, the default LUT_SIZE */
+#define LUT_PATTERN_SIZE 32
+#define DIM_IN 8
+   
+    void LutConvBench::test_lut_conv_zdim_v1_s8()
+    {
+       lut_conv_zdim_v1(&ctx,&conv_params,&quant_params,
+           &input_dims,this->inp,
+           &filter_dims,this->idxp,
+           &bias_dims,this->biasp,
+           &output_dims,this->lutp,
+           this->outp);
+    } 
+
+    void LutConvBench::test_lut_conv_zdim_v2_s8()
+    {
+       lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,
+           &input_dims,this->inp,
+           &filter_dims,this->idxp,
+           &bias_dims,this->biasp,
+           &output_dims,this->lutp,
+           this->outp);
+    } 
+
+    void LutConvBench::test_lut_conv_zdim_v2_coeff_s8()
+    {
+       lut_conv_zdim_v2_coeff(&ctx,&conv_params,&quant_params,
+           &input_dims,this->inp,
+           &filter_dims,this->idxp,
+           &bias_dims,this->biasp,
+           &output_dims,this->lutp,
+           this->coeffp,
+           this->outp);
+    } 
+
+    
+    void LutConvBench::setUp(Testing::testID_t id,std::vector<Testing::param_t>& params,Client::PatternMgr *mgr)
+    {
+       (void)id;
+
+       std::vector<Testing::param_t>::iterator it = params.begin();
+       this->inChannels = *it++;
+       this->outChannels = *it++;
+       this->kernelSize = *it++;
+       this->poolSize = *it;
+
+       if (this->poolSize > LUT_SIZE)
+       {
+          this->poolSize = LUT_SIZE;
+       }
+
+       /* 8x8 input, stride 1 and same padding */
+       input_dims.n = 1;
+       input_dims.h = DIM_IN;
+       input_dims.w = DIM_IN;
+       input_dims.c = this->inChannels;
+
+       filter_dims.n = this->outChannels;
+       filter_dims.h = this->kernelSize;
+       filter_dims.w = this->kernelSize;
+       filter_dims.c = this->inChannels;
+
+       bias_dims.n = 1;
+       bias_dims.h = 1;
+       bias_dims.w = 1;
+       bias_dims.c = this->outChannels;
+
+       output_dims.n = 1;
+       output_dims.h = DIM_IN;
+       output_dims.w = DIM_IN;
+       output_dims.c = this->outChannels;
+
+       conv_params.input_offset = 128;
+       conv_params.output_offset = 0;
+       conv_params.stride.h = 1;
+       conv_params.stride.w = 1;
+       conv_params.padding.h = this->kernelSize / 2;
+       conv_params.padding.w = this->kernelSize / 2;
+       conv_params.dilation.h = 1;
+       conv_params.dilation.w = 1;
+       conv_params.activation.min = -128;
+       conv_params.activation.max = 127;
+
+       /* One index per (kernel position, channel block, filter) */
+       int nbIdx = this->kernelSize * this->kernelSize * (this->inChannels / 8) * this->outChannels;
+
+       input.reload(LutConvBench::INPUT1_S8_ID,mgr,DIM_IN * DIM_IN * this->inChannels);
+       index.reload(LutConvBench::INDEX1_S8_ID,mgr,nbIdx);
+       lut.reload(LutConvBench::LUT1_S8_ID,mgr,LUT_ROWS * LUT_PATTERN_SIZE);
+       bias.reload(LutConvBench::BIAS1_S32_ID,mgr,this->outChannels);
+
+       lutTable.create(LUT_ROWS * LUT_SIZE,LutConvBench::LUTTABLE_U8_ID,mgr);
+       kernelIdx.create(nbIdx,LutConvBench::KERNELIDX_U8_ID,mgr);
+       coeffs.create(nbIdx,LutConvBench::COEFFS_U8_ID,mgr);
+       mult.create(this->outChannels,LutConvBench::MULT_S32_ID,mgr);
+       shift.create(this->outChannels,LutConvBench::SHIFT_S32_ID,mgr);
+       output.create(DIM_IN * DIM_IN * this->outChannels,LutConvBench::OUTPUT_S8_ID,mgr);
+       /* 32-bit accumulators, enough for every kernel of the suite */
+       buffer.create(lut_conv_zdim_coeff_get_buffer_size(&output_dims),LutConvBench::BUFFER_S8_ID,mgr);
+
+       /* Random indices restricted to the first poolSize pool vectors, small coefficients */
+       const q7_t *rawIdx = index.ptr();
+       this->idxp = kernelIdx.ptr();
+       this->coeffp = coeffs.ptr();
+       for(int i=0; i < nbIdx; i++)
+       {
+          this->idxp[i] = ((uint8_t)rawIdx[i]) % this->poolSize;
+          this->coeffp[i] = (((uint8_t)rawIdx[i]) >> 5) + 1;
+       }
+
+       q31_t *multp = mult.ptr();
+       q31_t *shiftp = shift.ptr();
+       for(int i=0; i < this->outChannels; i++)
+       {
+          multp[i] = 1073741824;
+          shiftp[i] = -6;
+       }
+       quant_params.multiplier = multp;
+       quant_params.shift = shiftp;
+
+       ctx.buf = buffer.ptr();
+       ctx.size = lut_conv_zdim_coeff_get_buffer_size(&output_dims);
+
+       this->inp = input.ptr();
+       /* The pattern rows are repeated when the kernels are built with a larger LUT_SIZE */
+       const q7_t *rawLut = lut.ptr();
+       this->lutp = lutTable.ptr();
+       for(int i=0; i < LUT_ROWS * LUT_SIZE; i++)
+       {
+          this->lutp[i] = (uint8_t)rawLut[i % (LUT_ROWS * LUT_PATTERN_SIZE)];
+       }
+       this->biasp = bias.ptr();
+       this->outp = output.ptr();
+    }
+
+    void LutConvBench::tearDown(Testing::testID_t id,Client::PatternMgr *mgr)
+    {
+       (void)id;
+       (void)mgr;
+    }
@@ -0,0 +1,130 @@
+#include "LutFCBench.h"
+#include "Error.h"
+#include "arm_nnsupportfunctions.h"
+
+/* LUT_SIZE comes from arm_nnsupportfunctions.h, the bench must be built with the same LUT_SIZE as the kernels */
+
+#define LUT_ROWS 256
+/* Row width of the shared Lut1_s8 pattern, the default LUT_SIZE */
+#define LUT_PATTERN_SIZE 32
+   
+    void LutFCBench::test_lut_fully_connected_zdim_s8()
+    {
+       lut_fully_connected_zdim(&ctx,&fc_params,&quant_params,
+           &input_dims,this->inp,
+           &filter_dims,this->idxp,
+           &bias_dims,this->biasp,
+           &output_dims,this->lutp,
+           NULL,
+           this->outp);
+    } 
+
+    void LutFCBench::test_lut_fully_connected_zdim_coeff_s8()
+    {
+       lut_fully_connected_zdim(&ctx,&fc_params,&quant_params,
+           &input_dims,this->inp,
+           &filter_dims,this->idxp,
+           &bias_dims,this->biasp,
+           &output_dims,this->lutp,
+           this->coeffp,
+           this->outp);
+    } 
+
+    
+    void LutFCBench::setUp(Testing::testID_t id,std::vector<Testing::param_t>& params,Client::PatternMgr *mgr)
+    {
+       (void)id;
+
+       std::vector<Testing::param_t>::iterator it = params.begin();
+       this->nbBatches = *it++;
+       this->inChannels = *it++;
+       this->outChannels = *it++;
+       this->poolSize = *it;
+
+       if (this->poolSize > LUT_SIZE)
+       {
+          this->poolSize = LUT_SIZE;
+       }
+
+       input_dims.n = this->nbBatches;
+       input_dims.h = 1;
+       input_dims.w = 1;
+       input_dims.c = this->inChannels;
+
+       filter_dims.n = this->inChannels;
+       filter_dims.h = 1;
+       filter_dims.w = 1;
+       filter_dims.c = this->outChannels;
+
+       bias_dims.n = 1;
+       bias_dims.h = 1;
+       bias_dims.w = 1;
+       bias_dims.c = this->outChannels;
+
+       output_dims.n = this->nbBatches;
+       output_dims.h = 1;
+       output_dims.w = 1;
+       output_dims.c = this->outChannels;
+
+       fc_params.input_offset = 128;
+       fc_params.filter_offset = 0;
+       fc_params.output_offset = 0;
+       fc_params.activation.min = -128;
+       fc_params.activation.max = 127;
+
+       /* One index per (channel block, neuron) */
+       int nbIdx = (this->inChannels / 8) * this->outChannels;
+
+       input.reload(LutFCBench::INPUT1_S8_ID,mgr,this->nbBatches * this->inChannels);
+       index.reload(LutFCBench::INDEX1_S8_ID,mgr,nbIdx);
+       lut.reload(LutFCBench::LUT1_S8_ID,mgr,LUT_ROWS * LUT_PATTERN_SIZE);
+       bias.reload(LutFCBench::BIAS1_S32_ID,mgr,this->outChannels);
+
+       lutTable.create(LUT_ROWS * LUT_SIZE,LutFCBench::LUTTABLE_U8_ID,mgr);
+       kernelIdx.create(nbIdx,LutFCBench::KERNELIDX_U8_ID,mgr);
+       coeffs.create(nbIdx,LutFCBench::COEFFS_U8_ID,mgr);
+       mult.create(this->outChannels,LutFCBench::MULT_S32_ID,mgr);
+       shift.create(this->outChannels,LutFCBench::SHIFT_S32_ID,mgr);
+       output.create(this->nbBatches * this->outChannels,LutFCBench::OUTPUT_S8_ID,mgr);
+       buffer.create(lut_fully_connected_zdim_get_buffer_size(&output_dims),LutFCBench::BUFFER_S8_ID,mgr);
+
+       /* Random indices restricted to the first poolSize pool vectors, small coefficients */
+       const q7_t *rawIdx = index.ptr();
+       this->idxp = kernelIdx.ptr();
+       this->coeffp = coeffs.ptr();
+       for(int i=0; i < nbIdx; i++)
+       {
+          this->idxp[i] = ((uint8_t)rawIdx[i]) % this->poolSize;
+          this->coeffp[i] = (((uint8_t)rawIdx[i]) >> 5) + 1;
+       }
+
+       q31_t *multp = mult.ptr();
+       q31_t *shiftp = shift.ptr();
+       for(int i=0; i < this->outChannels; i++)
+       {
+          multp[i] = 1073741824;
+          shiftp[i] = -6;
+       }
+       quant_params.multiplier = multp;
+       quant_params.shift = shiftp;
+
+       ctx.buf = buffer.ptr();
+       ctx.size = lut_fully_connected_zdim_get_buffer_size(&output_dims);
+
+       this->inp = input.ptr();
+       /* The pattern rows are repeated when the kernels are built with a larger LUT_SIZE */
+       const q7_t *rawLut = lut.ptr();
+       this->lutp = lutTable.ptr();
+       for(int i=0; i < LUT_ROWS * LUT_SIZE; i++)
+       {
+          this->lutp[i] = (uint8_t)rawLut[i % (LUT_ROWS * LUT_PATTERN_SIZE)];
+       }
+       this->biasp = bias.ptr();
+       this->outp = output.ptr();
+    }
+
+    void LutFCBench::tearDown(Testing::testID_t id,Client::PatternMgr *mgr)
+    {
+       (void)id;
+       (void)mgr;
+    }
@@ -23,4 +23,8 @@ python addToDB.py Unary
 echo "Binary Matrix"
 python addToDB.py Binary
 echo "Transform"
-python addToDB.py Transform
\ No newline at end of file
+python addToDB.py Transform
+echo "LUT Convolution"
+python addToDB.py LutConvBench
+echo "LUT Fully Connected"
+python addToDB.py LutFCBench
\ No newline at end of file
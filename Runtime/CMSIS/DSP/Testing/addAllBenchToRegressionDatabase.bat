@@ -23,4 +23,8 @@ python addToRegDB.py Unary
 echo "Binary Matrix"
 python addToRegDB.py Binary
 echo "Transform"
-python addToRegDB.py Transform
\ No newline at end of file
+python addToRegDB.py Transform
+echo "LUT Convolution"
+python addToRegDB.py LutConvBench
+echo "LUT Fully Connected"
+python addToRegDB.py LutFCBench
\ No newline at end of file
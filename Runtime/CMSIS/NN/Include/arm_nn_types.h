@@ -32,6 +32,7 @@
 #define _ARM_NN_TYPES_H
 
 #include <stdint.h>
+#include "../../DSP/Include/arm_math_types.h"
 
 /** CMSIS-NN object to contain the width and height of a tile */
 typedef struct
@@ -127,4 +128,230 @@ typedef struct
     cmsis_nn_activation output_activation;
 } cmsis_nn_svdf_params;
 
+/** Layer kinds understood by the weight pool network executor */
+typedef enum
+{
+    LUT_LAYER_CONV_S8 = 0,  /**< Dense s8 convolution, arm_convolve_s8 */
+    LUT_LAYER_LUT_CONV_V1,  /**< Weight pool convolution, lut_conv_zdim_v1 */
+    LUT_LAYER_LUT_CONV_V2,  /**< Weight pool convolution, lut_conv_zdim_v2_double_lookup */
+    LUT_LAYER_MAX_POOL_S8,  /**< Max pooling, arm_max_pool_s8. Stride, padding and activation come from conv_params */
+    LUT_LAYER_LUT_FC,       /**< Weight pool fully connected, lut_fully_connected_zdim, on the flattened input.
+                                 filter_dims covers the whole input (h, w, c), output_dims is 1x1xC_OUT */
+    LUT_LAYER_LUT_CONV_V2_COEFF,      /**< Weight pool convolution with per block multipliers, lut_conv_zdim_v2_coeff */
+    LUT_LAYER_LUT_CONV_V2_COEFF_SHIFT, /**< Weight pool convolution with per block shifts, lut_conv_zdim_v2_coeff_shift */
+    LUT_LAYER_LUT_CONV_V1_SPARSE,      /**< Weight pool convolution skipping zero activations, lut_conv_zdim_v1_sparse */
+    LUT_LAYER_LUT_CONV_V2_SPARSE,      /**< Weight pool convolution skipping zero activations, lut_conv_zdim_v2_sparse */
+    LUT_LAYER_LUT_CONV_V1_DYNPREC,     /**< Weight pool convolution with per block precision, lut_conv_zdim_v1_dynprec */
+    LUT_LAYER_LUT_CONV_V2_DYNPREC      /**< Weight pool convolution with per block precision, lut_conv_zdim_v2_dynprec */
+} lut_layer_type;
+
+/** Signature of the LUT convolution kernels (lut_conv_zdim_v1), used for the generated shape specialised kernels */
+typedef arm_status (*lut_conv_kernel)(const cmsis_nn_context *ctx,
+                                      const cmsis_nn_conv_params *conv_params,
+                                      const cmsis_nn_per_channel_quant_params *quant_params,
+                                      const cmsis_nn_dims *input_dims,
+                                      const q7_t *input_data,
+                                      const cmsis_nn_dims *filter_dims,
+                                      const uint8_t *kernel_idx,
+                                      const cmsis_nn_dims *bias_dims,
+                                      const int32_t *bias_data,
+                                      const cmsis_nn_dims *output_dims,
+                                      const uint8_t *filter_pool_data,
+                                      q7_t *output_data);
+
+/** One entry of the weight pool network layer table */
+typedef struct
+{
+    lut_layer_type type;
+    cmsis_nn_conv_params conv_params;
+    cmsis_nn_per_channel_quant_params quant_params;
+    cmsis_nn_dims input_dims;
+    cmsis_nn_dims filter_dims;
+    cmsis_nn_dims output_dims;
+    const int8_t *weights;     /**< Dense weights, LUT_LAYER_CONV_S8 only */
+    const uint8_t *kernel_idx; /**< Weight pool indices, LUT layers only */
+    const uint8_t *coeffs;     /**< Per block coefficients of the coeff conv layers, optional for LUT_LAYER_LUT_FC */
+    const int32_t *bias_data;
+    lut_conv_kernel kernel;    /**< Shape specialised kernel of a LUT_CONV_V1 / V2 layer (lut_kernel_gen.py), NULL for the
+                                    generic one */
+} lut_layer;
+
+/** Weight pool network: a layer table executed in order, layer i+1 consuming the output of layer i */
+typedef struct
+{
+    const lut_layer *layers;
+    int32_t num_layers;
+    const uint8_t *filter_pool_data; /**< Lookup table shared by all LUT layers */
+} lut_network;
+
+/** Worker pool of the multi-threaded host backend (LUT_HOST_THREADS), opaque */
+typedef struct lut_thread_pool lut_thread_pool;
+
+/** Free running cycle counter of the time-sliced executor, e.g. DWT->CYCCNT on a Cortex-M. Only differences are used,
+    so it may wrap */
+typedef uint32_t (*lut_task_clock)(void);
+
+/** State of a time-sliced network run (lut_network_task_init / lut_network_task_step). The run is a sequence of tiles,
+    a tile being tile_rows output rows of one layer, and lut_network_task_step runs tiles until its budget is used */
+typedef struct
+{
+    const lut_network *net;
+    const q7_t *input_data;
+    q7_t *output_data;
+    q7_t *ping_pong[2];         /**< Intermediate activations, layer i writes ping_pong[i & 1] */
+    cmsis_nn_context scratch;   /**< Kernel scratch of lut_layer_run_rows */
+    lut_task_clock clock;       /**< NULL: the budget of a step is a number of tiles */
+    int32_t tile_rows;          /**< Output rows per tile */
+    int32_t layer;              /**< Layer of the next tile, num_layers once the run is complete */
+    int32_t row;                /**< First output row of the next tile */
+    uint32_t tile_cycles;       /**< Cycles of the last tile of the current layer, 0 before its first tile */
+    uint32_t steps;             /**< Calls of lut_network_task_step */
+    uint32_t tiles;             /**< Tiles run */
+    uint32_t max_tile_cycles;   /**< Longest tile, the worst case overrun of a budget */
+    uint32_t overhead_cycles;   /**< Cycles of the steps spent outside the layer kernels */
+} lut_network_task;
+
+#define LUT_WINDOW_MAX_LAYERS 16 /**< Layers of a sliding window network (lut_network_window_init) */
+
+/** State of a sliding window network (lut_network_window_init / lut_network_window_push). The rows (H) of the input
+    are the time axis: every push shifts the window by hop input rows, and the rows of every layer output that the
+    shift leaves unchanged are kept instead of being computed again */
+typedef struct
+{
+    const lut_network *net;
+    q7_t *tensor[LUT_WINDOW_MAX_LAYERS + 1]; /**< Input window, then the full output of every layer */
+    int32_t hop[LUT_WINDOW_MAX_LAYERS + 1];  /**< Rows every tensor shifts by per push, 0 for fully connected outputs */
+    cmsis_nn_context scratch;                /**< Kernel scratch of lut_layer_run_rows */
+    int32_t primed;                          /**< Non-zero once the outputs match the input window */
+    uint32_t rows_computed;                  /**< Output rows computed by the pushes, over all layers */
+    uint32_t rows_reused;                    /**< Output rows kept from the previous window, over all layers */
+} lut_network_window;
+
+#define LUT_MODEL_MAGIC 0x4D54554C /**< "LUTM", little endian */
+#define LUT_MODEL_VERSION 1
+
+/** Header of a binary weight pool model (see lut_model_load). All fields are little endian, offsets are in bytes
+    from the start of the model and are multiples of 4 */
+typedef struct
+{
+    uint32_t magic;         /**< LUT_MODEL_MAGIC */
+    uint32_t version;       /**< LUT_MODEL_VERSION */
+    uint32_t size;          /**< Size of the whole model in bytes */
+    uint32_t crc32;         /**< CRC-32 (zlib) of the bytes after the header */
+    int32_t num_layers;     /**< Number of lut_model_layer records */
+    int32_t lut_size;       /**< Number of columns (pool kernels) of the lookup table, LUT_SIZE of the kernels */
+    uint32_t lut_offset;    /**< Lookup table, 256 rows of lut_size bytes */
+    uint32_t layers_offset; /**< Layer records */
+} lut_model_header;
+
+/** Layer record of a binary weight pool model, the file form of lut_layer. A data offset of 0 means no data */
+typedef struct
+{
+    int32_t type; /**< lut_layer_type */
+    int32_t input_offset;
+    int32_t output_offset;
+    int32_t stride_w;
+    int32_t stride_h;
+    int32_t pad_w;
+    int32_t pad_h;
+    int32_t act_min;
+    int32_t act_max;
+    cmsis_nn_dims input_dims;
+    cmsis_nn_dims filter_dims;
+    cmsis_nn_dims output_dims;
+    uint32_t mult_offset;       /**< int32_t[output_dims.c] */
+    uint32_t shift_offset;      /**< int32_t[output_dims.c] */
+    uint32_t bias_offset;       /**< int32_t[output_dims.c] */
+    uint32_t kernel_idx_offset; /**< uint8_t, one per (kernel position, block, output channel). Not bit packed:
+                                     one byte per index, the layout the kernels read in place */
+    uint32_t coeffs_offset;     /**< uint8_t, same count as kernel_idx */
+    uint32_t weights_offset;    /**< int8_t dense weights, LUT_LAYER_CONV_S8 only */
+} lut_model_layer;
+
+#define LUT_ROW_CACHE_MAX_WAYS 4
+#define LUT_ROW_CACHE_EMPTY 0xFFFF        /**< Tag of a slot holding no row */
+#define LUT_ROW_CACHE_PINNED 0xFFFFFFFF   /**< Stamp of a pre-warmed slot, never evicted */
+
+/** Set associative SRAM cache of lookup table rows in front of a LUT in flash (see lut_row_cache_init).
+    Row r can only live in set r & (sets - 1), the least recently used way is replaced */
+typedef struct
+{
+    const uint8_t *lut;   /**< Cached lookup table, 256 rows of row_size bytes */
+    uint32_t *stamps;     /**< Block (epoch) of the last use of each slot */
+    uint16_t *tags;       /**< LUT row held by each slot */
+    uint8_t *rows;        /**< Row data, slot s at rows + s * row_size */
+    int32_t row_size;     /**< LUT_SIZE */
+    int32_t sets;         /**< Power of two */
+    int32_t ways;         /**< 1 (direct mapped) to LUT_ROW_CACHE_MAX_WAYS */
+    uint32_t epoch;       /**< Current block, rows used by the current block are never evicted */
+    uint32_t hits;
+    uint32_t misses;      /**< Row fetches from the LUT, including the ones that could not be cached */
+    uint32_t *row_count;  /**< Optional 256-entry access count of every row, for lut_row_cache_warm. NULL to disable */
+} lut_row_cache;
+
+/** Zero activation counters of the _sparse LUT kernels, accumulated over calls. A block is 8 input channels of one
+    pixel, a plane one bit plane of a block (LUT_PREC per block) */
+typedef struct
+{
+    uint32_t blocks;
+    uint32_t zero_blocks; /**< Blocks with every plane zero, no LUT row is read */
+    uint32_t planes;
+    uint32_t zero_planes; /**< Planes with index 0, their LUT row is not copied */
+} lut_sparsity_stats;
+
+/** Block precision histogram of the _dynprec LUT kernels, accumulated over calls. blocks[p] counts the blocks (8 input
+    channels of one pixel) whose values fit in p bits, only p bit planes are looked up for them */
+typedef struct
+{
+    uint32_t blocks[9];
+} lut_precision_stats;
+
+/** Activation formats of the _bitplane LUT kernels. The bit-plane format is [N][H][W][C / 8][LUT_PREC] bytes: byte b of
+    a block is the LUT row index of bit plane b of its 8 channels (lut_nn_bitplane_index), with the input offset of
+    the consuming layer already added, so the consumer reads its indices without generating them */
+typedef struct
+{
+    int32_t input_planes;        /**< Non-zero: the input is in the bit-plane format, conv_params->input_offset is
+                                      not used */
+    int32_t output_planes;       /**< Non-zero: the output is written in the bit-plane format, C_OUT % 8 == 0 */
+    int32_t output_plane_offset; /**< Input offset of the consuming layer, added before the planes are written */
+} lut_bitplane_params;
+
+/** Packed n-bit activations: value i of a tensor is stored in bits [i * bits, (i + 1) * bits) of the byte array (low
+    bits first) as (x + offset) & ((1 << bits) - 1). Exact for values with 0 <= x + offset < (1 << bits), e.g. LUT
+    layer outputs clamped to that range. A block of 8 channels always starts on a byte */
+typedef struct
+{
+    int32_t bits;   /**< Bits per value: 1, 2, 4 or 8 */
+    int32_t offset; /**< Added before packing, subtracted when unpacking */
+} lut_pack_params;
+
+/** Compact weight pool for on-device LUT synthesis (lut_synth_columns): the int8 pool vectors of gen_pool.py --header
+    and the requantization of their partial sums to LUT entries */
+typedef struct
+{
+    const int8_t *vectors; /**< pool_size x 8 vectors, vector k is pool kernel (LUT column) k, element j channel j */
+    int32_t pool_size;     /**< At most LUT_SIZE */
+    int32_t multiplier;    /**< Partial sum to LUT entry, arm_nn_requantize(sum, multiplier, shift) */
+    int32_t shift;
+    int32_t entry_min;     /**< Clamp of the entries, before they are stored as bytes */
+    int32_t entry_max;
+} lut_pool_vectors;
+
+/** Classifier tail of a weight pool network (lut_classifier_tail): global average pool, LUT fully connected layer
+    (lut_fully_connected_zdim layout) and optional softmax */
+typedef struct
+{
+    cmsis_nn_activation pool_activation;               /**< Clamp of the pooled values, as arm_avgpool_s8 */
+    cmsis_nn_fc_params fc_params;                      /**< filter_offset is not used */
+    cmsis_nn_per_channel_quant_params fc_quant_params; /**< One multiplier and shift per class */
+    const uint8_t *kernel_idx;                         /**< Block major weight pool indices of the FC layer */
+    const int32_t *bias;                               /**< Per class, can be NULL */
+    const uint8_t *coeffs;                             /**< Per block coefficients, can be NULL */
+    int32_t softmax;          /**< Non-zero: the scores are the arm_softmax_s8 outputs, zero: the int8 logits */
+    int32_t softmax_mult;     /**< arm_softmax_s8 mult */
+    int32_t softmax_shift;    /**< arm_softmax_s8 shift */
+    int32_t softmax_diff_min; /**< arm_softmax_s8 diff_min */
+} lut_tail_params;
+
 #endif // _ARM_NN_TYPES_H
@@ -125,7 +125,7 @@
 #define _ARM_NNFUNCTIONS_H
 
 //#include "arm_math_types.h"
-#include "..\..\DSP\Include\arm_math_types.h"
+#include "../../DSP/Include/arm_math_types.h"
 #include "arm_nn_types.h"
 
 #define USE_INTRINSIC
@@ -2273,6 +2273,844 @@ arm_status lut_conv_zdim_v4_memorization(const cmsis_nn_context *ctx,
                            const cmsis_nn_dims *output_dims,
                            const uint8_t* filter_pool_data,
                            q7_t *output_data);
+
+arm_status lut_conv_zdim_v5_fusedpooling(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data);
+
+/**
+ * @brief Get the required buffer size for the lut_conv_zdim_* kernels
+ * @param[in]   output_dims   Output tensor dimensions. Format: [N, H, W, C_OUT]
+ * @return      The function returns the size of the accumulator buffer in bytes. When ctx->buf is
+ *              at least this large the kernels use it instead of allocating from the heap.
+ */
+int32_t lut_conv_zdim_get_buffer_size(const cmsis_nn_dims *output_dims);
+
+/**
+ * @brief Batch-interleaved lut_conv_zdim_v2_double_lookup
+ * @details Same arguments and results as lut_conv_zdim_v2_double_lookup, input_dims->n images are processed
+ *          LUT_BATCH_TILE at a time so that every kernel index read is shared by the images of a tile.
+ *          A single image is passed on to lut_conv_zdim_v2_double_lookup.
+ *          ctx->buf should hold lut_conv_zdim_batch_get_buffer_size() bytes, otherwise the accumulators are
+ *          allocated from the heap.
+ */
+arm_status lut_conv_zdim_v2_batch(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data);
+
+/**
+ * @brief Get the required buffer size for lut_conv_zdim_v2_batch
+ * @param[in]   input_dims    Input tensor dimensions, n is the batch size
+ * @param[in]   output_dims   Output tensor dimensions. Format: [N, H, W, C_OUT]
+ * @return      The function returns the size of the accumulator buffer in bytes
+ */
+int32_t lut_conv_zdim_batch_get_buffer_size(const cmsis_nn_dims *input_dims, const cmsis_nn_dims *output_dims);
+
+/**
+ * @brief Coefficient scaled lut_conv_zdim_v1
+ * @details Same arguments as lut_conv_zdim_v2_coeff. The result of every filter is computed bit-serially from the
+ *          copied LUT rows, as in lut_conv_zdim_v1, and multiplied by its coefficient.
+ *          ctx->buf should hold lut_conv_zdim_coeff_get_buffer_size() bytes.
+ */
+arm_status lut_conv_zdim_v1_coeff(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const uint8_t* coeffs,
+                           q7_t *output_data);
+
+/**
+ * @brief Coefficient scaled lut_conv_zdim_v2_double_lookup
+ * @details Same arguments as lut_conv_zdim_v2_double_lookup plus coeffs, one small multiplier per logical kernel
+ *          (8-wide weight block of a filter) in the kernel_idx order, e.g. full_network_coeff_layer_N.
+ *          The result of a physical kernel is computed once per block and multiplied by the coefficient of each
+ *          filter using it. ctx->buf should hold lut_conv_zdim_coeff_get_buffer_size() bytes.
+ */
+arm_status lut_conv_zdim_v2_coeff(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const uint8_t* coeffs,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v2_coeff with power-of-two coefficients, coeffs holds the left shift of each logical kernel
+ */
+arm_status lut_conv_zdim_v2_coeff_shift(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const uint8_t* coeffs,
+                           q7_t *output_data);
+
+/**
+ * @brief Get the required buffer size for lut_conv_zdim_v1_coeff, lut_conv_zdim_v2_coeff and lut_conv_zdim_v2_coeff_shift
+ */
+int32_t lut_conv_zdim_coeff_get_buffer_size(const cmsis_nn_dims *output_dims);
+
+/**
+ * @brief lut_conv_zdim_v1 reading the LUT rows through an SRAM row cache
+ * @param[in, out] cache            Row cache of filter_pool_data (lut_row_cache_init), hit and miss counts are updated
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_ARGUMENT_ERROR</code> if the
+ *                 cache was set up for another LUT or LUT_SIZE
+ *
+ * @details        Other arguments and results as lut_conv_zdim_v1. ctx->buf should hold
+ *                 lut_conv_zdim_get_buffer_size() bytes.
+ */
+arm_status lut_conv_zdim_v1_cached(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_row_cache *cache,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v2_double_lookup reading the LUT rows through an SRAM row cache, see lut_conv_zdim_v1_cached
+ */
+arm_status lut_conv_zdim_v2_cached(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_row_cache *cache,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v1 skipping the zero activations of post-relu inputs
+ * @param[in, out] stats            Optional zero block and zero plane counters, accumulated. Can be NULL
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>
+ *
+ * @details        Other arguments and results as lut_conv_zdim_v1. The LUT row of a zero bit plane is not copied and
+ *                 a block with only zero planes costs one table read per filter, or nothing if row 0 of the pool is
+ *                 zero. ctx->buf should hold lut_conv_zdim_get_buffer_size() bytes.
+ */
+arm_status lut_conv_zdim_v1_sparse(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_sparsity_stats *stats,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v2_double_lookup skipping the zero activations of post-relu inputs, see lut_conv_zdim_v1_sparse
+ */
+arm_status lut_conv_zdim_v2_sparse(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_sparsity_stats *stats,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v1 looking up only the bit planes each block needs
+ * @param[in, out] stats            Optional histogram of the block precisions, accumulated. Can be NULL
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>
+ *
+ * @details        Other arguments and results as lut_conv_zdim_v1. A block whose 8 values fit in p bits (clz of their
+ *                 OR) generates, copies and looks up p planes instead of LUT_PREC, the higher planes are applied with
+ *                 one multiply of LUT row 0. ctx->buf should hold lut_conv_zdim_get_buffer_size() bytes.
+ */
+arm_status lut_conv_zdim_v1_dynprec(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_precision_stats *stats,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v2_double_lookup looking up only the bit planes each block needs, see lut_conv_zdim_v1_dynprec
+ */
+arm_status lut_conv_zdim_v2_dynprec(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_precision_stats *stats,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v1 for 1x1 (pointwise) layers
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>
+ *
+ * @details        Arguments and results as lut_conv_zdim_v1. A layer with a 1x1 filter, stride 1 and no padding is
+ *                 run as a pixels x channels matrix, several pixels sharing each kernel index read; other layers
+ *                 are passed to lut_conv_zdim_v1. output_data may be input_data when C_OUT <= C_IN.
+ *                 ctx->buf should hold lut_conv_zdim_pointwise_get_buffer_size() bytes.
+ */
+arm_status lut_conv_zdim_v1_pointwise(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v2_double_lookup for 1x1 (pointwise) layers, see lut_conv_zdim_v1_pointwise
+ */
+arm_status lut_conv_zdim_v2_pointwise(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data);
+
+/**
+ * @brief Get the required buffer size for lut_conv_zdim_v1_pointwise and lut_conv_zdim_v2_pointwise
+ */
+int32_t lut_conv_zdim_pointwise_get_buffer_size(const cmsis_nn_dims *output_dims);
+
+/**
+ * @brief Size in bytes of an activation tensor in the bit-plane format, N * H * W * (C / 8) * LUT_PREC
+ */
+int32_t lut_bitplane_get_size(const cmsis_nn_dims *dims);
+
+/**
+ * @brief Convert q7 HWC activations to the bit-plane format (see lut_bitplane_params)
+ * @param[in]      input_data    q7 activations
+ * @param[in]      dims          Activation dimensions, C % 8 == 0
+ * @param[in]      input_offset  Input offset of the consuming LUT layer
+ * @param[out]     planes        lut_bitplane_get_size() bytes
+ */
+void lut_bitplane_from_s8(const q7_t *input_data, const cmsis_nn_dims *dims, const int32_t input_offset, uint8_t *planes);
+
+/**
+ * @brief Convert bit-plane activations back to q7 HWC, e.g. for a CMSIS s8 layer
+ * @param[in]      planes        Activations in the bit-plane format
+ * @param[in]      dims          Activation dimensions
+ * @param[in]      input_offset  Offset the planes were written with
+ * @param[out]     output_data   q7 activations, exact when every value plus input_offset fits in LUT_PREC bits
+ */
+void lut_bitplane_to_s8(const uint8_t *planes, const cmsis_nn_dims *dims, const int32_t input_offset, q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v1 with bit-plane input and / or output activations
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_SIZE_MISMATCH</code> for a
+ *                 bit-plane output with C_OUT % 8 != 0
+ *
+ * @details        Arguments and results as lut_conv_zdim_v1. bp_params selects the format of input_data and
+ *                 output_data, a bit-plane input is read without index generation and a bit-plane output is packed
+ *                 by the requantize epilogue for the next LUT layer. Both layouts give the same results as the q7 ones.
+ */
+arm_status lut_conv_zdim_v1_bitplane(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_bitplane_params *bp_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v2_double_lookup with bit-plane activations, see lut_conv_zdim_v1_bitplane
+ */
+arm_status lut_conv_zdim_v2_bitplane(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_bitplane_params *bp_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data);
+
+/**
+ * @brief Size in bytes of count packed activations
+ */
+int32_t lut_packed_get_size(const int32_t count, const lut_pack_params *pack);
+
+/**
+ * @brief Pack q7 activations into n-bit values (see lut_pack_params)
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_ARGUMENT_ERROR</code> for an
+ *                 unsupported width
+ */
+arm_status lut_pack_s8(const q7_t *input, const int32_t count, const lut_pack_params *pack, uint8_t *packed);
+
+/**
+ * @brief Unpack n-bit activations to q7, see lut_pack_s8
+ */
+arm_status lut_unpack_s8(const uint8_t *packed, const int32_t count, const lut_pack_params *pack, q7_t *output);
+
+/**
+ * @brief lut_conv_zdim_v1 on packed n-bit activations
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_ARGUMENT_ERROR</code> for an
+ *                 unsupported width
+ *
+ * @details        Arguments and results as lut_conv_zdim_v1. input_pack / output_pack give the packing of
+ *                 input_data / output_data, NULL for q7. The outputs are clamped by conv_params->activation before
+ *                 they are packed, so the activation range should fit the output width.
+ */
+arm_status lut_conv_zdim_v1_packed(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_pack_params *input_pack,
+                           const lut_pack_params *output_pack,
+                           const cmsis_nn_dims *input_dims,
+                           const uint8_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           uint8_t *output_data);
+
+/**
+ * @brief lut_conv_zdim_v2_double_lookup on packed n-bit activations, see lut_conv_zdim_v1_packed
+ */
+arm_status lut_conv_zdim_v2_packed(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_pack_params *input_pack,
+                           const lut_pack_params *output_pack,
+                           const cmsis_nn_dims *input_dims,
+                           const uint8_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           uint8_t *output_data);
+
+/**
+ * @brief arm_max_pool_s8 on packed n-bit activations, input and output packed with pack
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>
+ */
+arm_status lut_max_pool_packed(const cmsis_nn_pool_params *pool_params,
+                               const lut_pack_params *pack,
+                               const cmsis_nn_dims *input_dims,
+                               const uint8_t *src,
+                               const cmsis_nn_dims *filter_dims,
+                               const cmsis_nn_dims *output_dims,
+                               uint8_t *dst);
+
+/**
+ * @brief arm_elementwise_add_s8 on packed n-bit activations
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_ARGUMENT_ERROR</code> for an
+ *                 unsupported width
+ *
+ * @details        Offsets, multipliers, shifts and clamp as arm_elementwise_add_s8, on the unpacked q7 values.
+ *                 Every tensor has its own packing.
+ */
+arm_status lut_elementwise_add_packed(const uint8_t *input_1_vect,
+                                      const lut_pack_params *input_1_pack,
+                                      const uint8_t *input_2_vect,
+                                      const lut_pack_params *input_2_pack,
+                                      const int32_t input_1_offset,
+                                      const int32_t input_1_mult,
+                                      const int32_t input_1_shift,
+                                      const int32_t input_2_offset,
+                                      const int32_t input_2_mult,
+                                      const int32_t input_2_shift,
+                                      const int32_t left_shift,
+                                      uint8_t *output,
+                                      const lut_pack_params *output_pack,
+                                      const int32_t out_offset,
+                                      const int32_t out_mult,
+                                      const int32_t out_shift,
+                                      const int32_t out_activation_min,
+                                      const int32_t out_activation_max,
+                                      const uint32_t block_size);
+
+/**
+ * @brief Memory needed by a row cache of sets x ways rows of LUT_SIZE bytes, tags and ages included
+ */
+int32_t lut_row_cache_get_buffer_size(const int32_t sets, const int32_t ways);
+
+/**
+ * @brief Set up an empty row cache in a caller provided buffer
+ * @param[out]     cache  Row cache
+ * @param[in]      buf    Cache memory (SRAM), 4-byte aligned
+ * @param[in]      size   Size of buf, the largest power of two number of sets that fits is used
+ * @param[in]      ways   Ways per set, 1 (direct mapped) to LUT_ROW_CACHE_MAX_WAYS
+ * @param[in]      lut    Lookup table in flash, 256 rows of LUT_SIZE bytes
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>, <code>ARM_MATH_ARGUMENT_ERROR</code> for an
+ *                 unsupported number of ways or <code>ARM_MATH_SIZE_MISMATCH</code> if not even one set fits in size
+ */
+arm_status lut_row_cache_init(lut_row_cache *cache, void *buf, const int32_t size, const int32_t ways,
+                              const uint8_t *lut);
+
+/**
+ * @brief Empty the cache and clear the hit and miss counts
+ */
+void lut_row_cache_reset(lut_row_cache *cache);
+
+/**
+ * @brief Pre-load the most used rows of every set
+ * @param[in, out] cache      Row cache, emptied first
+ * @param[in]      row_count  Access count of the 256 rows, e.g. cache->row_count after a profiling run
+ * @param[in]      pin        Non-zero to keep the loaded rows for good, only the remaining ways are then replaced
+ */
+void lut_row_cache_warm(lut_row_cache *cache, const uint32_t *row_count, const int32_t pin);
+
+/**
+ * @brief Weight pool fully connected layer using the lookup table layout of the lut_conv_zdim_* kernels
+ * @param[in, out] ctx              Function context, ctx->buf holds the accumulators
+ *                                  (see lut_fully_connected_zdim_get_buffer_size), allocated from the heap otherwise
+ * @param[in]      fc_params        Input/output offsets and activation. filter_offset is not used
+ * @param[in]      quant_params     Per-channel (per neuron) requantization parameters
+ * @param[in]      input_dims       Input dimensions, n is the batch size
+ * @param[in]      input            Input data, input_dims->n vectors of filter_dims->n values
+ * @param[in]      filter_dims      n is the accumulation depth, must be a multiple of 8
+ * @param[in]      kernel_idx       Physical kernel of every (block, neuron), block major: kernel_idx[block * C_OUT + neuron]
+ * @param[in]      bias_dims        Bias dimensions, not used
+ * @param[in]      bias             Bias data pointer, can be NULL
+ * @param[in]      output_dims      Output dimensions, c is the number of neurons
+ * @param[in]      filter_pool_data Lookup table, row input_index * LUT_SIZE, column physical kernel
+ * @param[in]      coeffs           Optional coefficient of every (block, neuron) in the kernel_idx order, can be NULL
+ * @param[out]     output           Output data, input_dims->n vectors of output_dims->c values
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_SIZE_MISMATCH</code> if the
+ *                 accumulation depth is not a multiple of 8
+ */
+arm_status lut_fully_connected_zdim(const cmsis_nn_context *ctx,
+                                    const cmsis_nn_fc_params *fc_params,
+                                    const cmsis_nn_per_channel_quant_params *quant_params,
+                                    const cmsis_nn_dims *input_dims,
+                                    const q7_t *input,
+                                    const cmsis_nn_dims *filter_dims,
+                                    const uint8_t *kernel_idx,
+                                    const cmsis_nn_dims *bias_dims,
+                                    const int32_t *bias,
+                                    const cmsis_nn_dims *output_dims,
+                                    const uint8_t *filter_pool_data,
+                                    const uint8_t *coeffs,
+                                    q7_t *output);
+
+/**
+ * @brief Get the required buffer size for lut_fully_connected_zdim
+ */
+int32_t lut_fully_connected_zdim_get_buffer_size(const cmsis_nn_dims *output_dims);
+
+/**
+ * @brief Fused classifier tail: global average pool, LUT fully connected layer, softmax and top-k
+ * @param[in, out] ctx              Function context, ctx->buf must hold lut_classifier_tail_get_buffer_size() bytes
+ * @param[in]      params           Pooling clamp, FC layer and softmax parameters
+ * @param[in]      input_dims       Last feature map, HWC. c must be a multiple of 8
+ * @param[in]      input            Last feature map
+ * @param[in]      num_classes      Number of FC outputs
+ * @param[in]      filter_pool_data Lookup table, as lut_fully_connected_zdim
+ * @param[in]      k                Number of classes to report, 1 for argmax
+ * @param[out]     top_classes      The k best classes, best first. Ties go to the lower class
+ * @param[out]     top_scores       Their arm_softmax_s8 probabilities, or their logits if params->softmax is 0
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>, <code>ARM_MATH_SIZE_MISMATCH</code> if c is not
+ *                 a multiple of 8 or <code>ARM_MATH_ARGUMENT_ERROR</code> for a bad k or a too small buffer
+ *
+ * @details Same results as arm_avgpool_s8 over the whole map, lut_fully_connected_zdim and arm_softmax_s8, without
+ *          the logit and probability tensors.
+ */
+arm_status lut_classifier_tail(const cmsis_nn_context *ctx,
+                               const lut_tail_params *params,
+                               const cmsis_nn_dims *input_dims,
+                               const q7_t *input,
+                               const int32_t num_classes,
+                               const uint8_t *filter_pool_data,
+                               const int32_t k,
+                               int32_t *top_classes,
+                               q7_t *top_scores);
+
+/**
+ * @brief Get the buffer size in bytes needed by lut_classifier_tail
+ * @details c / 8 * LUT_PREC bytes, independent of the number of classes. The unfused chain needs c + 6 * num_classes
+ *          bytes (pooled vector, logits, probabilities and FC accumulators).
+ */
+int32_t lut_classifier_tail_get_buffer_size(const cmsis_nn_dims *input_dims);
+
+/**
+ * @brief Run output rows [out_row_start, out_row_start + out_rows) of one layer of the layer table
+ * @param[in, out] ctx              Function context, scratch for the layer kernel (see lut_layer_get_buffer_size)
+ * @param[in]      layer            Layer to run
+ * @param[in]      filter_pool_data Lookup table shared by the LUT layers
+ * @param[in]      input_data       Input rows [in_row_start, ...) of the layer, packed back to back in HWC order.
+ *                                  in_row_start must be MAX(0, out_row_start * stride_y - pad_y) and the rows
+ *                                  up to MIN(input_h, (out_row_start + out_rows - 1) * stride_y - pad_y + kernel_y)
+ *                                  must be present.
+ * @param[in]      out_row_start    First output row to compute
+ * @param[in]      out_rows         Number of output rows to compute
+ * @param[out]     output_data      Output rows, packed back to back in HWC order
+ * @return         The function returns the status of the layer kernel
+ *
+ * @details The layer kernel is called on a view of the rows with the vertical padding adjusted, so the
+ *          result is identical to running the full layer and keeping the same rows.
+ */
+arm_status lut_layer_run_rows(const cmsis_nn_context *ctx,
+                              const lut_layer *layer,
+                              const uint8_t *filter_pool_data,
+                              const q7_t *input_data,
+                              const int32_t out_row_start,
+                              const int32_t out_rows,
+                              q7_t *output_data);
+
+/**
+ * @brief Get the first input row needed to compute output row out_row of a layer
+ */
+int32_t lut_layer_input_row_start(const lut_layer *layer, const int32_t out_row);
+
+/**
+ * @brief Get the input row after the last one needed to compute output row out_row of a layer
+ */
+int32_t lut_layer_input_row_end(const lut_layer *layer, const int32_t out_row);
+
+/**
+ * @brief Get the scratch buffer size in bytes needed by lut_layer_run_rows for a layer
+ */
+int32_t lut_layer_get_buffer_size(const lut_layer *layer);
+
+/**
+ * @brief Row-band (depth-first) execution of a weight pool network
+ * @param[in, out] ctx          Function context. ctx->buf must hold lut_network_stream_get_buffer_size() bytes
+ * @param[in]      net          Layer table. The output dimensions of layer i must equal the input dimensions of layer i+1.
+ * @param[in]      input_data   Input of the first layer, can stay in flash
+ * @param[out]     output_data  Full output of the last layer
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>, <code>ARM_MATH_ARGUMENT_ERROR</code> if the
+ *                 buffer is too small or the table is malformed, or the first error reported by a layer kernel
+ *
+ * @details Layer i+1 computes an output row as soon as layer i has produced the kernel_y input rows it needs,
+ *          so each intermediate tensor only lives in a kernel_y row window instead of in full.
+ *          Peak activation memory is the sum of the windows plus the final output.
+ */
+arm_status lut_network_stream_run(const cmsis_nn_context *ctx,
+                                  const lut_network *net,
+                                  const q7_t *input_data,
+                                  q7_t *output_data);
+
+/**
+ * @brief Get the buffer size in bytes needed by lut_network_stream_run
+ */
+int32_t lut_network_stream_get_buffer_size(const lut_network *net);
+
+/**
+ * @brief Start a time-sliced run of a weight pool network, see lut_network_task_step
+ * @param[out]     task         Run state, all of it. The run is complete when lut_network_task_done() is non-zero
+ * @param[in]      ctx          Function context. ctx->buf must hold lut_network_task_get_buffer_size() bytes and stay
+ *                              untouched until the run is complete
+ * @param[in]      net          Layer table. The output dimensions of layer i must equal the input dimensions of layer i+1.
+ * @param[in]      input_data   Input of the first layer
+ * @param[out]     output_data  Output of the last layer
+ * @param[in]      tile_rows    Output rows per tile, the unit of work between two yield points
+ * @param[in]      clock        Cycle counter the budgets are measured with, NULL to give budgets in tiles
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_ARGUMENT_ERROR</code> if the
+ *                 buffer is too small or the table is malformed
+ */
+arm_status lut_network_task_init(lut_network_task *task,
+                                 const cmsis_nn_context *ctx,
+                                 const lut_network *net,
+                                 const q7_t *input_data,
+                                 q7_t *output_data,
+                                 const int32_t tile_rows,
+                                 lut_task_clock clock);
+
+/**
+ * @brief Run tiles of a time-sliced network run until budget_cycles are used
+ * @param[in, out] task           Run state from lut_network_task_init
+ * @param[in]      budget_cycles  Clock cycles (tiles without a clock) this step may use
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or the error of the failing layer
+ *
+ * @details At least one tile is run per step, and a further tile only when the previous tile of the same layer fits
+ *          in the rest of the budget, so a step overruns by at most one tile (task->max_tile_cycles). The output is
+ *          identical to the other network executors whatever the budgets.
+ */
+arm_status lut_network_task_step(lut_network_task *task, const uint32_t budget_cycles);
+
+/**
+ * @brief Non-zero once every tile of a time-sliced run has been computed
+ */
+int32_t lut_network_task_done(const lut_network_task *task);
+
+/**
+ * @brief Get the buffer size in bytes needed by lut_network_task_init
+ */
+int32_t lut_network_task_get_buffer_size(const lut_network *net);
+
+/**
+ * @brief Set up sliding window (streaming) execution of a weight pool network, see lut_network_window_push
+ * @param[out]     win          Window state
+ * @param[in]      ctx          Function context. ctx->buf must hold lut_network_window_get_buffer_size() bytes and is
+ *                              used by the window until it is set up again
+ * @param[in]      net          Layer table, at most LUT_WINDOW_MAX_LAYERS layers. The output dimensions of layer i must
+ *                              equal the input dimensions of layer i+1.
+ * @param[in]      hop          Input rows per frame. Must be a multiple of the product of the vertical strides of the
+ *                              layers before any fully connected layer.
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_ARGUMENT_ERROR</code> if the
+ *                 buffer is too small, the table is malformed or the hop does not fit the strides
+ *
+ * @details The input window starts as zero rows.
+ */
+arm_status lut_network_window_init(lut_network_window *win,
+                                   const cmsis_nn_context *ctx,
+                                   const lut_network *net,
+                                   const int32_t hop);
+
+/**
+ * @brief Slide the window by one frame and update the network output
+ * @param[in, out] win          Window state from lut_network_window_init
+ * @param[in]      frame        hop new input rows, appended at the bottom of the window (HWC order)
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or the error of the failing layer
+ *
+ * @details Only the output rows that do not reappear unchanged from the previous window are computed: the rows
+ *          depending on the new frame and the rows next to the padded edges. The result is identical to running the
+ *          whole network on the current window (lut_network_window_output).
+ */
+arm_status lut_network_window_push(lut_network_window *win, const q7_t *frame);
+
+/**
+ * @brief Output of the last layer for the current window
+ */
+const q7_t *lut_network_window_output(const lut_network_window *win);
+
+/**
+ * @brief Get the buffer size in bytes needed by lut_network_window_init
+ */
+int32_t lut_network_window_get_buffer_size(const lut_network *net);
+
+#if defined(LUT_HOST_THREADS)
+/**
+ * @brief Create the worker pool of the multi-threaded host backend
+ * @param[in]   num_threads   Number of worker threads
+ * @return      The pool, or NULL if the threads could not be created
+ */
+lut_thread_pool *lut_thread_pool_create(const int32_t num_threads);
+
+/**
+ * @brief Stop the workers and release the pool
+ */
+void lut_thread_pool_destroy(lut_thread_pool *pool);
+
+/**
+ * @brief Get the number of workers of a pool
+ */
+int32_t lut_thread_pool_size(const lut_thread_pool *pool);
+
+/**
+ * @brief Run one layer with its output rows split across the workers of a pool
+ * @param[in, out] ctx              Function context, ctx->buf holds the scratch of every worker
+ *                                  (see lut_layer_parallel_get_buffer_size)
+ * @param[in]      pool             Worker pool
+ * @param[in]      layer            Layer to run
+ * @param[in]      filter_pool_data Lookup table shared by the LUT layers
+ * @param[in]      input_data       Full input of the layer
+ * @param[out]     output_data      Full output of the layer
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>, <code>ARM_MATH_ARGUMENT_ERROR</code> if the
+ *                 buffer is too small, or the error of the first failing band
+ *
+ * @details Each worker computes a contiguous band of output rows with lut_layer_run_rows. The output is
+ *          identical to the single-threaded kernels whatever the number of workers.
+ */
+arm_status lut_layer_run_parallel(const cmsis_nn_context *ctx,
+                                  lut_thread_pool *pool,
+                                  const lut_layer *layer,
+                                  const uint8_t *filter_pool_data,
+                                  const q7_t *input_data,
+                                  q7_t *output_data);
+
+/**
+ * @brief Get the buffer size in bytes needed by lut_layer_run_parallel
+ */
+int32_t lut_layer_parallel_get_buffer_size(const lut_layer *layer, const int32_t num_threads);
+
+/**
+ * @brief Run a weight pool network layer by layer, every layer split across the workers of a pool
+ * @param[in, out] ctx          Function context. ctx->buf must hold lut_network_parallel_get_buffer_size() bytes
+ * @param[in]      pool         Worker pool
+ * @param[in]      net          Layer table
+ * @param[in]      input_data   Input of the first layer
+ * @param[out]     output_data  Output of the last layer
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>, <code>ARM_MATH_ARGUMENT_ERROR</code> if the
+ *                 buffer is too small or the table is malformed, or the first error reported by a layer
+ */
+arm_status lut_network_run_parallel(const cmsis_nn_context *ctx,
+                                    lut_thread_pool *pool,
+                                    const lut_network *net,
+                                    const q7_t *input_data,
+                                    q7_t *output_data);
+
+/**
+ * @brief Get the buffer size in bytes needed by lut_network_run_parallel
+ */
+int32_t lut_network_parallel_get_buffer_size(const lut_network *net, const int32_t num_threads);
+#endif // LUT_HOST_THREADS
+
+/**
+ * @brief Build the layer table of a binary weight pool model (written by Runtime/model_pack.py)
+ * @param[in]   model       Start of the model, 4-byte aligned. A mapped file on the host or a flash address on the MCU
+ * @param[in]   size        Size of the model in bytes
+ * @param[in]   check_crc   Non-zero to verify the CRC-32 of the model
+ * @param[out]  layers      Layer table, at least lut_model_get_num_layers() entries
+ * @param[in]   max_layers  Number of entries of layers
+ * @param[out]  net         Network using layers and the lookup table of the model
+ * @return      The function returns <code>ARM_MATH_SUCCESS</code>, <code>ARM_MATH_SIZE_MISMATCH</code> if the model
+ *              has more layers than max_layers or a LUT width other than LUT_SIZE, or
+ *              <code>ARM_MATH_ARGUMENT_ERROR</code> if the model is malformed or the checksum does not match
+ *
+ * @details Zero-copy: every pointer of the table points into the model, which must stay valid while it is used.
+ */
+arm_status lut_model_load(const uint8_t *model,
+                          const int32_t size,
+                          const int32_t check_crc,
+                          lut_layer *layers,
+                          const int32_t max_layers,
+                          lut_network *net);
+
+/**
+ * @brief Get the number of layers of a binary weight pool model
+ * @param[in]   model       Start of the model, 4-byte aligned
+ * @param[in]   size        Size of the model in bytes
+ * @return      Number of layers, 0 if the blob is smaller than the header, not aligned or not a model
+ */
+int32_t lut_model_get_num_layers(const uint8_t *model, const int32_t size);
+
+#if defined(LUT_HOST_MMAP)
+/**
+ * @brief Map a binary weight pool model file read-only (host only)
+ * @param[in]   path    Model file
+ * @param[out]  model   Start of the mapping
+ * @param[out]  size    Size of the file
+ * @return      The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_ARGUMENT_ERROR</code> if the file
+ *              cannot be opened or mapped
+ */
+arm_status lut_model_map(const char *path, const uint8_t **model, int32_t *size);
+
+/**
+ * @brief Unmap a model mapped with lut_model_map
+ */
+void lut_model_unmap(const uint8_t *model, const int32_t size);
+#endif // LUT_HOST_MMAP
+
+/**
+ * @brief Size in bytes of a synthesized lookup table, 256 * LUT_SIZE
+ */
+int32_t lut_synth_get_buffer_size(void);
+
+/**
+ * @brief Synthesize columns of the lookup table from the pool vectors
+ * @param[in]      pool  Pool vectors and entry requantization
+ * @param[in]      used  pool->pool_size flags, only the columns of non-zero flags are written. NULL for all
+ * @param[out]     lut   Lookup table (SRAM), lut_synth_get_buffer_size() bytes, other columns are left as they are
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code> or <code>ARM_MATH_SIZE_MISMATCH</code> if the
+ *                 pool has more than LUT_SIZE vectors
+ */
+arm_status lut_synth_columns(const lut_pool_vectors *pool, const uint8_t *used, uint8_t *lut);
+
+/**
+ * @brief Synthesize the columns referenced by the index array of one layer, e.g. at layer start
+ * @param[in]      layer    Layer, no LUT column is needed for CONV_S8 and MAX_POOL_S8 layers
+ * @param[in]      pool     Pool vectors and entry requantization
+ * @param[out]     lut      Lookup table (SRAM), lut_synth_get_buffer_size() bytes
+ * @param[out]     columns  Number of columns built, optional
+ * @return         The function returns <code>ARM_MATH_SUCCESS</code>, <code>ARM_MATH_SIZE_MISMATCH</code> or
+ *                 <code>ARM_MATH_ARGUMENT_ERROR</code> for an index outside the pool
+ */
+arm_status lut_synth_layer(const lut_layer *layer, const lut_pool_vectors *pool, uint8_t *lut, int32_t *columns);
+
+/**
+ * @brief Synthesize the columns referenced by any layer of a network at model load and use them as its LUT
+ * @param[in, out] net      Network, filter_pool_data is set to lut on success
+ * @param[in]      pool     Pool vectors and entry requantization
+ * @param[out]     lut      Lookup table (SRAM), lut_synth_get_buffer_size() bytes, must stay valid while net is run
+ * @param[out]     columns  Number of columns built, optional
+ * @return         As lut_synth_layer
+ */
+arm_status lut_synth_network(lut_network *net, const lut_pool_vectors *pool, uint8_t *lut, int32_t *columns);
+
 #ifdef __cplusplus
 }
 #endif
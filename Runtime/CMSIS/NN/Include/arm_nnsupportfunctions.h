@@ -32,8 +32,9 @@
 
 //#include "arm_common_tables.h"
 //#include "arm_math_types.h"
-#include "..\..\DSP\Include\arm_common_tables.h"
-#include "..\..\DSP\Include\arm_math_types.h"
+#include "../../DSP/Include/arm_common_tables.h"
+#include "../../DSP/Include/arm_math_types.h"
+#include "arm_nn_types.h"
 
 
 #ifdef __cplusplus
@@ -50,6 +51,16 @@ extern "C" {
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #define CLAMP(x, h, l) MAX(MIN((x), (h)), (l))
 
+/* Weight pool (LUT) kernel configuration, shared by every lut_* source. LUT_SIZE and LUT_PREC can be set on the
+   command line (-DLUT_SIZE=64 for the 64-wide pools of lut_zdim64_data.h), all LUT sources must use the same values */
+#ifndef LUT_SIZE
+#define LUT_SIZE 32 /* Number of kernels in the pool, columns of a LUT row */
+#endif
+#ifndef LUT_PREC
+#define LUT_PREC 5 /* Activation precision, number of bit planes */
+#endif
+#define FW_GRAN 8 /* Input channels per pool kernel, an 8-bit row index per bit plane */
+
 /**
  * @brief Union for SIMD access of q31/q15/q7 types
  */
@@ -801,6 +812,153 @@ __STATIC_FORCEINLINE q31_t arm_nn_requantize(const q31_t val, const q31_t multip
                                          RIGHT_SHIFT(shift));
 }
 
+/**
+ * @brief           Bit-plane index generation of the weight pool (LUT) kernels
+ * @param[in]       in            Block of 8 consecutive input values
+ * @param[in]       input_offset  Offset added to every input value
+ * @param[in]       prec          Number of bit planes to generate
+ * @param[out]      index         prec row indices of the lookup table, bit j of index[b] is bit b of input j
+ *
+ * @details         Shared by the LUT convolution and fully connected kernels so that they address the
+ *                  same lookup table layout: row index[b] * LUT_SIZE, column physical kernel.
+ */
+__STATIC_FORCEINLINE void lut_nn_bitplane_index(const q7_t *in, const int32_t input_offset, const int32_t prec, uint16_t *index)
+{
+    for (int32_t b = 0; b < prec; b++)
+    {
+        index[b] = 0;
+    }
+    for (int32_t j = 0; j < 8; j++)
+    {
+        const uint8_t val = (uint8_t)(in[j] + input_offset);
+        for (int32_t b = 0; b < prec; b++)
+        {
+            index[b] |= ((val >> b) & 1) << j;
+        }
+    }
+}
+
+/**
+ * @brief           Read value i of a packed n-bit activation tensor (lut_pack_params)
+ * @return          The stored value, offset included
+ */
+__STATIC_FORCEINLINE uint8_t lut_nn_packed_get(const uint8_t *packed, const int32_t i, const int32_t bits)
+{
+    const int32_t bit = i * bits;
+    return (uint8_t)((packed[bit >> 3] >> (bit & 7)) & ((1 << bits) - 1));
+}
+
+/**
+ * @brief           Write value i of a packed n-bit activation tensor, the other values of the byte are kept
+ */
+__STATIC_FORCEINLINE void lut_nn_packed_set(uint8_t *packed, const int32_t i, const int32_t bits, const uint8_t value)
+{
+    const int32_t bit = i * bits;
+    const uint8_t mask = (uint8_t)(((1 << bits) - 1) << (bit & 7));
+    packed[bit >> 3] = (uint8_t)((packed[bit >> 3] & ~mask) | ((value << (bit & 7)) & mask));
+}
+
+/**
+ * @brief           Bit-plane index generation with the precision of the block
+ * @param[in]       in            Block of 8 consecutive input values
+ * @param[in]       input_offset  Offset added to every input value
+ * @param[in]       max_prec      Number of bit planes of the kernel (LUT_PREC)
+ * @param[out]      index         Row indices of the lookup table, see lut_nn_bitplane_index
+ * @return          Number of planes written: the highest set bit of the block + 1, 0 for an all zero block
+ *
+ * @details         The precision is found with a count leading zeros on the OR of the 8 values (masked to
+ *                  max_prec bits), the planes above it would all have index 0 and are not generated.
+ */
+__STATIC_FORCEINLINE int32_t lut_nn_bitplane_index_dynamic(const q7_t *in, const int32_t input_offset, const int32_t max_prec, uint16_t *index)
+{
+    uint8_t val[8];
+    uint32_t any = 0;
+    for (int32_t j = 0; j < 8; j++)
+    {
+        val[j] = (uint8_t)(in[j] + input_offset);
+        any |= val[j];
+    }
+    const int32_t prec = 32 - __CLZ(any & ((1U << max_prec) - 1));
+    for (int32_t b = 0; b < prec; b++)
+    {
+        index[b] = 0;
+    }
+    for (int32_t j = 0; j < 8; j++)
+    {
+        for (int32_t b = 0; b < prec; b++)
+        {
+            index[b] |= ((val[j] >> b) & 1) << j;
+        }
+    }
+    return prec;
+}
+
+/**
+ * @brief           Row lookup through a lut_row_cache
+ * @param[in, out]  cache   Row cache, see lut_row_cache_init
+ * @param[in]       row     Row index of the lookup table, from lut_nn_bitplane_index
+ * @param[out]      spill   row_size bytes used when the row cannot be cached
+ * @return          Pointer to the row, valid until the next lut_row_cache_next_block
+ *
+ * @details         A miss copies the row from the LUT into the least recently used way of its set. Ways used by
+ *                  the current block or pinned by lut_row_cache_warm are never replaced, the row is then copied
+ *                  into spill instead, so all rows returned for one block stay valid together.
+ */
+__STATIC_FORCEINLINE const uint8_t *lut_row_cache_fetch(lut_row_cache *cache, const uint16_t row, uint8_t *spill)
+{
+    if (cache->row_count)
+    {
+        cache->row_count[row]++;
+    }
+    int32_t slot = (row & (cache->sets - 1)) * cache->ways;
+    int32_t victim = slot;
+    for (int32_t way = 0; way < cache->ways; way++, slot++)
+    {
+        if (cache->tags[slot] == row)
+        {
+            cache->hits++;
+            if (cache->stamps[slot] != LUT_ROW_CACHE_PINNED)
+            {
+                cache->stamps[slot] = cache->epoch;
+            }
+            return cache->rows + slot * cache->row_size;
+        }
+        if (cache->stamps[slot] < cache->stamps[victim])
+        {
+            victim = slot;
+        }
+    }
+    cache->misses++;
+    uint8_t *dst = spill;
+    if (cache->stamps[victim] < cache->epoch)
+    {
+        dst = cache->rows + victim * cache->row_size;
+        cache->tags[victim] = row;
+        cache->stamps[victim] = cache->epoch;
+    }
+    memcpy(dst, cache->lut + row * cache->row_size, cache->row_size);
+    return dst;
+}
+
+/**
+ * @brief           Start a new block of lut_row_cache_fetch calls, the rows of the previous block can be replaced
+ */
+__STATIC_FORCEINLINE void lut_row_cache_next_block(lut_row_cache *cache)
+{
+    if (++cache->epoch == LUT_ROW_CACHE_PINNED)
+    {
+        //wrap around: forget the ages, pinned rows stay pinned
+        for (int32_t s = 0; s < cache->sets * cache->ways; s++)
+        {
+            if (cache->stamps[s] != LUT_ROW_CACHE_PINNED)
+            {
+                cache->stamps[s] = 0;
+            }
+        }
+        cache->epoch = 1;
+    }
+}
+
 /**
  * @brief           memcpy optimized for MVE
  * @param[in, out]  dst         Destination pointer
@@ -0,0 +1,56 @@
+/*
+arm_elementwise_add_s8 on packed n-bit activations (lut_pack_params), e.g. the residual adds between LUT layers.
+The inputs are unpacked in small chunks on the stack, added with arm_elementwise_add_s8 and packed again, so the
+results are the ones of the q7 add and no full size q7 tensor is needed.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_ADD_CHUNK 64 //values per chunk, a multiple of 8 keeps every chunk on a byte boundary
+
+arm_status lut_elementwise_add_packed(const uint8_t *input_1_vect,
+                                      const lut_pack_params *input_1_pack,
+                                      const uint8_t *input_2_vect,
+                                      const lut_pack_params *input_2_pack,
+                                      const int32_t input_1_offset,
+                                      const int32_t input_1_mult,
+                                      const int32_t input_1_shift,
+                                      const int32_t input_2_offset,
+                                      const int32_t input_2_mult,
+                                      const int32_t input_2_shift,
+                                      const int32_t left_shift,
+                                      uint8_t *output,
+                                      const lut_pack_params *output_pack,
+                                      const int32_t out_offset,
+                                      const int32_t out_mult,
+                                      const int32_t out_shift,
+                                      const int32_t out_activation_min,
+                                      const int32_t out_activation_max,
+                                      const uint32_t block_size)
+{
+  q7_t in_1[LUT_ADD_CHUNK];
+  q7_t in_2[LUT_ADD_CHUNK];
+  q7_t out[LUT_ADD_CHUNK];
+
+  for (uint32_t start = 0; start < block_size; start += LUT_ADD_CHUNK)
+  {
+    const int32_t count = (int32_t)MIN(block_size - start, LUT_ADD_CHUNK);
+    const int32_t in_1_byte = start * input_1_pack->bits / 8;
+    const int32_t in_2_byte = start * input_2_pack->bits / 8;
+    const int32_t out_byte = start * output_pack->bits / 8;
+    arm_status status = lut_unpack_s8(input_1_vect + in_1_byte, count, input_1_pack, in_1);
+    status |= lut_unpack_s8(input_2_vect + in_2_byte, count, input_2_pack, in_2);
+    if (status != ARM_MATH_SUCCESS)
+    {
+      return ARM_MATH_ARGUMENT_ERROR;
+    }
+    arm_elementwise_add_s8(in_1, in_2, input_1_offset, input_1_mult, input_1_shift, input_2_offset, input_2_mult,
+                           input_2_shift, left_shift, out, out_offset, out_mult, out_shift, out_activation_min,
+                           out_activation_max, count);
+    if (lut_pack_s8(out, count, output_pack, output + out_byte) != ARM_MATH_SUCCESS)
+    {
+      return ARM_MATH_ARGUMENT_ERROR;
+    }
+  }
+  return ARM_MATH_SUCCESS;
+}
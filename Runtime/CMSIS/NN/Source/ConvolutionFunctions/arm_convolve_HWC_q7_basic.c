@@ -28,10 +28,8 @@
  *
  * -------------------------------------------------------------------- */
 
-//#include "arm_nnfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnfunctions.h"
-//#include "arm_nnsupportfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnsupportfunctions.h"
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
 
 /**
  *  @ingroup groupNN
@@ -29,8 +29,7 @@
  *
  * -------------------------------------------------------------------- */
 
-//#include "arm_nnfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnfunctions.h"
+#include "arm_nnfunctions.h"
 
 
 /**
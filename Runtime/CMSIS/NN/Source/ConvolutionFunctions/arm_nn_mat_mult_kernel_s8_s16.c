@@ -27,10 +27,8 @@
  * Target Processor:  Cortex-M cores
  * -------------------------------------------------------------------- */
 
-//#include "arm_nnfunctions.h"
-//#include "arm_nnsupportfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnsupportfunctions.h"
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
 
 /*
  * Matrix-multiplication function for convolution with per-channel requantization.
@@ -8,16 +8,40 @@ Need also to find a way to check whether the indexing logic is correctly impleme
 In this implementation, the normalization factor is no longer for each channel, now it's for each 8-wide weight 
 cluster along the z dimension. 
 */
-#include "..\..\Include\arm_nnfunctions.h"
-#include "..\..\Include\arm_nnsupportfunctions.h"
+#include "../../Include/arm_nnfunctions.h"
+#include "../../Include/arm_nnsupportfunctions.h"
+#include <stdlib.h>
 
-#define LUT_PREC 5  
-#define LUT_SIZE 32
+//LUT_PREC, LUT_SIZE and FW_GRAN are defined in arm_nnsupportfunctions.h
 #define LUT_EFFECTIVE_SIZE LUT_SIZE //just for faster debugging and testing, should not be used in actual runtime benchmark
-#define FW_GRAN 8 //granularity of fixed weight, should be power of 2 for better efficiency
-//Define some macros to get and set bit for index generation
-#define GETBIT(var, bit)	(((var) >> (bit)) & 1)
-#define SETBIT(var, bit)	var |= (1 << (bit))
+//index generation is shared with the LUT fully connected kernel, see lut_nn_bitplane_index
+#define LUT_BATCH_TILE 8 //number of images processed together by lut_conv_zdim_v2_batch
+#define LUT_PW_PIXELS 4 //pixels sharing every kernel index fetch in lut_conv_zdim_v*_pointwise
+#define LUT_ROW_CNT (1 << FW_GRAN) //number of rows in filter_pool_data, one per 8-bit index
+
+int32_t lut_conv_zdim_get_buffer_size(const cmsis_nn_dims *output_dims)
+{
+  //one 16-bit accumulator per output channel, shared by all lut_conv_zdim_* kernels
+  return output_dims->c * (int32_t)sizeof(int16_t);
+}
+
+int32_t lut_conv_zdim_coeff_get_buffer_size(const cmsis_nn_dims *output_dims)
+{
+  //32-bit accumulators, the scaled block results overflow the 16-bit holder
+  return output_dims->c * (int32_t)sizeof(int32_t);
+}
+
+int32_t lut_conv_zdim_batch_get_buffer_size(const cmsis_nn_dims *input_dims, const cmsis_nn_dims *output_dims)
+{
+  //one accumulator vector per image of a batch tile
+  return MIN(input_dims->n, LUT_BATCH_TILE) * lut_conv_zdim_get_buffer_size(output_dims);
+}
+
+int32_t lut_conv_zdim_pointwise_get_buffer_size(const cmsis_nn_dims *output_dims)
+{
+  //one accumulator vector per pixel of a tile
+  return LUT_PW_PIXELS * lut_conv_zdim_get_buffer_size(output_dims);
+}
 
 arm_status lut_conv_zdim_v1(const cmsis_nn_context *ctx,
                            const cmsis_nn_conv_params *conv_params,
@@ -57,10 +81,17 @@ arm_status lut_conv_zdim_v1(const cmsis_nn_context *ctx,
   int32_t *output_mult = quant_params->multiplier;
   int32_t *output_shift = quant_params->shift;
   char* result_ptr;
-  char input_tmp, extracted_bit;
 
   uint16_t input_index[LUT_PREC] = {0};
-  int16_t* conv_out_holder = malloc(output_ch*sizeof(int16_t));
+  //take the accumulator holder from the context buffer when the caller provides one, so that calling the kernel
+  //repeatedly (e.g. on row bands) doesn't need a heap allocation per call
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
   //static int16_t conv_out_holder[128];
 
   int i_batch;
@@ -68,7 +99,7 @@ arm_status lut_conv_zdim_v1(const cmsis_nn_context *ctx,
   {
       /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
       (void)buffer_a;
-      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, j_input_ch;
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x;
       int32_t conv_out, logical_kernel_idx, result_idx, block_cnt;//block_cnt is a counter to count the number of 8-wide weight blocks processed
       int16_t partial_sum;
       uint8_t physical_kernel_idx;
@@ -103,22 +134,8 @@ arm_status lut_conv_zdim_v1(const cmsis_nn_context *ctx,
 
                   for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN)
                   {
-                    int kernel_pixel_cnt = 0;
-                    //index generation, outer loop is for input pixels, and inner loop is for 8 index
-                    
-                    for (j_input_ch = i_input_ch; j_input_ch < i_input_ch + FW_GRAN; j_input_ch++)
-                    {
-                      //loop through the channels of a single pixel to generate the index to the kernel pool   
-
-                      input_tmp = input_data[(in_row * input_x + in_col) * input_ch + j_input_ch] + input_offset;
-                      for (int i = 0; i < LUT_PREC; i++){
-                        extracted_bit = GETBIT(input_tmp, i);
-                        if(extracted_bit){
-                          SETBIT(input_index[i], kernel_pixel_cnt);//set the bit if extracted is 1
-                        }
-                      }  
-                      kernel_pixel_cnt++;
-                    }
+                    //index generation, one index per bit plane of the 8 input channels of the block
+                    lut_nn_bitplane_index(input_data + (in_row * input_x + in_col) * input_ch + i_input_ch, input_offset, LUT_PREC, input_index);
                     //copy the corresponding lut block of each bit from flash to ram
                     //The overhead of this memcopy will be compenstated by sharing it across all filters
                     for(int bit = 0; bit < LUT_PREC; bit++){
@@ -163,13 +180,197 @@ arm_status lut_conv_zdim_v1(const cmsis_nn_context *ctx,
       input_data += (input_x * input_y * input_ch);
       output_data += (output_x * output_y * output_ch);
     }
-    //free(conv_out_holder);
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
 
     /* Return to application */
     
     return ARM_MATH_SUCCESS;
 }
 
+/*
+Batch-interleaved version of lut_conv_zdim_v2_double_lookup.
+Up to LUT_BATCH_TILE images are processed together at each (pixel, block) position. Every image copies its LUT rows
+and combines its bit planes into result_mem as in v2, then the kernel indices of the block are read once and each one
+serves the whole tile. The accumulators are stored filter major, [output_ch][tile], so the images of a filter are
+contiguous; a full tile runs a constant length loop that the compiler can unroll or vectorise.
+Each image keeps its own accumulators, so the results are identical to calling lut_conv_zdim_v2_double_lookup per image.
+*/
+static inline void lut_conv_zdim_batch_accumulate(int16_t* conv_out_holder,
+                                                  const int16_t result_mem[LUT_SIZE][LUT_BATCH_TILE],
+                                                  const uint8_t* block_idx,
+                                                  const int32_t output_ch,
+                                                  const int32_t tile)
+{
+  if (tile == LUT_BATCH_TILE)
+  {
+    for (int32_t i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+    {
+      const int16_t* result = result_mem[block_idx[i_out_ch]];
+      int16_t* holder = conv_out_holder + i_out_ch*LUT_BATCH_TILE;
+      for (int32_t b = 0; b < LUT_BATCH_TILE; b++)
+      {
+        holder[b] += result[b];
+      }
+    }
+    return;
+  }
+  for (int32_t i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+  {
+    const int16_t* result = result_mem[block_idx[i_out_ch]];
+    int16_t* holder = conv_out_holder + i_out_ch*tile;
+    for (int32_t b = 0; b < tile; b++)
+    {
+      holder[b] += result[b];
+    }
+  }
+}
+
+arm_status lut_conv_zdim_v2_batch(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data)
+{
+  //a single image has nothing to share, the interleaved layout would only add overhead
+  if (input_dims->n == 1)
+  {
+    return lut_conv_zdim_v2_double_lookup(ctx, conv_params, quant_params, input_dims, input_data, filter_dims,
+                                          kernel_idx, bias_dims, bias_data, output_dims, filter_pool_data, output_data);
+  }
+  (void)bias_dims;
+
+  const uint16_t input_batches = input_dims->n;
+  const uint16_t input_x = input_dims->w;
+  const uint16_t input_y = input_dims->h;
+  const uint16_t input_ch = input_dims->c;
+  const uint16_t kernel_x = filter_dims->w;
+  const uint16_t kernel_y = filter_dims->h;
+  const uint16_t output_x = output_dims->w;
+  const uint16_t output_y = output_dims->h;
+  const uint16_t output_ch = output_dims->c;
+
+  const uint16_t pad_x = conv_params->padding.w;
+  const uint16_t pad_y = conv_params->padding.h;
+  const uint16_t stride_x = conv_params->stride.w;
+  const uint16_t stride_y = conv_params->stride.h;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+  const int32_t image_in_size = input_x * input_y * input_ch;
+  const int32_t image_out_size = output_x * output_y * output_ch;
+
+  const int32_t holder_size = lut_conv_zdim_batch_get_buffer_size(input_dims, output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  uint8_t lut_buffer[LUT_PREC*LUT_SIZE];
+  int16_t result_mem[LUT_SIZE][LUT_BATCH_TILE];//result of every physical kernel for every image of the tile
+
+  int32_t i_batch;
+  for (i_batch = 0; i_batch < input_batches; i_batch += LUT_BATCH_TILE)
+  {
+      const int32_t tile = MIN(LUT_BATCH_TILE, input_batches - i_batch);
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, i_phy_ft, b;
+      int32_t block_cnt;
+      int16_t partial_sum;
+
+      for (i_out_y = 0; i_out_y < output_y; i_out_y++)
+      {
+          for (i_out_x = 0; i_out_x < output_x; i_out_x++)
+          {
+              block_cnt = 0;
+              memset(conv_out_holder, 0, tile*output_ch*sizeof(int16_t));
+
+              const int32_t base_idx_y = stride_y * i_out_y - pad_y;
+              const int32_t base_idx_x = stride_x * i_out_x - pad_x;
+
+              const int32_t ker_y_start = MAX(0, -base_idx_y);
+              const int32_t ker_x_start = MAX(0, -base_idx_x);
+
+              const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+              const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+
+              for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
+              {
+                for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
+                {
+                  const int32_t in_row = base_idx_y + i_ker_y;
+                  const int32_t in_col = base_idx_x + i_ker_x;
+                  const q7_t* pixel = input_data + i_batch * image_in_size + (in_row * input_x + in_col) * input_ch;
+
+                  for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN)
+                  {
+                    //the v2 row copy and bit plane combination, once per image of the tile
+                    for (b = 0; b < tile; b++)
+                    {
+                      uint16_t input_index[LUT_PREC];
+                      lut_nn_bitplane_index(pixel + b * image_in_size + i_input_ch, input_offset, LUT_PREC, input_index);
+                      for(int bit = 0; bit < LUT_PREC; bit++){
+                        memcpy(lut_buffer + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                      }
+                      for (i_phy_ft = 0; i_phy_ft < LUT_SIZE; i_phy_ft++)
+                      {
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + i_phy_ft])<<bit);
+                        }
+                        result_mem[i_phy_ft][b] = partial_sum;
+                      }
+                    }
+                    //the kernel indices of this block are read from flash once and reused by every image of the tile
+                    lut_conv_zdim_batch_accumulate(conv_out_holder, (const int16_t (*)[LUT_BATCH_TILE])result_mem,
+                                                   kernel_idx + output_ch * block_cnt, output_ch, tile);
+                    block_cnt++;
+                  }
+                }
+              }
+              for (b = 0; b < tile; b++)
+              {
+                q7_t* out = output_data + (i_batch + b) * image_out_size + (i_out_y * output_x + i_out_x) * output_ch;
+                for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                {
+                  int16_t holder = conv_out_holder[i_out_ch*tile + b];
+                  if (bias_data)
+                  {
+                      holder += bias_data[i_out_ch];
+                  }
+                  holder = arm_nn_requantize(holder, output_mult[i_out_ch], output_shift[i_out_ch]);
+                  holder += out_offset;
+                  holder = MAX(holder, out_activation_min);
+                  holder = MIN(holder, out_activation_max);
+                  out[i_out_ch] = (int8_t)holder;
+                }
+              }
+          }
+      }
+    }
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
 arm_status lut_conv_zdim_v2_double_lookup(const cmsis_nn_context *ctx,
                            const cmsis_nn_conv_params *conv_params,
                            const cmsis_nn_per_channel_quant_params *quant_params,
@@ -208,10 +409,17 @@ arm_status lut_conv_zdim_v2_double_lookup(const cmsis_nn_context *ctx,
   int32_t *output_mult = quant_params->multiplier;
   int32_t *output_shift = quant_params->shift;
   char* result_ptr;
-  char input_tmp, extracted_bit;
 
   uint16_t input_index[LUT_PREC] = {0};
-  int16_t* conv_out_holder = malloc(output_ch*sizeof(int16_t));
+  //take the accumulator holder from the context buffer when the caller provides one, so that calling the kernel
+  //repeatedly (e.g. on row bands) doesn't need a heap allocation per call
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
   //static int16_t conv_out_holder[128];
 
   int i_batch;
@@ -219,7 +427,7 @@ arm_status lut_conv_zdim_v2_double_lookup(const cmsis_nn_context *ctx,
   {
       /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
       (void)buffer_a;
-      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, j_input_ch, i_phy_ft;
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, i_phy_ft;
       int32_t conv_out, logical_kernel_idx, result_idx, block_cnt;//block_cnt is a counter to count the number of 8-wide weight blocks processed
       int16_t partial_sum;
       uint8_t physical_kernel_idx;
@@ -255,22 +463,9 @@ arm_status lut_conv_zdim_v2_double_lookup(const cmsis_nn_context *ctx,
 
                   for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN)
                   {
-                    int kernel_pixel_cnt = 0;
-                    //index generation, outer loop is for input pixels, and inner loop is for 8 index
                     uint16_t result_mem[LUT_SIZE] = {0};//array to hold temporary filter results
-                    for (j_input_ch = i_input_ch; j_input_ch < i_input_ch + FW_GRAN; j_input_ch++)
-                    {
-                      //loop through the channels of a single pixel to generate the index to the kernel pool   
-
-                      input_tmp = input_data[(in_row * input_x + in_col) * input_ch + j_input_ch] + input_offset;
-                      for (int i = 0; i < LUT_PREC; i++){
-                        extracted_bit = GETBIT(input_tmp, i);
-                        if(extracted_bit){
-                          SETBIT(input_index[i], kernel_pixel_cnt);//set the bit if extracted is 1
-                        }
-                      }  
-                      kernel_pixel_cnt++;
-                    }
+                    //index generation, one index per bit plane of the 8 input channels of the block
+                    lut_nn_bitplane_index(input_data + (in_row * input_x + in_col) * input_ch + i_input_ch, input_offset, LUT_PREC, input_index);
                     //copy the corresponding lut block of each bit from flash to ram
                     //For the memorization version, the overhead of this memcpy cannot be shared across all filters, but is shared across all physical filters (LUT size)
                     for(int bit = 0; bit < LUT_PREC; bit++){ 
@@ -323,31 +518,38 @@ arm_status lut_conv_zdim_v2_double_lookup(const cmsis_nn_context *ctx,
       input_data += (input_x * input_y * input_ch);
       output_data += (output_x * output_y * output_ch);
     }
-    //free(conv_out_holder);
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
 
     /* Return to application */
     return ARM_MATH_SUCCESS;
 }
 
-
-
-arm_status lut_conv_zdim_v5_fusedpooling(const cmsis_nn_context *ctx,
+/*
+lut_conv_zdim_v1 and lut_conv_zdim_v2_double_lookup reading the LUT rows through a lut_row_cache instead of copying
+them from flash for every block. Hits are read in place from the cache, misses are copied from flash once (into the
+cache, or into lut_buffer when the set is busy). The results are identical to the uncached kernels.
+*/
+static inline arm_status lut_conv_zdim_cached_core(const cmsis_nn_context *ctx,
                            const cmsis_nn_conv_params *conv_params,
                            const cmsis_nn_per_channel_quant_params *quant_params,
                            const cmsis_nn_dims *input_dims,
                            const q7_t *input_data,
                            const cmsis_nn_dims *filter_dims,
                            const uint8_t* kernel_idx,
-                           const cmsis_nn_dims *bias_dims,
                            const int32_t *bias_data,
                            const cmsis_nn_dims *output_dims,
                            const uint8_t* filter_pool_data,
+                           lut_row_cache *cache,
+                           const int32_t double_lookup,
                            q7_t *output_data)
 {
-  //this version implements fused batchnorm, relu and pooling, so that the activation memory can be reduced. (especially for first layer)
-  (void)bias_dims;
-  q15_t *buffer_a = (q15_t *)ctx->buf;
-
+  if (cache->lut != filter_pool_data || cache->row_size != LUT_SIZE)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
   const uint16_t input_batches = input_dims->n;
   const uint16_t input_x = input_dims->w;
   const uint16_t input_y = input_dims->h;
@@ -369,100 +571,97 @@ arm_status lut_conv_zdim_v5_fusedpooling(const cmsis_nn_context *ctx,
   const int32_t out_activation_max = conv_params->activation.max;
   int32_t *output_mult = quant_params->multiplier;
   int32_t *output_shift = quant_params->shift;
-  char* result_ptr;
-  char input_tmp, extracted_bit;
 
-  uint16_t input_index[LUT_PREC] = {0};
-  int16_t* conv_out_holder = malloc(output_ch*sizeof(int16_t));
-  //static int16_t conv_out_holder[128];
+  uint16_t input_index[LUT_PREC];
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
 
   int i_batch;
   for (i_batch = 0; i_batch < input_batches; i_batch++)
   {
-      /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
-      (void)buffer_a;
-      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, j_input_ch;
-      int32_t conv_out, logical_kernel_idx, result_idx, block_cnt;//block_cnt is a counter to count the number of 8-wide weight blocks processed
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, i_phy_ft;
+      int32_t logical_kernel_idx, block_cnt;
       int16_t partial_sum;
-      uint8_t physical_kernel_idx;
 
       for (i_out_y = 0; i_out_y < output_y; i_out_y++)
       {
           for (i_out_x = 0; i_out_x < output_x; i_out_x++)
-          {   
-              block_cnt = 0;//initialize and reset the block counter
-              //conv_out = 0;
-              //int16_t conv_out_holder[output_ch]; //initialize the conv result holder, one for each filter
-              memset(conv_out_holder, 0, output_ch*sizeof(int16_t));//set the conv out holder to zero for accurate accumulation
+          {
+              block_cnt = 0;
+              memset(conv_out_holder, 0, output_ch*sizeof(int16_t));
 
               const int32_t base_idx_y = stride_y * i_out_y - pad_y;
               const int32_t base_idx_x = stride_x * i_out_x - pad_x;
 
               const int32_t ker_y_start = MAX(0, -base_idx_y);
-              const int32_t ker_x_start = MAX(0, -base_idx_x); 
+              const int32_t ker_x_start = MAX(0, -base_idx_x);
 
               const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
               const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
 
-              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];
+              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];//spill rows of the misses that could not be cached
+              const uint8_t* lut_row[LUT_PREC];
 
-              //for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch++)
               for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
               {
                 for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
                 {
-                  const int32_t in_row = base_idx_y + i_ker_y; 
+                  const int32_t in_row = base_idx_y + i_ker_y;
                   const int32_t in_col = base_idx_x + i_ker_x;
 
                   for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN)
                   {
-                    int kernel_pixel_cnt = 0;
-                    //index generation, outer loop is for input pixels, and inner loop is for 8 index
-                    
-                    for (j_input_ch = i_input_ch; j_input_ch < i_input_ch + FW_GRAN; j_input_ch++)
-                    {
-                      //loop through the channels of a single pixel to generate the index to the kernel pool   
+                    lut_nn_bitplane_index(input_data + (in_row * input_x + in_col) * input_ch + i_input_ch, input_offset, LUT_PREC, input_index);
+                    lut_row_cache_next_block(cache);
+                    for(int bit = 0; bit < LUT_PREC; bit++){
+                      lut_row[bit] = lut_row_cache_fetch(cache, input_index[bit], lut_buffer + bit*LUT_SIZE);
+                    }
 
-                      input_tmp = input_data[(in_row * input_x + in_col) * input_ch + j_input_ch] + input_offset;
-                      for (int i = 0; i < LUT_PREC; i++){
-                        extracted_bit = GETBIT(input_tmp, i);
-                        if(extracted_bit){
-                          SETBIT(input_index[i], kernel_pixel_cnt);//set the bit if extracted is 1
+                    if (double_lookup)
+                    {
+                      int16_t result_mem[LUT_SIZE];
+                      for (i_phy_ft = 0; i_phy_ft < LUT_SIZE; i_phy_ft++){
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_row[bit][i_phy_ft])<<bit);
                         }
-                      }  
-                      kernel_pixel_cnt++;
-                    }
-                    //copy the corresponding lut block of each bit from flash to ram
-                    //The overhead of this memcopy will be compenstated by sharing it across all filters
-                    for(int bit = 0; bit < LUT_PREC; bit++){
-                      memcpy(lut_buffer + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                        result_mem[i_phy_ft] = partial_sum;
+                      }
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        conv_out_holder[i_out_ch] += result_mem[kernel_idx[logical_kernel_idx]];
+                      }
                     }
-                    //loop through different filters of the same channel to extract the results, so that the index can be shared
-                    for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                    else
                     {
-                      partial_sum = 0; //reset the conv_out for each kernel
-                      logical_kernel_idx = output_ch * block_cnt + i_out_ch;//get the current logical kernel index to find the corresponding physical kenrel in kernel pool
-                      physical_kernel_idx = kernel_idx[logical_kernel_idx];
-                      //Loop for bit-serial processing, total iteration is the precision used
-                      //need to shift according to the bit precision as well
-                      for(int bit = 0; bit < LUT_PREC; bit++)
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
                       {
-                        result_idx = bit*LUT_SIZE + physical_kernel_idx;               
-                        partial_sum += ((int16_t)(lut_buffer[result_idx])<<bit);
+                        partial_sum = 0;
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        const uint8_t physical_kernel_idx = kernel_idx[logical_kernel_idx];
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_row[bit][physical_kernel_idx])<<bit);
+                        }
+                        conv_out_holder[i_out_ch] += partial_sum;
                       }
-                      conv_out_holder[i_out_ch] += partial_sum; //accumulate the partial sums to the output result holder                  
                     }
                     block_cnt++;
                   }
                 }
               }
-              //write the results into output array, make it outside the channel loop so that it won't be repeated
-              //or can writ e a condition inside the previous loop and only process the following code if its the last channel, but need to repeat the comparison every time.
-              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++) 
+              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
               {
                 if (bias_data)
                 {
-                    conv_out_holder[i_out_ch] += bias_data[i_out_ch];
+                  conv_out_holder[i_out_ch] += bias_data[i_out_ch];
                 }
                 conv_out_holder[i_out_ch] = arm_nn_requantize(conv_out_holder[i_out_ch], output_mult[i_out_ch], output_shift[i_out_ch]);
                 conv_out_holder[i_out_ch] += out_offset;
@@ -476,7 +675,1554 @@ arm_status lut_conv_zdim_v5_fusedpooling(const cmsis_nn_context *ctx,
       input_data += (input_x * input_y * input_ch);
       output_data += (output_x * output_y * output_ch);
     }
-    //free(conv_out_holder);
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_conv_zdim_v1_cached(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_row_cache *cache,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_cached_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                   bias_data, output_dims, filter_pool_data, cache, 0, output_data);
+}
+
+arm_status lut_conv_zdim_v2_cached(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_row_cache *cache,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_cached_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                   bias_data, output_dims, filter_pool_data, cache, 1, output_data);
+}
+
+/*
+Zero skipping versions of lut_conv_zdim_v1 and lut_conv_zdim_v2_double_lookup for post-relu activations.
+A bit plane with index 0 always reads LUT row 0, so its row is not copied: row 0 is kept in SRAM for the whole call
+and the zero planes of a block add row0[k] * (sum of their bit weights) in one multiply. A block whose planes are all
+zero adds row0[k] * (2^LUT_PREC - 1), precomputed per physical kernel, and is skipped entirely (no filter walk) when
+row 0 of the pool is zero. The results are identical to the dense kernels.
+*/
+static inline arm_status lut_conv_zdim_sparse_core(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_sparsity_stats *stats,
+                           const int32_t double_lookup,
+                           q7_t *output_data)
+{
+  const uint16_t input_batches = input_dims->n;
+  const uint16_t input_x = input_dims->w;
+  const uint16_t input_y = input_dims->h;
+  const uint16_t input_ch = input_dims->c;
+  const uint16_t kernel_x = filter_dims->w;
+  const uint16_t kernel_y = filter_dims->h;
+  const uint16_t output_x = output_dims->w;
+  const uint16_t output_y = output_dims->h;
+  const uint16_t output_ch = output_dims->c;
+
+  const uint16_t pad_x = conv_params->padding.w;
+  const uint16_t pad_y = conv_params->padding.h;
+  const uint16_t stride_x = conv_params->stride.w;
+  const uint16_t stride_y = conv_params->stride.h;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+
+  uint16_t input_index[LUT_PREC];
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  //row 0 and the all zero block result of every physical kernel, once per call
+  uint8_t lut_row0[LUT_SIZE];
+  int16_t zero_block[LUT_SIZE];
+  int32_t row0_zero = 1;
+  memcpy(lut_row0, filter_pool_data, LUT_SIZE);
+  for (int32_t k = 0; k < LUT_SIZE; k++)
+  {
+    zero_block[k] = (int16_t)(lut_row0[k] * ((1 << LUT_PREC) - 1));
+    row0_zero &= lut_row0[k] == 0;
+  }
+  uint32_t blocks = 0, zero_blocks = 0, zero_planes = 0;
+
+  int i_batch;
+  for (i_batch = 0; i_batch < input_batches; i_batch++)
+  {
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, i_phy_ft;
+      int32_t logical_kernel_idx, block_cnt;
+      int16_t partial_sum;
+
+      for (i_out_y = 0; i_out_y < output_y; i_out_y++)
+      {
+          for (i_out_x = 0; i_out_x < output_x; i_out_x++)
+          {
+              block_cnt = 0;
+              memset(conv_out_holder, 0, output_ch*sizeof(int16_t));
+
+              const int32_t base_idx_y = stride_y * i_out_y - pad_y;
+              const int32_t base_idx_x = stride_x * i_out_x - pad_x;
+
+              const int32_t ker_y_start = MAX(0, -base_idx_y);
+              const int32_t ker_x_start = MAX(0, -base_idx_x);
+
+              const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+              const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+
+              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];//rows of the non-zero planes only
+              int32_t plane_bit[LUT_PREC];
+
+              for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
+              {
+                for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
+                {
+                  const int32_t in_row = base_idx_y + i_ker_y;
+                  const int32_t in_col = base_idx_x + i_ker_x;
+
+                  for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN, block_cnt++)
+                  {
+                    lut_nn_bitplane_index(input_data + (in_row * input_x + in_col) * input_ch + i_input_ch, input_offset, LUT_PREC, input_index);
+                    blocks++;
+                    //copy the rows of the non-zero planes, zero_weight collects the bit weights of the others
+                    int32_t planes = 0;
+                    int16_t zero_weight = 0;
+                    for(int bit = 0; bit < LUT_PREC; bit++){
+                      if (input_index[bit] == 0)
+                      {
+                        zero_weight += 1 << bit;
+                        continue;
+                      }
+                      memcpy(lut_buffer + planes*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                      plane_bit[planes++] = bit;
+                    }
+                    zero_planes += LUT_PREC - planes;
+                    if (row0_zero)
+                    {
+                      zero_weight = 0;
+                    }
+
+                    if (planes == 0)
+                    {
+                      zero_blocks++;
+                      if (!row0_zero)
+                      {
+                        for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                        {
+                          conv_out_holder[i_out_ch] += zero_block[kernel_idx[output_ch * block_cnt + i_out_ch]];
+                        }
+                      }
+                      continue;
+                    }
+
+                    if (double_lookup)
+                    {
+                      int16_t result_mem[LUT_SIZE];
+                      for (i_phy_ft = 0; i_phy_ft < LUT_SIZE; i_phy_ft++){
+                        partial_sum = lut_row0[i_phy_ft] * zero_weight;
+                        for(int p = 0; p < planes; p++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[p*LUT_SIZE + i_phy_ft])<<plane_bit[p]);
+                        }
+                        result_mem[i_phy_ft] = partial_sum;
+                      }
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        conv_out_holder[i_out_ch] += result_mem[kernel_idx[logical_kernel_idx]];
+                      }
+                    }
+                    else
+                    {
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        const uint8_t physical_kernel_idx = kernel_idx[logical_kernel_idx];
+                        partial_sum = lut_row0[physical_kernel_idx] * zero_weight;
+                        for(int p = 0; p < planes; p++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[p*LUT_SIZE + physical_kernel_idx])<<plane_bit[p]);
+                        }
+                        conv_out_holder[i_out_ch] += partial_sum;
+                      }
+                    }
+                  }
+                }
+              }
+              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+              {
+                if (bias_data)
+                {
+                  conv_out_holder[i_out_ch] += bias_data[i_out_ch];
+                }
+                conv_out_holder[i_out_ch] = arm_nn_requantize(conv_out_holder[i_out_ch], output_mult[i_out_ch], output_shift[i_out_ch]);
+                conv_out_holder[i_out_ch] += out_offset;
+                conv_out_holder[i_out_ch] = MAX(conv_out_holder[i_out_ch], out_activation_min);
+                conv_out_holder[i_out_ch] = MIN(conv_out_holder[i_out_ch], out_activation_max);
+                output_data[i_out_ch + (i_out_y * output_x + i_out_x) * output_ch] = (int8_t)conv_out_holder[i_out_ch];
+              }
+          }
+      }
+      /* Advance to the next batch */
+      input_data += (input_x * input_y * input_ch);
+      output_data += (output_x * output_y * output_ch);
+    }
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
+    if (stats)
+    {
+      stats->blocks += blocks;
+      stats->zero_blocks += zero_blocks;
+      stats->planes += blocks * LUT_PREC;
+      stats->zero_planes += zero_planes;
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_conv_zdim_v1_sparse(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_sparsity_stats *stats,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_sparse_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                   bias_data, output_dims, filter_pool_data, stats, 0, output_data);
+}
+
+arm_status lut_conv_zdim_v2_sparse(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_sparsity_stats *stats,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_sparse_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                   bias_data, output_dims, filter_pool_data, stats, 1, output_data);
+}
+
+/*
+Dynamic precision versions of lut_conv_zdim_v1 and lut_conv_zdim_v2_double_lookup.
+The precision of every block is the highest set bit of its 8 values (lut_nn_bitplane_index_dynamic, a clz on their
+OR), only that many planes are generated, copied and looked up. The planes above it have index 0 and read LUT row 0,
+which is kept in SRAM for the whole call: they add row0[k] * (2^LUT_PREC - 2^prec) in one multiply, so the results
+are identical to the dense kernels. The filter loop is specialised per precision (lut_conv_zdim_dynprec_dispatch) so
+that the bit loop is unrolled for every block width.
+*/
+__STATIC_FORCEINLINE void lut_conv_zdim_dynprec_block(int16_t *acc,
+                           const uint8_t *kernel_idx,
+                           const int32_t count,
+                           const uint8_t *lut_buffer,
+                           const uint8_t *lut_row0,
+                           const int16_t high_weight,
+                           const int32_t prec)
+{
+  //kernel_idx NULL: acc[k] is physical kernel k (double lookup), else acc[i] is filter i
+  for (int32_t i = 0; i < count; i++)
+  {
+    const int32_t k = kernel_idx ? kernel_idx[i] : i;
+    int16_t partial_sum = lut_row0[k] * high_weight;
+    for (int32_t bit = 0; bit < prec; bit++)
+    {
+      partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + k])<<bit);
+    }
+    acc[i] += partial_sum;
+  }
+}
+
+//prec is a constant in every case so each copy of the block loop has its bit loop unrolled
+__STATIC_FORCEINLINE void lut_conv_zdim_dynprec_dispatch(int16_t *acc,
+                           const uint8_t *kernel_idx,
+                           const int32_t count,
+                           const uint8_t *lut_buffer,
+                           const uint8_t *lut_row0,
+                           const int16_t high_weight,
+                           const int32_t prec)
+{
+  switch (prec)
+  {
+    case 1: lut_conv_zdim_dynprec_block(acc, kernel_idx, count, lut_buffer, lut_row0, high_weight, 1); break;
+    case 2: lut_conv_zdim_dynprec_block(acc, kernel_idx, count, lut_buffer, lut_row0, high_weight, 2); break;
+    case 3: lut_conv_zdim_dynprec_block(acc, kernel_idx, count, lut_buffer, lut_row0, high_weight, 3); break;
+    case 4: lut_conv_zdim_dynprec_block(acc, kernel_idx, count, lut_buffer, lut_row0, high_weight, 4); break;
+    default: lut_conv_zdim_dynprec_block(acc, kernel_idx, count, lut_buffer, lut_row0, high_weight, LUT_PREC); break;
+  }
+}
+
+static inline arm_status lut_conv_zdim_dynprec_core(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_precision_stats *stats,
+                           const int32_t double_lookup,
+                           q7_t *output_data)
+{
+  const uint16_t input_batches = input_dims->n;
+  const uint16_t input_x = input_dims->w;
+  const uint16_t input_y = input_dims->h;
+  const uint16_t input_ch = input_dims->c;
+  const uint16_t kernel_x = filter_dims->w;
+  const uint16_t kernel_y = filter_dims->h;
+  const uint16_t output_x = output_dims->w;
+  const uint16_t output_y = output_dims->h;
+  const uint16_t output_ch = output_dims->c;
+
+  const uint16_t pad_x = conv_params->padding.w;
+  const uint16_t pad_y = conv_params->padding.h;
+  const uint16_t stride_x = conv_params->stride.w;
+  const uint16_t stride_y = conv_params->stride.h;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+
+  uint16_t input_index[LUT_PREC];
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  //row 0 once per call, high_weight[p] is the bit weight of the planes a block of precision p does not look up
+  uint8_t lut_row0[LUT_SIZE];
+  int16_t high_weight[LUT_PREC + 1];
+  int32_t row0_zero = 1;
+  memcpy(lut_row0, filter_pool_data, LUT_SIZE);
+  for (int32_t k = 0; k < LUT_SIZE; k++)
+  {
+    row0_zero &= lut_row0[k] == 0;
+  }
+  for (int32_t p = 0; p <= LUT_PREC; p++)
+  {
+    high_weight[p] = row0_zero ? 0 : (1 << LUT_PREC) - (1 << p);
+  }
+  uint32_t prec_blocks[LUT_PREC + 1] = {0};
+
+  int i_batch;
+  for (i_batch = 0; i_batch < input_batches; i_batch++)
+  {
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x;
+      int32_t block_cnt;
+
+      for (i_out_y = 0; i_out_y < output_y; i_out_y++)
+      {
+          for (i_out_x = 0; i_out_x < output_x; i_out_x++)
+          {
+              block_cnt = 0;
+              memset(conv_out_holder, 0, output_ch*sizeof(int16_t));
+
+              const int32_t base_idx_y = stride_y * i_out_y - pad_y;
+              const int32_t base_idx_x = stride_x * i_out_x - pad_x;
+
+              const int32_t ker_y_start = MAX(0, -base_idx_y);
+              const int32_t ker_x_start = MAX(0, -base_idx_x);
+
+              const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+              const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+
+              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];
+
+              for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
+              {
+                for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
+                {
+                  const int32_t in_row = base_idx_y + i_ker_y;
+                  const int32_t in_col = base_idx_x + i_ker_x;
+
+                  for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN, block_cnt++)
+                  {
+                    const int32_t prec = lut_nn_bitplane_index_dynamic(input_data + (in_row * input_x + in_col) * input_ch + i_input_ch,
+                                                                       input_offset, LUT_PREC, input_index);
+                    prec_blocks[prec]++;
+                    const uint8_t *block_idx = kernel_idx + output_ch * block_cnt;
+                    if (prec == 0)
+                    {
+                      //every plane reads row 0
+                      if (!row0_zero)
+                      {
+                        for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                        {
+                          conv_out_holder[i_out_ch] += lut_row0[block_idx[i_out_ch]] * high_weight[0];
+                        }
+                      }
+                      continue;
+                    }
+                    for(int bit = 0; bit < prec; bit++){
+                      memcpy(lut_buffer + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                    }
+
+                    if (double_lookup)
+                    {
+                      int16_t result_mem[LUT_SIZE] = {0};
+                      lut_conv_zdim_dynprec_dispatch(result_mem, NULL, LUT_SIZE, lut_buffer, lut_row0, high_weight[prec], prec);
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        conv_out_holder[i_out_ch] += result_mem[block_idx[i_out_ch]];
+                      }
+                    }
+                    else
+                    {
+                      lut_conv_zdim_dynprec_dispatch(conv_out_holder, block_idx, output_ch, lut_buffer, lut_row0, high_weight[prec], prec);
+                    }
+                  }
+                }
+              }
+              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+              {
+                if (bias_data)
+                {
+                  conv_out_holder[i_out_ch] += bias_data[i_out_ch];
+                }
+                conv_out_holder[i_out_ch] = arm_nn_requantize(conv_out_holder[i_out_ch], output_mult[i_out_ch], output_shift[i_out_ch]);
+                conv_out_holder[i_out_ch] += out_offset;
+                conv_out_holder[i_out_ch] = MAX(conv_out_holder[i_out_ch], out_activation_min);
+                conv_out_holder[i_out_ch] = MIN(conv_out_holder[i_out_ch], out_activation_max);
+                output_data[i_out_ch + (i_out_y * output_x + i_out_x) * output_ch] = (int8_t)conv_out_holder[i_out_ch];
+              }
+          }
+      }
+      /* Advance to the next batch */
+      input_data += (input_x * input_y * input_ch);
+      output_data += (output_x * output_y * output_ch);
+    }
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
+    if (stats)
+    {
+      for (int32_t p = 0; p <= LUT_PREC; p++)
+      {
+        stats->blocks[p] += prec_blocks[p];
+      }
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_conv_zdim_v1_dynprec(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_precision_stats *stats,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_dynprec_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                    bias_data, output_dims, filter_pool_data, stats, 0, output_data);
+}
+
+arm_status lut_conv_zdim_v2_dynprec(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           lut_precision_stats *stats,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_dynprec_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                    bias_data, output_dims, filter_pool_data, stats, 1, output_data);
+}
+
+/*
+1x1 (pointwise) versions of lut_conv_zdim_v1 and lut_conv_zdim_v2_double_lookup, for the expansion and projection
+layers of MobileNetV2. With a 1x1 window, stride 1 and no padding the layer is a pixels x channels matrix: the input
+is streamed in HWC order with no window bounds, and LUT_PW_PIXELS pixels are processed together so that every kernel
+index read from flash (and every result_mem gather of v2) serves all the pixels of the tile.
+The output of a tile is only written once the whole tile is computed, and pixel p writes output_ch bytes at
+p * output_ch <= p * input_ch, so the layer can run in place (output_data == input_data) when output_ch <= input_ch.
+Other shapes are passed to the generic kernels.
+*/
+static inline arm_status lut_conv_zdim_pointwise_core(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const int32_t double_lookup,
+                           q7_t *output_data)
+{
+  if (filter_dims->w != 1 || filter_dims->h != 1 || conv_params->stride.w != 1 || conv_params->stride.h != 1 ||
+      conv_params->padding.w != 0 || conv_params->padding.h != 0)
+  {
+    return (double_lookup ? lut_conv_zdim_v2_double_lookup : lut_conv_zdim_v1)(ctx, conv_params, quant_params,
+        input_dims, input_data, filter_dims, kernel_idx, bias_dims, bias_data, output_dims, filter_pool_data, output_data);
+  }
+
+  const int32_t pixels = input_dims->n * input_dims->h * input_dims->w;
+  const int32_t input_ch = input_dims->c;
+  const int32_t output_ch = output_dims->c;
+  const int32_t blocks = input_ch / FW_GRAN;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+
+  uint16_t input_index[LUT_PREC];
+  //holder[i_out_ch * LUT_PW_PIXELS + p], the pixels of a tile side by side
+  const int32_t holder_size = lut_conv_zdim_pointwise_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  uint8_t lut_buffer[LUT_PW_PIXELS][LUT_PREC*LUT_SIZE];
+
+  for (int32_t i_pixel = 0; i_pixel < pixels; i_pixel += LUT_PW_PIXELS)
+  {
+    const int32_t tile = MIN(LUT_PW_PIXELS, pixels - i_pixel);
+    const q7_t *in = input_data + i_pixel * input_ch;
+    memset(conv_out_holder, 0, output_ch * LUT_PW_PIXELS * sizeof(int16_t));
+
+    for (int32_t i_block = 0; i_block < blocks; i_block++)
+    {
+      //rows of the block for every pixel of the tile
+      for (int32_t p = 0; p < tile; p++)
+      {
+        lut_nn_bitplane_index(in + p * input_ch + i_block * FW_GRAN, input_offset, LUT_PREC, input_index);
+        for (int bit = 0; bit < LUT_PREC; bit++)
+        {
+          memcpy(lut_buffer[p] + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+        }
+      }
+      const uint8_t *block_idx = kernel_idx + output_ch * i_block;
+
+      if (double_lookup)
+      {
+        uint16_t result_mem[LUT_PW_PIXELS][LUT_SIZE];
+        for (int32_t p = 0; p < tile; p++)
+        {
+          for (int32_t i_phy_ft = 0; i_phy_ft < LUT_SIZE; i_phy_ft++)
+          {
+            int16_t partial_sum = 0;
+            for (int bit = 0; bit < LUT_PREC; bit++)
+            {
+              partial_sum += ((int16_t)(lut_buffer[p][bit*LUT_SIZE + i_phy_ft])<<bit);
+            }
+            result_mem[p][i_phy_ft] = partial_sum;
+          }
+        }
+        for (int32_t i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+        {
+          const uint8_t physical_kernel_idx = block_idx[i_out_ch];
+          int16_t *holder = conv_out_holder + i_out_ch * LUT_PW_PIXELS;
+          for (int32_t p = 0; p < tile; p++)
+          {
+            holder[p] += result_mem[p][physical_kernel_idx];
+          }
+        }
+      }
+      else
+      {
+        for (int32_t i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+        {
+          const uint8_t physical_kernel_idx = block_idx[i_out_ch];
+          int16_t *holder = conv_out_holder + i_out_ch * LUT_PW_PIXELS;
+          for (int32_t p = 0; p < tile; p++)
+          {
+            int16_t partial_sum = 0;
+            for (int bit = 0; bit < LUT_PREC; bit++)
+            {
+              partial_sum += ((int16_t)(lut_buffer[p][bit*LUT_SIZE + physical_kernel_idx])<<bit);
+            }
+            holder[p] += partial_sum;
+          }
+        }
+      }
+    }
+
+    //the whole tile has been read, its outputs can now overwrite the input when running in place
+    q7_t *out = output_data + i_pixel * output_ch;
+    for (int32_t p = 0; p < tile; p++)
+    {
+      for (int32_t i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+      {
+        int16_t acc = conv_out_holder[i_out_ch * LUT_PW_PIXELS + p];
+        if (bias_data)
+        {
+          acc += bias_data[i_out_ch];
+        }
+        acc = arm_nn_requantize(acc, output_mult[i_out_ch], output_shift[i_out_ch]);
+        acc += out_offset;
+        acc = MAX(acc, out_activation_min);
+        acc = MIN(acc, out_activation_max);
+        out[p * output_ch + i_out_ch] = (int8_t)acc;
+      }
+    }
+  }
+  if (holder_owned)
+  {
+    free(conv_out_holder);
+  }
+
+  return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_conv_zdim_v1_pointwise(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data)
+{
+  return lut_conv_zdim_pointwise_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                      bias_dims, bias_data, output_dims, filter_pool_data, 0, output_data);
+}
+
+arm_status lut_conv_zdim_v2_pointwise(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data)
+{
+  return lut_conv_zdim_pointwise_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                      bias_dims, bias_data, output_dims, filter_pool_data, 1, output_data);
+}
+
+/*
+Bit-plane activation format. The LUT kernels only ever use the LUT_PREC row indices of every 8-channel block, so a
+producer can write them instead of the q7 values: [N][H][W][C / 8][LUT_PREC] bytes, LUT_PREC / 8 of the q7 size.
+The requantize epilogue of the _bitplane kernels packs the clamped outputs with the input offset of the consumer
+(output_plane_offset), and a consumer in this format reads its indices directly instead of transposing its input.
+lut_bitplane_from_s8 / lut_bitplane_to_s8 convert at the boundaries with the q7 layers (CMSIS s8, pooling, network
+input and output).
+*/
+int32_t lut_bitplane_get_size(const cmsis_nn_dims *dims)
+{
+  return dims->n * dims->h * dims->w * (dims->c / FW_GRAN) * LUT_PREC;
+}
+
+void lut_bitplane_from_s8(const q7_t *input_data, const cmsis_nn_dims *dims, const int32_t input_offset, uint8_t *planes)
+{
+  const int32_t blocks = dims->n * dims->h * dims->w * (dims->c / FW_GRAN);
+  uint16_t index[LUT_PREC];
+  for (int32_t i = 0; i < blocks; i++)
+  {
+    lut_nn_bitplane_index(input_data + i * FW_GRAN, input_offset, LUT_PREC, index);
+    for (int bit = 0; bit < LUT_PREC; bit++)
+    {
+      planes[i * LUT_PREC + bit] = (uint8_t)index[bit];
+    }
+  }
+}
+
+void lut_bitplane_to_s8(const uint8_t *planes, const cmsis_nn_dims *dims, const int32_t input_offset, q7_t *output_data)
+{
+  const int32_t blocks = dims->n * dims->h * dims->w * (dims->c / FW_GRAN);
+  for (int32_t i = 0; i < blocks; i++)
+  {
+    for (int32_t j = 0; j < FW_GRAN; j++)
+    {
+      int32_t val = 0;
+      for (int bit = 0; bit < LUT_PREC; bit++)
+      {
+        val |= ((planes[i * LUT_PREC + bit] >> j) & 1) << bit;
+      }
+      output_data[i * FW_GRAN + j] = (q7_t)(val - input_offset);
+    }
+  }
+}
+
+static inline arm_status lut_conv_zdim_bitplane_core(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_bitplane_params *bp_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const int32_t double_lookup,
+                           q7_t *output_data)
+{
+  const uint16_t input_batches = input_dims->n;
+  const uint16_t input_x = input_dims->w;
+  const uint16_t input_y = input_dims->h;
+  const uint16_t input_ch = input_dims->c;
+  const uint16_t kernel_x = filter_dims->w;
+  const uint16_t kernel_y = filter_dims->h;
+  const uint16_t output_x = output_dims->w;
+  const uint16_t output_y = output_dims->h;
+  const uint16_t output_ch = output_dims->c;
+
+  const uint16_t pad_x = conv_params->padding.w;
+  const uint16_t pad_y = conv_params->padding.h;
+  const uint16_t stride_x = conv_params->stride.w;
+  const uint16_t stride_y = conv_params->stride.h;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+
+  const int32_t in_planes = bp_params->input_planes;
+  const int32_t out_planes = bp_params->output_planes;
+  //bytes of one input / output pixel in their format
+  const int32_t in_pixel = in_planes ? input_ch / FW_GRAN * LUT_PREC : input_ch;
+  const int32_t out_pixel = out_planes ? output_ch / FW_GRAN * LUT_PREC : output_ch;
+  const uint8_t *in_bytes = (const uint8_t *)input_data;
+  uint8_t *out_bytes = (uint8_t *)output_data;
+
+  if (out_planes && output_ch % FW_GRAN)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+
+  uint16_t input_index[LUT_PREC];
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  int i_batch;
+  for (i_batch = 0; i_batch < input_batches; i_batch++)
+  {
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, i_phy_ft;
+      int32_t logical_kernel_idx, block_cnt;
+      int16_t partial_sum;
+
+      for (i_out_y = 0; i_out_y < output_y; i_out_y++)
+      {
+          for (i_out_x = 0; i_out_x < output_x; i_out_x++)
+          {
+              block_cnt = 0;
+              memset(conv_out_holder, 0, output_ch*sizeof(int16_t));
+
+              const int32_t base_idx_y = stride_y * i_out_y - pad_y;
+              const int32_t base_idx_x = stride_x * i_out_x - pad_x;
+
+              const int32_t ker_y_start = MAX(0, -base_idx_y);
+              const int32_t ker_x_start = MAX(0, -base_idx_x);
+
+              const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+              const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+
+              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];
+
+              for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
+              {
+                for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
+                {
+                  const int32_t in_row = base_idx_y + i_ker_y;
+                  const int32_t in_col = base_idx_x + i_ker_x;
+                  const uint8_t *in_pix = in_bytes + (in_row * input_x + in_col) * in_pixel;
+
+                  for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN, block_cnt++)
+                  {
+                    if (in_planes)
+                    {
+                      //the producer already wrote the indices of this block
+                      const uint8_t *block = in_pix + i_input_ch / FW_GRAN * LUT_PREC;
+                      for(int bit = 0; bit < LUT_PREC; bit++){
+                        input_index[bit] = block[bit];
+                      }
+                    }
+                    else
+                    {
+                      lut_nn_bitplane_index((const q7_t *)in_pix + i_input_ch, input_offset, LUT_PREC, input_index);
+                    }
+                    for(int bit = 0; bit < LUT_PREC; bit++){
+                      memcpy(lut_buffer + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                    }
+
+                    if (double_lookup)
+                    {
+                      int16_t result_mem[LUT_SIZE];
+                      for (i_phy_ft = 0; i_phy_ft < LUT_SIZE; i_phy_ft++){
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + i_phy_ft])<<bit);
+                        }
+                        result_mem[i_phy_ft] = partial_sum;
+                      }
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        conv_out_holder[i_out_ch] += result_mem[kernel_idx[logical_kernel_idx]];
+                      }
+                    }
+                    else
+                    {
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        const uint8_t physical_kernel_idx = kernel_idx[logical_kernel_idx];
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + physical_kernel_idx])<<bit);
+                        }
+                        conv_out_holder[i_out_ch] += partial_sum;
+                      }
+                    }
+                  }
+                }
+              }
+              uint8_t *out_pix = out_bytes + (i_out_y * output_x + i_out_x) * out_pixel;
+              q7_t out_block[FW_GRAN];
+              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+              {
+                if (bias_data)
+                {
+                  conv_out_holder[i_out_ch] += bias_data[i_out_ch];
+                }
+                conv_out_holder[i_out_ch] = arm_nn_requantize(conv_out_holder[i_out_ch], output_mult[i_out_ch], output_shift[i_out_ch]);
+                conv_out_holder[i_out_ch] += out_offset;
+                conv_out_holder[i_out_ch] = MAX(conv_out_holder[i_out_ch], out_activation_min);
+                conv_out_holder[i_out_ch] = MIN(conv_out_holder[i_out_ch], out_activation_max);
+                if (!out_planes)
+                {
+                  out_pix[i_out_ch] = (uint8_t)(int8_t)conv_out_holder[i_out_ch];
+                  continue;
+                }
+                //pack every finished block of 8 channels with the offset of the consumer
+                out_block[i_out_ch % FW_GRAN] = (q7_t)conv_out_holder[i_out_ch];
+                if (i_out_ch % FW_GRAN == FW_GRAN - 1)
+                {
+                  uint8_t *block = out_pix + i_out_ch / FW_GRAN * LUT_PREC;
+                  lut_nn_bitplane_index(out_block, bp_params->output_plane_offset, LUT_PREC, input_index);
+                  for(int bit = 0; bit < LUT_PREC; bit++){
+                    block[bit] = (uint8_t)input_index[bit];
+                  }
+                }
+              }
+          }
+      }
+      /* Advance to the next batch */
+      in_bytes += input_x * input_y * in_pixel;
+      out_bytes += output_x * output_y * out_pixel;
+    }
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_conv_zdim_v1_bitplane(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_bitplane_params *bp_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_bitplane_core(ctx, conv_params, quant_params, bp_params, input_dims, input_data, filter_dims,
+                                     kernel_idx, bias_data, output_dims, filter_pool_data, 0, output_data);
+}
+
+arm_status lut_conv_zdim_v2_bitplane(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_bitplane_params *bp_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_bitplane_core(ctx, conv_params, quant_params, bp_params, input_dims, input_data, filter_dims,
+                                     kernel_idx, bias_data, output_dims, filter_pool_data, 1, output_data);
+}
+
+/*
+Packed n-bit activations (lut_pack_params, lut_packed_act.c). The input blocks are unpacked into 8 q7 values before
+the usual index generation, and the requantize epilogue packs its clamped outputs, so a LUT layer between two packed
+tensors never holds a q7 tensor. NULL pack parameters select the q7 layout for that side.
+*/
+static inline arm_status lut_conv_zdim_packed_core(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_pack_params *input_pack,
+                           const lut_pack_params *output_pack,
+                           const cmsis_nn_dims *input_dims,
+                           const uint8_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const int32_t double_lookup,
+                           uint8_t *output_data)
+{
+  const uint16_t input_batches = input_dims->n;
+  const uint16_t input_x = input_dims->w;
+  const uint16_t input_y = input_dims->h;
+  const uint16_t input_ch = input_dims->c;
+  const uint16_t kernel_x = filter_dims->w;
+  const uint16_t kernel_y = filter_dims->h;
+  const uint16_t output_x = output_dims->w;
+  const uint16_t output_y = output_dims->h;
+  const uint16_t output_ch = output_dims->c;
+
+  const uint16_t pad_x = conv_params->padding.w;
+  const uint16_t pad_y = conv_params->padding.h;
+  const uint16_t stride_x = conv_params->stride.w;
+  const uint16_t stride_y = conv_params->stride.h;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+
+  //bits per value of both sides, 8 for q7
+  const int32_t in_bits = input_pack ? input_pack->bits : 8;
+  const int32_t in_pack_offset = input_pack ? input_pack->offset : 0;
+  const int32_t out_bits = output_pack ? output_pack->bits : 8;
+  const int32_t out_pack_offset = output_pack ? output_pack->offset : 0;
+  if ((in_bits != 1 && in_bits != 2 && in_bits != 4 && in_bits != 8) ||
+      (out_bits != 1 && out_bits != 2 && out_bits != 4 && out_bits != 8))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  uint16_t input_index[LUT_PREC];
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  int i_batch;
+  for (i_batch = 0; i_batch < input_batches; i_batch++)
+  {
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, i_phy_ft;
+      int32_t logical_kernel_idx, block_cnt;
+      int16_t partial_sum;
+
+      for (i_out_y = 0; i_out_y < output_y; i_out_y++)
+      {
+          for (i_out_x = 0; i_out_x < output_x; i_out_x++)
+          {
+              block_cnt = 0;
+              memset(conv_out_holder, 0, output_ch*sizeof(int16_t));
+
+              const int32_t base_idx_y = stride_y * i_out_y - pad_y;
+              const int32_t base_idx_x = stride_x * i_out_x - pad_x;
+
+              const int32_t ker_y_start = MAX(0, -base_idx_y);
+              const int32_t ker_x_start = MAX(0, -base_idx_x);
+
+              const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+              const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+
+              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];
+
+              for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
+              {
+                for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
+                {
+                  const int32_t in_row = base_idx_y + i_ker_y;
+                  const int32_t in_col = base_idx_x + i_ker_x;
+
+                  for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN, block_cnt++)
+                  {
+                    //a block of 8 values starts on a byte for every supported width
+                    const uint8_t *block = input_data + ((in_row * input_x + in_col) * input_ch + i_input_ch) * in_bits / 8;
+                    q7_t values[FW_GRAN];
+                    for (int32_t j = 0; j < FW_GRAN; j++)
+                    {
+                      values[j] = (q7_t)(lut_nn_packed_get(block, j, in_bits) - in_pack_offset);
+                    }
+                    lut_nn_bitplane_index(values, input_offset, LUT_PREC, input_index);
+                    for(int bit = 0; bit < LUT_PREC; bit++){
+                      memcpy(lut_buffer + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                    }
+
+                    if (double_lookup)
+                    {
+                      int16_t result_mem[LUT_SIZE];
+                      for (i_phy_ft = 0; i_phy_ft < LUT_SIZE; i_phy_ft++){
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + i_phy_ft])<<bit);
+                        }
+                        result_mem[i_phy_ft] = partial_sum;
+                      }
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        conv_out_holder[i_out_ch] += result_mem[kernel_idx[logical_kernel_idx]];
+                      }
+                    }
+                    else
+                    {
+                      for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                      {
+                        logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                        const uint8_t physical_kernel_idx = kernel_idx[logical_kernel_idx];
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + physical_kernel_idx])<<bit);
+                        }
+                        conv_out_holder[i_out_ch] += partial_sum;
+                      }
+                    }
+                  }
+                }
+              }
+              const int32_t out_pix = (i_out_y * output_x + i_out_x) * output_ch;
+              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+              {
+                if (bias_data)
+                {
+                  conv_out_holder[i_out_ch] += bias_data[i_out_ch];
+                }
+                conv_out_holder[i_out_ch] = arm_nn_requantize(conv_out_holder[i_out_ch], output_mult[i_out_ch], output_shift[i_out_ch]);
+                conv_out_holder[i_out_ch] += out_offset;
+                conv_out_holder[i_out_ch] = MAX(conv_out_holder[i_out_ch], out_activation_min);
+                conv_out_holder[i_out_ch] = MIN(conv_out_holder[i_out_ch], out_activation_max);
+                lut_nn_packed_set(output_data, out_pix + i_out_ch, out_bits, (uint8_t)(conv_out_holder[i_out_ch] + out_pack_offset));
+              }
+          }
+      }
+      /* Advance to the next batch */
+      input_data += input_x * input_y * input_ch * in_bits / 8;
+      output_data += output_x * output_y * output_ch * out_bits / 8;
+    }
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_conv_zdim_v1_packed(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_pack_params *input_pack,
+                           const lut_pack_params *output_pack,
+                           const cmsis_nn_dims *input_dims,
+                           const uint8_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           uint8_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_packed_core(ctx, conv_params, quant_params, input_pack, output_pack, input_dims, input_data,
+                                   filter_dims, kernel_idx, bias_data, output_dims, filter_pool_data, 0, output_data);
+}
+
+arm_status lut_conv_zdim_v2_packed(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const lut_pack_params *input_pack,
+                           const lut_pack_params *output_pack,
+                           const cmsis_nn_dims *input_dims,
+                           const uint8_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           uint8_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_packed_core(ctx, conv_params, quant_params, input_pack, output_pack, input_dims, input_data,
+                                   filter_dims, kernel_idx, bias_data, output_dims, filter_pool_data, 1, output_data);
+}
+
+/*
+Coefficient scaled versions of lut_conv_zdim_v1 and lut_conv_zdim_v2_double_lookup, for models trained with a scale
+per 8-wide weight block (full_network_coeff_data.h). coeffs has one entry per logical kernel, in the kernel_idx order.
+The scale is applied when a filter reads the result of its physical kernel (shared result_mem in v2, bit-serial sum
+in v1), so the coefficient costs one multiply (or shift) per filter and block.
+Accumulators are 32 bits since a scaled block result no longer fits the 16-bit holder of v1/v2.
+*/
+static inline arm_status lut_conv_zdim_coeff_core(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const uint8_t* coeffs,
+                           const int32_t coeff_is_shift,
+                           const int32_t double_lookup,
+                           q7_t *output_data)
+{
+  const uint16_t input_batches = input_dims->n;
+  const uint16_t input_x = input_dims->w;
+  const uint16_t input_y = input_dims->h;
+  const uint16_t input_ch = input_dims->c;
+  const uint16_t kernel_x = filter_dims->w;
+  const uint16_t kernel_y = filter_dims->h;
+  const uint16_t output_x = output_dims->w;
+  const uint16_t output_y = output_dims->h;
+  const uint16_t output_ch = output_dims->c;
+
+  const uint16_t pad_x = conv_params->padding.w;
+  const uint16_t pad_y = conv_params->padding.h;
+  const uint16_t stride_x = conv_params->stride.w;
+  const uint16_t stride_y = conv_params->stride.h;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+
+  uint16_t input_index[LUT_PREC];
+  const int32_t holder_size = lut_conv_zdim_coeff_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int32_t* conv_out_holder = holder_owned ? (int32_t*)malloc(holder_size) : (int32_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  int i_batch;
+  for (i_batch = 0; i_batch < input_batches; i_batch++)
+  {
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x, i_phy_ft;
+      int32_t logical_kernel_idx, block_cnt;
+      int16_t partial_sum;
+
+      for (i_out_y = 0; i_out_y < output_y; i_out_y++)
+      {
+          for (i_out_x = 0; i_out_x < output_x; i_out_x++)
+          {
+              block_cnt = 0;
+              memset(conv_out_holder, 0, output_ch*sizeof(int32_t));
+
+              const int32_t base_idx_y = stride_y * i_out_y - pad_y;
+              const int32_t base_idx_x = stride_x * i_out_x - pad_x;
+
+              const int32_t ker_y_start = MAX(0, -base_idx_y);
+              const int32_t ker_x_start = MAX(0, -base_idx_x);
+
+              const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+              const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+
+              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];
+
+              for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
+              {
+                for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
+                {
+                  const int32_t in_row = base_idx_y + i_ker_y;
+                  const int32_t in_col = base_idx_x + i_ker_x;
+
+                  for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN)
+                  {
+                    int32_t result_mem[LUT_SIZE];//unscaled result of every physical kernel for this block
+                    lut_nn_bitplane_index(input_data + (in_row * input_x + in_col) * input_ch + i_input_ch, input_offset, LUT_PREC, input_index);
+                    for(int bit = 0; bit < LUT_PREC; bit++){
+                      memcpy(lut_buffer + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                    }
+
+                    if (double_lookup)
+                    {
+                      for (i_phy_ft = 0; i_phy_ft < LUT_SIZE; i_phy_ft++){
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + i_phy_ft])<<bit);
+                        }
+                        result_mem[i_phy_ft] = partial_sum;
+                      }
+                    }
+
+                    //physical kernel result (shared in v2, bit-serial per filter in v1), scaled by the coefficient of
+                    //the logical kernel
+                    for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                    {
+                      logical_kernel_idx = output_ch * block_cnt + i_out_ch;
+                      const uint8_t physical_kernel_idx = kernel_idx[logical_kernel_idx];
+                      int32_t result;
+                      if (double_lookup)
+                      {
+                        result = result_mem[physical_kernel_idx];
+                      }
+                      else
+                      {
+                        partial_sum = 0;
+                        for(int bit = 0; bit < LUT_PREC; bit++)
+                        {
+                          partial_sum += ((int16_t)(lut_buffer[bit*LUT_SIZE + physical_kernel_idx])<<bit);
+                        }
+                        result = partial_sum;
+                      }
+                      if (coeff_is_shift)
+                      {
+                        conv_out_holder[i_out_ch] += result << coeffs[logical_kernel_idx];
+                      }
+                      else
+                      {
+                        conv_out_holder[i_out_ch] += result * coeffs[logical_kernel_idx];
+                      }
+                    }
+                    block_cnt++;
+                  }
+                }
+              }
+              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+              {
+                int32_t conv_out = conv_out_holder[i_out_ch];
+                if (bias_data)
+                {
+                  conv_out += bias_data[i_out_ch];
+                }
+                conv_out = arm_nn_requantize(conv_out, output_mult[i_out_ch], output_shift[i_out_ch]);
+                conv_out += out_offset;
+                conv_out = MAX(conv_out, out_activation_min);
+                conv_out = MIN(conv_out, out_activation_max);
+                output_data[i_out_ch + (i_out_y * output_x + i_out_x) * output_ch] = (int8_t)conv_out;
+              }
+          }
+      }
+      /* Advance to the next batch */
+      input_data += (input_x * input_y * input_ch);
+      output_data += (output_x * output_y * output_ch);
+    }
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_conv_zdim_v1_coeff(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const uint8_t* coeffs,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_coeff_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                  bias_data, output_dims, filter_pool_data, coeffs, 0, 0, output_data);
+}
+
+arm_status lut_conv_zdim_v2_coeff(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const uint8_t* coeffs,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_coeff_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                  bias_data, output_dims, filter_pool_data, coeffs, 0, 1, output_data);
+}
+
+arm_status lut_conv_zdim_v2_coeff_shift(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           const uint8_t* coeffs,
+                           q7_t *output_data)
+{
+  (void)bias_dims;
+  return lut_conv_zdim_coeff_core(ctx, conv_params, quant_params, input_dims, input_data, filter_dims, kernel_idx,
+                                  bias_data, output_dims, filter_pool_data, coeffs, 1, 1, output_data);
+}
+
+arm_status lut_conv_zdim_v5_fusedpooling(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data)
+{
+  //this version implements fused batchnorm, relu and pooling, so that the activation memory can be reduced. (especially for first layer)
+  (void)bias_dims;
+  q15_t *buffer_a = (q15_t *)ctx->buf;
+
+  const uint16_t input_batches = input_dims->n;
+  const uint16_t input_x = input_dims->w;
+  const uint16_t input_y = input_dims->h;
+  const uint16_t input_ch = input_dims->c;
+  const uint16_t kernel_x = filter_dims->w;
+  const uint16_t kernel_y = filter_dims->h;
+  const uint16_t output_x = output_dims->w;
+  const uint16_t output_y = output_dims->h;
+  const uint16_t output_ch = output_dims->c;
+
+  const uint16_t pad_x = conv_params->padding.w;
+  const uint16_t pad_y = conv_params->padding.h;
+  const uint16_t stride_x = conv_params->stride.w;
+  const uint16_t stride_y = conv_params->stride.h;
+
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int32_t *output_mult = quant_params->multiplier;
+  int32_t *output_shift = quant_params->shift;
+  char* result_ptr;
+
+  uint16_t input_index[LUT_PREC] = {0};
+  //take the accumulator holder from the context buffer when the caller provides one, so that calling the kernel
+  //repeatedly (e.g. on row bands) doesn't need a heap allocation per call
+  const int32_t holder_size = lut_conv_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int16_t* conv_out_holder = holder_owned ? (int16_t*)malloc(holder_size) : (int16_t*)ctx->buf;
+  if (conv_out_holder == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  //static int16_t conv_out_holder[128];
+
+  int i_batch;
+  for (i_batch = 0; i_batch < input_batches; i_batch++)
+  {
+      /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+      (void)buffer_a;
+      int32_t i_out_ch, i_out_y, i_out_x, i_input_ch, i_ker_y, i_ker_x;
+      int32_t conv_out, logical_kernel_idx, result_idx, block_cnt;//block_cnt is a counter to count the number of 8-wide weight blocks processed
+      int16_t partial_sum;
+      uint8_t physical_kernel_idx;
+
+      for (i_out_y = 0; i_out_y < output_y; i_out_y++)
+      {
+          for (i_out_x = 0; i_out_x < output_x; i_out_x++)
+          {   
+              block_cnt = 0;//initialize and reset the block counter
+              //conv_out = 0;
+              //int16_t conv_out_holder[output_ch]; //initialize the conv result holder, one for each filter
+              memset(conv_out_holder, 0, output_ch*sizeof(int16_t));//set the conv out holder to zero for accurate accumulation
+
+              const int32_t base_idx_y = stride_y * i_out_y - pad_y;
+              const int32_t base_idx_x = stride_x * i_out_x - pad_x;
+
+              const int32_t ker_y_start = MAX(0, -base_idx_y);
+              const int32_t ker_x_start = MAX(0, -base_idx_x); 
+
+              const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+              const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+
+              uint8_t lut_buffer[LUT_PREC*LUT_SIZE];
+
+              //for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch++)
+              for (i_ker_y = ker_y_start; i_ker_y < ker_y_end; i_ker_y++)
+              {
+                for (i_ker_x = ker_x_start; i_ker_x < ker_x_end; i_ker_x++)
+                {
+                  const int32_t in_row = base_idx_y + i_ker_y; 
+                  const int32_t in_col = base_idx_x + i_ker_x;
+
+                  for (i_input_ch = 0; i_input_ch < input_ch; i_input_ch = i_input_ch + FW_GRAN)
+                  {
+                    //index generation, one index per bit plane of the 8 input channels of the block
+                    lut_nn_bitplane_index(input_data + (in_row * input_x + in_col) * input_ch + i_input_ch, input_offset, LUT_PREC, input_index);
+                    //copy the corresponding lut block of each bit from flash to ram
+                    //The overhead of this memcopy will be compenstated by sharing it across all filters
+                    for(int bit = 0; bit < LUT_PREC; bit++){
+                      memcpy(lut_buffer + bit*LUT_SIZE, filter_pool_data + input_index[bit]*LUT_SIZE, LUT_SIZE);
+                    }
+                    //loop through different filters of the same channel to extract the results, so that the index can be shared
+                    for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                    {
+                      partial_sum = 0; //reset the conv_out for each kernel
+                      logical_kernel_idx = output_ch * block_cnt + i_out_ch;//get the current logical kernel index to find the corresponding physical kenrel in kernel pool
+                      physical_kernel_idx = kernel_idx[logical_kernel_idx];
+                      //Loop for bit-serial processing, total iteration is the precision used
+                      //need to shift according to the bit precision as well
+                      for(int bit = 0; bit < LUT_PREC; bit++)
+                      {
+                        result_idx = bit*LUT_SIZE + physical_kernel_idx;               
+                        partial_sum += ((int16_t)(lut_buffer[result_idx])<<bit);
+                      }
+                      conv_out_holder[i_out_ch] += partial_sum; //accumulate the partial sums to the output result holder                  
+                    }
+                    block_cnt++;
+                  }
+                }
+              }
+              //write the results into output array, make it outside the channel loop so that it won't be repeated
+              //or can writ e a condition inside the previous loop and only process the following code if its the last channel, but need to repeat the comparison every time.
+              for (i_out_ch = 0; i_out_ch < output_ch; i_out_ch++) 
+              {
+                if (bias_data)
+                {
+                    conv_out_holder[i_out_ch] += bias_data[i_out_ch];
+                }
+                conv_out_holder[i_out_ch] = arm_nn_requantize(conv_out_holder[i_out_ch], output_mult[i_out_ch], output_shift[i_out_ch]);
+                conv_out_holder[i_out_ch] += out_offset;
+                conv_out_holder[i_out_ch] = MAX(conv_out_holder[i_out_ch], out_activation_min);
+                conv_out_holder[i_out_ch] = MIN(conv_out_holder[i_out_ch], out_activation_max);
+                output_data[i_out_ch + (i_out_y * output_x + i_out_x) * output_ch] = (int8_t)conv_out_holder[i_out_ch];
+              }
+          }
+      }
+      /* Advance to the next batch */
+      input_data += (input_x * input_y * input_ch);
+      output_data += (output_x * output_y * output_ch);
+    }
+    if (holder_owned)
+    {
+      free(conv_out_holder);
+    }
 
 
     /* Return to application */
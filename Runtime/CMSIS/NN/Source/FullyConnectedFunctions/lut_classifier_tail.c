@@ -0,0 +1,161 @@
+/*
+Fused classifier tail of a weight pool network: global average pool of the last feature map, LUT fully connected layer
+and softmax, reported as the top-k classes without a logit or probability tensor.
+
+The feature map is pooled one 8-channel block at a time (rounded like arm_avgpool_s8) and the bit-plane indices of
+each pooled block are generated straight away, so neither the channel sums nor the pooled vector are kept. Then the FC runs class by class straight from the LUT, so each int8 logit is final as soon
+as it is computed. It goes into the top-k list and into a 256-bin histogram of logit values. arm_softmax_s8 only needs
+the maximum logit and the sum of exp(logit - max) over all classes, and both come out of the histogram exactly, so the
+top-k probabilities are the ones arm_softmax_s8 would write, whatever the number of classes.
+
+ctx->buf holds only the bit-plane indices, one uint8 per block and bit plane (the rows are 8-bit, FW_GRAN 8): C / 8 *
+LUT_PREC bytes, 160 B for 256 channels. The unfused chain needs the pooled vector, the logits and the FC accumulators,
+C + 6 * num_classes bytes, so the fused tail never needs more scratch.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_TAIL_ACCUM_BITS 12 //ACCUM_BITS of arm_softmax_s8
+
+int32_t lut_classifier_tail_get_buffer_size(const cmsis_nn_dims *input_dims)
+{
+  return (input_dims->c / FW_GRAN) * LUT_PREC;
+}
+
+//softmax term of a logit diff_min or more below the maximum, as arm_softmax_s8
+static int32_t softmax_exp(const lut_tail_params *params, const int32_t diff)
+{
+  return EXP_ON_NEG(MUL_SAT(diff * (1 << params->softmax_shift), params->softmax_mult));
+}
+
+arm_status lut_classifier_tail(const cmsis_nn_context *ctx,
+                               const lut_tail_params *params,
+                               const cmsis_nn_dims *input_dims,
+                               const q7_t *input,
+                               const int32_t num_classes,
+                               const uint8_t *filter_pool_data,
+                               const int32_t k,
+                               int32_t *top_classes,
+                               q7_t *top_scores)
+{
+  const int32_t ch = input_dims->c;
+  const int32_t pixels = input_dims->h * input_dims->w;
+  const int32_t blocks = ch / FW_GRAN;
+  if (ch % FW_GRAN != 0)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+  if (k < 1 || k > num_classes || pixels < 1 || ctx->buf == NULL ||
+      ctx->size < lut_classifier_tail_get_buffer_size(input_dims))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  uint8_t *indices = (uint8_t *)ctx->buf;
+
+  //global average pool block by block, the block sums and the pooled block stay on the stack
+  for (int32_t blk = 0; blk < blocks; blk++)
+  {
+    int32_t sums[FW_GRAN];
+    q7_t pooled[FW_GRAN];
+    uint16_t rows[LUT_PREC];
+    memset(sums, 0, sizeof(sums));
+    const q7_t *in = input + blk * FW_GRAN;
+    for (int32_t pix = 0; pix < pixels; pix++)
+    {
+      for (int32_t c = 0; c < FW_GRAN; c++)
+      {
+        sums[c] += in[c];
+      }
+      in += ch;
+    }
+    for (int32_t c = 0; c < FW_GRAN; c++)
+    {
+      int32_t avg = sums[c] > 0 ? (sums[c] + pixels / 2) / pixels : (sums[c] - pixels / 2) / pixels;
+      avg = MAX(avg, params->pool_activation.min);
+      avg = MIN(avg, params->pool_activation.max);
+      pooled[c] = (q7_t)avg;
+    }
+    lut_nn_bitplane_index(pooled, params->fc_params.input_offset, LUT_PREC, rows);
+    for (int bit = 0; bit < LUT_PREC; bit++)
+    {
+      indices[blk * LUT_PREC + bit] = (uint8_t)rows[bit];
+    }
+  }
+
+  //FC one class at a time, the logits only go to the histogram and the top-k list
+  int32_t hist[256];
+  memset(hist, 0, sizeof(hist));
+  for (int32_t n = 0; n < num_classes; n++)
+  {
+    int32_t acc = 0;
+    for (int32_t blk = 0; blk < blocks; blk++)
+    {
+      //column of the physical kernel, read at the rows of the block
+      const uint8_t *column = filter_pool_data + params->kernel_idx[blk * num_classes + n];
+      const uint8_t *blk_indices = indices + blk * LUT_PREC;
+      int32_t partial_sum = 0;
+      for (int bit = 0; bit < LUT_PREC; bit++)
+      {
+        partial_sum += ((int32_t)column[blk_indices[bit] * LUT_SIZE]) << bit;
+      }
+      if (params->coeffs)
+      {
+        partial_sum *= params->coeffs[blk * num_classes + n];
+      }
+      acc += partial_sum;
+    }
+    if (params->bias)
+    {
+      acc += params->bias[n];
+    }
+    acc = arm_nn_requantize(acc, params->fc_quant_params.multiplier[n], params->fc_quant_params.shift[n]);
+    acc += params->fc_params.output_offset;
+    acc = MAX(acc, params->fc_params.activation.min);
+    acc = MIN(acc, params->fc_params.activation.max);
+    hist[acc + 128]++;
+
+    //insertion into the sorted top-k, earlier classes win ties like a stable sort
+    const int32_t filled = MIN(n, k);
+    if (filled == k && acc <= top_scores[k - 1])
+    {
+      continue;
+    }
+    int32_t pos = filled == k ? k - 1 : filled;
+    while (pos > 0 && top_scores[pos - 1] < acc)
+    {
+      top_scores[pos] = top_scores[pos - 1];
+      top_classes[pos] = top_classes[pos - 1];
+      pos--;
+    }
+    top_scores[pos] = (q7_t)acc;
+    top_classes[pos] = n;
+  }
+
+  if (params->softmax)
+  {
+    //same sum and scale as arm_softmax_s8, from the histogram
+    const int32_t max = top_scores[0];
+    int32_t sum = 0;
+    for (int32_t v = -128; v <= max; v++)
+    {
+      if (hist[v + 128] && v - max >= params->softmax_diff_min)
+      {
+        sum += hist[v + 128] * DIV_POW2(softmax_exp(params, v - max), LUT_TAIL_ACCUM_BITS);
+      }
+    }
+    const int32_t headroom = __CLZ(sum);
+    const int32_t bits_over_unit = LUT_TAIL_ACCUM_BITS - headroom + 23;
+    const int32_t shifted_scale = ONE_OVER1((sum > 0 ? sum << headroom : 0) - (1 << 31));
+    for (int32_t i = 0; i < k; i++)
+    {
+      const int32_t diff = top_scores[i] - max;
+      int32_t res = -128;
+      if (diff >= params->softmax_diff_min)
+      {
+        res = DIV_POW2(MUL_SAT(shifted_scale, softmax_exp(params, diff)), bits_over_unit) - 128;
+      }
+      top_scores[i] = (q7_t)CLAMP(res, (int32_t)127, (int32_t)-128);
+    }
+  }
+  return ARM_MATH_SUCCESS;
+}
@@ -6,10 +6,8 @@
 #define GETBIT(var, bit)	(((var) >> (bit)) & 1)
 #define SETBIT(var, bit)	var |= (1 << (bit))
 
-//#include "arm_nnfunctions.h"
-//#include "arm_nnsupportfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnsupportfunctions.h"
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
 
 
 /*
@@ -0,0 +1,112 @@
+/*
+Weight pool fully connected layer using the same lookup table layout as the lut_conv_zdim_* kernels, so that a network
+can share one filter_pool_data between its conv layers and its classifier.
+The input vector is split in blocks of 8 consecutive values, block i of neuron n uses the physical kernel
+kernel_idx[num_neurons * i + n] (block major, like the conv kernels). For every block the bit-plane indices are
+generated once, the LUT rows are copied to ram and shared by all neurons.
+
+Differences with lut_fully_connected_v1_withcoeff: conv LUT layout (row input_index * LUT_SIZE, column kernel),
+per-channel requantization, coeffs are optional, and 32-bit accumulators since an FC layer can have many more
+blocks than a conv pixel.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+#include <stdlib.h>
+
+int32_t lut_fully_connected_zdim_get_buffer_size(const cmsis_nn_dims *output_dims)
+{
+  return output_dims->c * (int32_t)sizeof(int32_t);
+}
+
+arm_status lut_fully_connected_zdim(const cmsis_nn_context *ctx,
+                                    const cmsis_nn_fc_params *fc_params,
+                                    const cmsis_nn_per_channel_quant_params *quant_params,
+                                    const cmsis_nn_dims *input_dims,
+                                    const q7_t *input,
+                                    const cmsis_nn_dims *filter_dims,
+                                    const uint8_t *kernel_idx,
+                                    const cmsis_nn_dims *bias_dims,
+                                    const int32_t *bias,
+                                    const cmsis_nn_dims *output_dims,
+                                    const uint8_t *filter_pool_data,
+                                    const uint8_t *coeffs,
+                                    q7_t *output)
+{
+  (void)bias_dims;
+
+  const int32_t batches = input_dims->n;
+  const int32_t accum_depth = filter_dims->n;
+  const int32_t num_neurons = output_dims->c;
+  const int32_t *output_mult = quant_params->multiplier;
+  const int32_t *output_shift = quant_params->shift;
+
+  if (accum_depth % FW_GRAN != 0)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+
+  const int32_t holder_size = lut_fully_connected_zdim_get_buffer_size(output_dims);
+  const int32_t holder_owned = ctx->buf == NULL || ctx->size < holder_size;
+  int32_t *acc = holder_owned ? (int32_t *)malloc(holder_size) : (int32_t *)ctx->buf;
+  if (acc == NULL)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  uint16_t input_index[LUT_PREC];
+  uint8_t lut_buffer[LUT_PREC * LUT_SIZE];
+
+  for (int32_t i_batch = 0; i_batch < batches; i_batch++)
+  {
+    memset(acc, 0, num_neurons * sizeof(int32_t));
+
+    for (int32_t blk = 0; blk < accum_depth / FW_GRAN; blk++)
+    {
+      lut_nn_bitplane_index(input + blk * FW_GRAN, fc_params->input_offset, LUT_PREC, input_index);
+      //copy the lut rows of this block once, shared by all neurons
+      for (int bit = 0; bit < LUT_PREC; bit++)
+      {
+        memcpy(lut_buffer + bit * LUT_SIZE, filter_pool_data + input_index[bit] * LUT_SIZE, LUT_SIZE);
+      }
+
+      const uint8_t *blk_idx = kernel_idx + blk * num_neurons;
+      const uint8_t *blk_coeffs = coeffs ? coeffs + blk * num_neurons : NULL;
+      for (int32_t i_neuron = 0; i_neuron < num_neurons; i_neuron++)
+      {
+        const uint8_t physical_kernel_idx = blk_idx[i_neuron];
+        int32_t partial_sum = 0;
+        for (int bit = 0; bit < LUT_PREC; bit++)
+        {
+          partial_sum += ((int32_t)lut_buffer[bit * LUT_SIZE + physical_kernel_idx]) << bit;
+        }
+        if (blk_coeffs)
+        {
+          partial_sum *= blk_coeffs[i_neuron];
+        }
+        acc[i_neuron] += partial_sum;
+      }
+    }
+
+    for (int32_t i_neuron = 0; i_neuron < num_neurons; i_neuron++)
+    {
+      int32_t out = acc[i_neuron];
+      if (bias)
+      {
+        out += bias[i_neuron];
+      }
+      out = arm_nn_requantize(out, output_mult[i_neuron], output_shift[i_neuron]);
+      out += fc_params->output_offset;
+      out = MAX(out, fc_params->activation.min);
+      out = MIN(out, fc_params->activation.max);
+      output[i_neuron] = (q7_t)out;
+    }
+
+    input += accum_depth;
+    output += num_neurons;
+  }
+
+  if (holder_owned)
+  {
+    free(acc);
+  }
+  return ARM_MATH_SUCCESS;
+}
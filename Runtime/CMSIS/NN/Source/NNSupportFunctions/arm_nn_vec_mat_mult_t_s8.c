@@ -28,8 +28,7 @@
  *
  * -------------------------------------------------------------------- */
 
-//#include "arm_nnsupportfunctions.h"
-#include "D:\research\fixedweightNN\CMSIS_5-develop\CMSIS_5-develop\CMSIS\NN\Include\arm_nnsupportfunctions.h"
+#include "arm_nnsupportfunctions.h"
 
 /**
  * @ingroup groupSupport
@@ -0,0 +1,39 @@
+/*
+Packed n-bit activation tensors (lut_pack_params): the LUT kernels only use the low LUT_PREC bits of every activation,
+and after a clamped relu most layers need even fewer, so intermediate tensors can be stored with 4 (or 1, 2) bits per
+value instead of a byte. The _packed kernels read and write this layout directly, these functions convert at the
+boundaries with the q7 layers and size the buffers.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+int32_t lut_packed_get_size(const int32_t count, const lut_pack_params *pack)
+{
+  return (count * pack->bits + 7) / 8;
+}
+
+arm_status lut_pack_s8(const q7_t *input, const int32_t count, const lut_pack_params *pack, uint8_t *packed)
+{
+  if (pack->bits != 1 && pack->bits != 2 && pack->bits != 4 && pack->bits != 8)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  for (int32_t i = 0; i < count; i++)
+  {
+    lut_nn_packed_set(packed, i, pack->bits, (uint8_t)(input[i] + pack->offset));
+  }
+  return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_unpack_s8(const uint8_t *packed, const int32_t count, const lut_pack_params *pack, q7_t *output)
+{
+  if (pack->bits != 1 && pack->bits != 2 && pack->bits != 4 && pack->bits != 8)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  for (int32_t i = 0; i < count; i++)
+  {
+    output[i] = (q7_t)(lut_nn_packed_get(packed, i, pack->bits) - pack->offset);
+  }
+  return ARM_MATH_SUCCESS;
+}
@@ -0,0 +1,98 @@
+/*
+SRAM row cache of the weight pool lookup table, for pools whose LUT does not fit in SRAM (e.g. 256 x 128 bytes).
+The LUT kernels copy LUT_PREC rows per (pixel, block) from flash, and after a relu most of these rows are the same
+few indices (high bit planes are mostly zero, so row 0 and the rows with one or two bits set dominate). The cache keeps
+recently used rows in SRAM so that the _cached kernels read them in place, only misses go to flash.
+Lookup is inline (lut_row_cache_fetch in arm_nnsupportfunctions.h), this file sizes, resets and pre-warms the cache.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_ROW_CACHE_ROWS 256 //one row per 8-bit index
+
+//stamps, tags and rows of one slot, stamps first so that every array stays aligned
+#define LUT_ROW_CACHE_SLOT_SIZE (sizeof(uint32_t) + sizeof(uint16_t) + LUT_SIZE)
+
+int32_t lut_row_cache_get_buffer_size(const int32_t sets, const int32_t ways)
+{
+  return sets * ways * (int32_t)LUT_ROW_CACHE_SLOT_SIZE;
+}
+
+arm_status lut_row_cache_init(lut_row_cache *cache, void *buf, const int32_t size, const int32_t ways,
+                              const uint8_t *lut)
+{
+  if (ways < 1 || ways > LUT_ROW_CACHE_MAX_WAYS || ((uintptr_t)buf & 3) != 0)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  //largest power of two number of sets that fits, more than 256 / ways sets would never be used
+  int32_t sets = 1;
+  while (sets * 2 * ways <= LUT_ROW_CACHE_ROWS && lut_row_cache_get_buffer_size(sets * 2, ways) <= size)
+  {
+    sets *= 2;
+  }
+  if (lut_row_cache_get_buffer_size(sets, ways) > size)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+  const int32_t slots = sets * ways;
+  cache->lut = lut;
+  cache->stamps = (uint32_t *)buf;
+  cache->tags = (uint16_t *)(cache->stamps + slots);
+  cache->rows = (uint8_t *)(cache->tags + slots);
+  cache->row_size = LUT_SIZE;
+  cache->sets = sets;
+  cache->ways = ways;
+  cache->row_count = NULL;
+  lut_row_cache_reset(cache);
+  return ARM_MATH_SUCCESS;
+}
+
+void lut_row_cache_reset(lut_row_cache *cache)
+{
+  for (int32_t s = 0; s < cache->sets * cache->ways; s++)
+  {
+    cache->tags[s] = LUT_ROW_CACHE_EMPTY;
+    cache->stamps[s] = 0;
+  }
+  cache->epoch = 1;
+  cache->hits = 0;
+  cache->misses = 0;
+}
+
+void lut_row_cache_warm(lut_row_cache *cache, const uint32_t *row_count, const int32_t pin)
+{
+  lut_row_cache_reset(cache);
+  for (int32_t set = 0; set < cache->sets; set++)
+  {
+    //the ways most used rows of the set, by insertion into a small sorted list
+    int32_t best[LUT_ROW_CACHE_MAX_WAYS];
+    int32_t found = 0;
+    for (int32_t row = set; row < LUT_ROW_CACHE_ROWS; row += cache->sets)
+    {
+      if (row_count[row] == 0)
+      {
+        continue;
+      }
+      int32_t pos = MIN(found, cache->ways - 1);
+      if (found == cache->ways && row_count[row] <= row_count[best[pos]])
+      {
+        continue;
+      }
+      for (; pos > 0 && row_count[best[pos - 1]] < row_count[row]; pos--)
+      {
+        best[pos] = best[pos - 1];
+      }
+      best[pos] = row;
+      found = MIN(found + 1, cache->ways);
+    }
+    for (int32_t way = 0; way < found; way++)
+    {
+      //most used row in the last way, equal ages are replaced from way 0 (empty ways first)
+      const int32_t slot = set * cache->ways + cache->ways - 1 - way;
+      cache->tags[slot] = best[way];
+      cache->stamps[slot] = pin ? LUT_ROW_CACHE_PINNED : 0;
+      memcpy(cache->rows + slot * cache->row_size, cache->lut + best[way] * cache->row_size, cache->row_size);
+    }
+  }
+}
@@ -0,0 +1,202 @@
+/*
+Binary weight pool models: one aligned file holding the lookup table, the layer table and the per layer data
+(indices, coefficients, bias, requantization parameters, dense weights) instead of a set of C headers.
+Written by Runtime/model_pack.py, layout in lut_model_header / lut_model_layer (arm_nn_types.h).
+
+lut_model_load only builds the lut_layer table: every pointer of the table points into the model, nothing is copied.
+The model can be a file mapped with lut_model_map (host, LUT_HOST_MMAP) or a flash address on the MCU, where the
+kernels then read the indices and the LUT in place (XIP). The model must stay valid while the table is used.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_MODEL_ROWS 256 //one row per 8-bit input index
+
+//bitwise CRC-32 (zlib polynomial), only run once at load time so no table is kept in flash
+static uint32_t lut_model_crc32(const uint8_t *data, const uint32_t size)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  for (uint32_t i = 0; i < size; i++)
+  {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++)
+    {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+//check that [offset, offset + bytes) is inside the model and aligned, offset 0 is only allowed when bytes is 0
+static int lut_model_section_ok(const lut_model_header *header, const uint32_t offset, const uint32_t bytes,
+                                const int required)
+{
+  if (offset == 0)
+  {
+    return !required;
+  }
+  return (offset & 3) == 0 && offset >= sizeof(lut_model_header) && offset <= header->size &&
+         bytes <= header->size - offset;
+}
+
+//check the blob before any header field is read: large enough for the header, aligned, and a model of this version
+//that fits in size bytes
+static int lut_model_header_ok(const uint8_t *model, const int32_t size)
+{
+  if (model == NULL || size < (int32_t)sizeof(lut_model_header) || ((uintptr_t)model & 3) != 0)
+  {
+    return 0;
+  }
+  const lut_model_header *header = (const lut_model_header *)model;
+  return header->magic == LUT_MODEL_MAGIC && header->version == LUT_MODEL_VERSION && header->size <= (uint32_t)size;
+}
+
+int32_t lut_model_get_num_layers(const uint8_t *model, const int32_t size)
+{
+  if (!lut_model_header_ok(model, size))
+  {
+    return 0;
+  }
+  const lut_model_header *header = (const lut_model_header *)model;
+  return header->num_layers > 0 ? header->num_layers : 0;
+}
+
+arm_status lut_model_load(const uint8_t *model,
+                          const int32_t size,
+                          const int32_t check_crc,
+                          lut_layer *layers,
+                          const int32_t max_layers,
+                          lut_network *net)
+{
+  if (!lut_model_header_ok(model, size))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  const lut_model_header *header = (const lut_model_header *)model;
+  if (header->lut_size != LUT_SIZE || header->num_layers > max_layers)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+  if (check_crc &&
+      lut_model_crc32(model + sizeof(lut_model_header), header->size - sizeof(lut_model_header)) != header->crc32)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  if (header->num_layers < 0 ||
+      !lut_model_section_ok(header, header->lut_offset, LUT_MODEL_ROWS * LUT_SIZE, 1) ||
+      !lut_model_section_ok(header, header->layers_offset, header->num_layers * sizeof(lut_model_layer), 1))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  const lut_model_layer *records = (const lut_model_layer *)(model + header->layers_offset);
+  for (int32_t i = 0; i < header->num_layers; i++)
+  {
+    const lut_model_layer *r = &records[i];
+    lut_layer *layer = &layers[i];
+    const uint32_t channels = r->output_dims.c;
+    uint32_t idx_count = 0;
+    uint32_t weight_count = 0;
+    int quantized = 1;
+
+    switch (r->type)
+    {
+      case LUT_LAYER_CONV_S8:
+        weight_count = r->filter_dims.h * r->filter_dims.w * r->input_dims.c * channels;
+        break;
+      case LUT_LAYER_LUT_CONV_V1:
+      case LUT_LAYER_LUT_CONV_V2:
+      case LUT_LAYER_LUT_CONV_V2_COEFF:
+      case LUT_LAYER_LUT_CONV_V2_COEFF_SHIFT:
+      case LUT_LAYER_LUT_CONV_V1_SPARSE:
+      case LUT_LAYER_LUT_CONV_V2_SPARSE:
+      case LUT_LAYER_LUT_CONV_V1_DYNPREC:
+      case LUT_LAYER_LUT_CONV_V2_DYNPREC:
+        idx_count = r->filter_dims.h * r->filter_dims.w * (r->input_dims.c / 8) * channels;
+        break;
+      case LUT_LAYER_LUT_FC:
+        idx_count = r->input_dims.h * r->input_dims.w * r->input_dims.c / 8 * channels;
+        break;
+      case LUT_LAYER_MAX_POOL_S8:
+        quantized = 0;
+        break;
+      default:
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+    const int coeffs_required = r->type == LUT_LAYER_LUT_CONV_V2_COEFF || r->type == LUT_LAYER_LUT_CONV_V2_COEFF_SHIFT;
+    if (!lut_model_section_ok(header, r->mult_offset, channels * sizeof(int32_t), quantized) ||
+        !lut_model_section_ok(header, r->shift_offset, channels * sizeof(int32_t), quantized) ||
+        !lut_model_section_ok(header, r->bias_offset, channels * sizeof(int32_t), 0) ||
+        !lut_model_section_ok(header, r->kernel_idx_offset, idx_count, idx_count > 0) ||
+        !lut_model_section_ok(header, r->coeffs_offset, idx_count, coeffs_required) ||
+        !lut_model_section_ok(header, r->weights_offset, weight_count, weight_count > 0))
+    {
+      return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    layer->type = (lut_layer_type)r->type;
+    layer->conv_params.input_offset = r->input_offset;
+    layer->conv_params.output_offset = r->output_offset;
+    layer->conv_params.stride.w = r->stride_w;
+    layer->conv_params.stride.h = r->stride_h;
+    layer->conv_params.padding.w = r->pad_w;
+    layer->conv_params.padding.h = r->pad_h;
+    layer->conv_params.dilation.w = 1;
+    layer->conv_params.dilation.h = 1;
+    layer->conv_params.activation.min = r->act_min;
+    layer->conv_params.activation.max = r->act_max;
+    layer->input_dims = r->input_dims;
+    layer->filter_dims = r->filter_dims;
+    layer->output_dims = r->output_dims;
+    //the kernels never write the quantization parameters, the cast only drops const for cmsis_nn_per_channel_quant_params
+    layer->quant_params.multiplier = r->mult_offset ? (int32_t *)(model + r->mult_offset) : NULL;
+    layer->quant_params.shift = r->shift_offset ? (int32_t *)(model + r->shift_offset) : NULL;
+    layer->bias_data = r->bias_offset ? (const int32_t *)(model + r->bias_offset) : NULL;
+    layer->kernel_idx = r->kernel_idx_offset ? model + r->kernel_idx_offset : NULL;
+    layer->coeffs = r->coeffs_offset ? model + r->coeffs_offset : NULL;
+    layer->weights = r->weights_offset ? (const int8_t *)(model + r->weights_offset) : NULL;
+    layer->kernel = NULL;
+  }
+
+  net->layers = layers;
+  net->num_layers = header->num_layers;
+  net->filter_pool_data = model + header->lut_offset;
+  return ARM_MATH_SUCCESS;
+}
+
+#if defined(LUT_HOST_MMAP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+arm_status lut_model_map(const char *path, const uint8_t **model, int32_t *size)
+{
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(lut_model_header) || st.st_size > INT32_MAX)
+  {
+    close(fd);
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  //read-only shared mapping, pages are loaded on first use and shared by every process running the model
+  void *data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  *model = (const uint8_t *)data;
+  *size = (int32_t)st.st_size;
+  return ARM_MATH_SUCCESS;
+}
+
+void lut_model_unmap(const uint8_t *model, const int32_t size)
+{
+  munmap((void *)model, size);
+}
+#endif // LUT_HOST_MMAP
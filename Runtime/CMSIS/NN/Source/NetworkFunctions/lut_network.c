@@ -0,0 +1,224 @@
+/*
+Layer table support for weight pool networks.
+A layer of the table can be run on a band of output rows: the kernel is called on a view that only contains the input
+rows needed for that band, with the vertical padding adjusted so that the band comes out exactly as it would from the
+full layer. The band executors (row streaming, multi-threading, time slicing) are all built on top of this.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+int32_t lut_layer_input_row_start(const lut_layer *layer, const int32_t out_row)
+{
+  return MAX(0, out_row * layer->conv_params.stride.h - layer->conv_params.padding.h);
+}
+
+int32_t lut_layer_input_row_end(const lut_layer *layer, const int32_t out_row)
+{
+  const int32_t end = out_row * layer->conv_params.stride.h - layer->conv_params.padding.h + layer->filter_dims.h;
+  return MIN(layer->input_dims.h, end);
+}
+
+int32_t lut_layer_get_buffer_size(const lut_layer *layer)
+{
+  switch (layer->type)
+  {
+    case LUT_LAYER_CONV_S8:
+      return arm_convolve_s8_get_buffer_size(&layer->input_dims, &layer->filter_dims);
+    case LUT_LAYER_LUT_CONV_V1:
+    case LUT_LAYER_LUT_CONV_V2:
+    case LUT_LAYER_LUT_CONV_V1_SPARSE:
+    case LUT_LAYER_LUT_CONV_V2_SPARSE:
+    case LUT_LAYER_LUT_CONV_V1_DYNPREC:
+    case LUT_LAYER_LUT_CONV_V2_DYNPREC:
+      return lut_conv_zdim_get_buffer_size(&layer->output_dims);
+    case LUT_LAYER_LUT_CONV_V2_COEFF:
+    case LUT_LAYER_LUT_CONV_V2_COEFF_SHIFT:
+      return lut_conv_zdim_coeff_get_buffer_size(&layer->output_dims);
+    case LUT_LAYER_LUT_FC:
+      return lut_fully_connected_zdim_get_buffer_size(&layer->output_dims);
+    default:
+      return 0;
+  }
+}
+
+arm_status lut_layer_run_rows(const cmsis_nn_context *ctx,
+                              const lut_layer *layer,
+                              const uint8_t *filter_pool_data,
+                              const q7_t *input_data,
+                              const int32_t out_row_start,
+                              const int32_t out_rows,
+                              q7_t *output_data)
+{
+  const int32_t in_row_start = lut_layer_input_row_start(layer, out_row_start);
+  const int32_t in_row_end = lut_layer_input_row_end(layer, out_row_start + out_rows - 1);
+
+  //view of the band: only the rows that are present, padding moved so that output row 0 of the view lines up
+  //with out_row_start of the full layer
+  cmsis_nn_conv_params conv_params = layer->conv_params;
+  conv_params.padding.h = in_row_start - out_row_start * conv_params.stride.h + layer->conv_params.padding.h;
+
+  cmsis_nn_dims input_dims = layer->input_dims;
+  input_dims.n = 1;
+  input_dims.h = in_row_end - in_row_start;
+  cmsis_nn_dims output_dims = layer->output_dims;
+  output_dims.n = 1;
+  output_dims.h = out_rows;
+  cmsis_nn_dims bias_dims = {1, 1, 1, layer->output_dims.c};
+
+  //generated shape specialised kernel, same arguments as the generic one
+  if (layer->kernel && (layer->type == LUT_LAYER_LUT_CONV_V1 || layer->type == LUT_LAYER_LUT_CONV_V2))
+  {
+    return layer->kernel(ctx,
+                         &conv_params,
+                         &layer->quant_params,
+                         &input_dims,
+                         input_data,
+                         &layer->filter_dims,
+                         layer->kernel_idx,
+                         &bias_dims,
+                         layer->bias_data,
+                         &output_dims,
+                         filter_pool_data,
+                         output_data);
+  }
+
+  switch (layer->type)
+  {
+    case LUT_LAYER_CONV_S8:
+      return arm_convolve_s8(ctx,
+                             &conv_params,
+                             &layer->quant_params,
+                             &input_dims,
+                             input_data,
+                             &layer->filter_dims,
+                             layer->weights,
+                             &bias_dims,
+                             layer->bias_data,
+                             &output_dims,
+                             output_data);
+    case LUT_LAYER_LUT_CONV_V1:
+      return lut_conv_zdim_v1(ctx,
+                              &conv_params,
+                              &layer->quant_params,
+                              &input_dims,
+                              input_data,
+                              &layer->filter_dims,
+                              layer->kernel_idx,
+                              &bias_dims,
+                              layer->bias_data,
+                              &output_dims,
+                              filter_pool_data,
+                              output_data);
+    case LUT_LAYER_LUT_CONV_V2:
+      return lut_conv_zdim_v2_double_lookup(ctx,
+                                            &conv_params,
+                                            &layer->quant_params,
+                                            &input_dims,
+                                            input_data,
+                                            &layer->filter_dims,
+                                            layer->kernel_idx,
+                                            &bias_dims,
+                                            layer->bias_data,
+                                            &output_dims,
+                                            filter_pool_data,
+                                            output_data);
+    case LUT_LAYER_LUT_CONV_V1_SPARSE:
+    case LUT_LAYER_LUT_CONV_V2_SPARSE:
+      return (layer->type == LUT_LAYER_LUT_CONV_V1_SPARSE ? lut_conv_zdim_v1_sparse : lut_conv_zdim_v2_sparse)(
+          ctx,
+          &conv_params,
+          &layer->quant_params,
+          &input_dims,
+          input_data,
+          &layer->filter_dims,
+          layer->kernel_idx,
+          &bias_dims,
+          layer->bias_data,
+          &output_dims,
+          filter_pool_data,
+          NULL,
+          output_data);
+    case LUT_LAYER_LUT_CONV_V1_DYNPREC:
+    case LUT_LAYER_LUT_CONV_V2_DYNPREC:
+      return (layer->type == LUT_LAYER_LUT_CONV_V1_DYNPREC ? lut_conv_zdim_v1_dynprec : lut_conv_zdim_v2_dynprec)(
+          ctx,
+          &conv_params,
+          &layer->quant_params,
+          &input_dims,
+          input_data,
+          &layer->filter_dims,
+          layer->kernel_idx,
+          &bias_dims,
+          layer->bias_data,
+          &output_dims,
+          filter_pool_data,
+          NULL,
+          output_data);
+    case LUT_LAYER_LUT_CONV_V2_COEFF:
+      return lut_conv_zdim_v2_coeff(ctx,
+                                    &conv_params,
+                                    &layer->quant_params,
+                                    &input_dims,
+                                    input_data,
+                                    &layer->filter_dims,
+                                    layer->kernel_idx,
+                                    &bias_dims,
+                                    layer->bias_data,
+                                    &output_dims,
+                                    filter_pool_data,
+                                    layer->coeffs,
+                                    output_data);
+    case LUT_LAYER_LUT_CONV_V2_COEFF_SHIFT:
+      return lut_conv_zdim_v2_coeff_shift(ctx,
+                                          &conv_params,
+                                          &layer->quant_params,
+                                          &input_dims,
+                                          input_data,
+                                          &layer->filter_dims,
+                                          layer->kernel_idx,
+                                          &bias_dims,
+                                          layer->bias_data,
+                                          &output_dims,
+                                          filter_pool_data,
+                                          layer->coeffs,
+                                          output_data);
+    case LUT_LAYER_MAX_POOL_S8:
+    {
+      cmsis_nn_pool_params pool_params;
+      pool_params.stride = conv_params.stride;
+      pool_params.padding = conv_params.padding;
+      pool_params.activation = conv_params.activation;
+      return arm_max_pool_s8(ctx, &pool_params, &input_dims, input_data, &layer->filter_dims, &output_dims, output_data);
+    }
+    case LUT_LAYER_LUT_FC:
+    {
+      //the filter covers the whole input, so the only band is the single output row
+      if (out_row_start != 0 || out_rows != 1)
+      {
+        return ARM_MATH_ARGUMENT_ERROR;
+      }
+      cmsis_nn_fc_params fc_params;
+      fc_params.input_offset = conv_params.input_offset;
+      fc_params.filter_offset = 0;
+      fc_params.output_offset = conv_params.output_offset;
+      fc_params.activation = conv_params.activation;
+      cmsis_nn_dims fc_input_dims = {1, 1, 1, input_dims.h * input_dims.w * input_dims.c};
+      cmsis_nn_dims fc_filter_dims = {fc_input_dims.c, 1, 1, layer->output_dims.c};
+      return lut_fully_connected_zdim(ctx,
+                                      &fc_params,
+                                      &layer->quant_params,
+                                      &fc_input_dims,
+                                      input_data,
+                                      &fc_filter_dims,
+                                      layer->kernel_idx,
+                                      &bias_dims,
+                                      layer->bias_data,
+                                      &output_dims,
+                                      filter_pool_data,
+                                      layer->coeffs,
+                                      output_data);
+    }
+    default:
+      return ARM_MATH_ARGUMENT_ERROR;
+  }
+}
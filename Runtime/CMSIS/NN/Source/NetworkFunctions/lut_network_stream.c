@@ -0,0 +1,162 @@
+/*
+Row-band (depth-first / layer-fused) execution of a weight pool network.
+Instead of computing every layer over the full tensor, the last layer pulls its output rows one at a time and each
+layer only computes an input row for the next layer when that row is needed. Every intermediate tensor is kept in a
+window of kernel_y rows, so for resnet_10 the 32x32x64 first layer output never exists in full.
+
+ctx->buf layout: [window of layer 1 input][window of layer 2 input]...[kernel scratch]
+The first layer reads its input directly, so it can stay in flash.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_STREAM_MAX_LAYERS 32
+#define LUT_STREAM_ALIGN(x) (((x) + 3) & ~3)
+
+typedef struct
+{
+  const lut_network *net;
+  const q7_t *input_data;
+  q7_t *output_data;
+  cmsis_nn_context scratch;
+  q7_t *window[LUT_STREAM_MAX_LAYERS];      //row window holding the input of layer i (i >= 1)
+  int32_t window_base[LUT_STREAM_MAX_LAYERS];//input row of layer i stored in the first slot of its window
+  int32_t next_row[LUT_STREAM_MAX_LAYERS];  //next output row layer i will produce
+} lut_stream_state;
+
+static int32_t row_bytes(const cmsis_nn_dims *dims)
+{
+  return dims->w * dims->c;
+}
+
+static int32_t window_rows(const lut_layer *layer)
+{
+  return MIN(layer->filter_dims.h, layer->input_dims.h);
+}
+
+int32_t lut_network_stream_get_buffer_size(const lut_network *net)
+{
+  int32_t size = 0;
+  int32_t scratch = 0;
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    const lut_layer *layer = &net->layers[i];
+    if (i > 0)
+    {
+      //keep the windows word aligned so the kernels can do word accesses on them
+      size += LUT_STREAM_ALIGN(window_rows(layer) * row_bytes(&layer->input_dims));
+    }
+    scratch = MAX(scratch, lut_layer_get_buffer_size(layer));
+  }
+  return size + scratch;
+}
+
+//make room for input row `row` in the window of layer i and return where it has to be written
+static q7_t *window_slot(lut_stream_state *state, const int32_t i, const int32_t row)
+{
+  const lut_layer *layer = &state->net->layers[i];
+  const int32_t rows = window_rows(layer);
+  const int32_t bytes = row_bytes(&layer->input_dims);
+
+  if (row - state->window_base[i] >= rows)
+  {
+    //every row below row - rows + 1 is above the window of the next output row of layer i, drop them
+    const int32_t shift = row - rows + 1 - state->window_base[i];
+    if (shift < rows)
+    {
+      memmove(state->window[i], state->window[i] + shift * bytes, (rows - shift) * bytes);
+    }
+    state->window_base[i] += shift;
+  }
+  return state->window[i] + (row - state->window_base[i]) * bytes;
+}
+
+static arm_status produce_row(lut_stream_state *state, const int32_t i)
+{
+  const lut_layer *layer = &state->net->layers[i];
+  const int32_t out_row = state->next_row[i];
+  const int32_t in_start = lut_layer_input_row_start(layer, out_row);
+  const int32_t in_end = lut_layer_input_row_end(layer, out_row);
+  const q7_t *src;
+  q7_t *dst;
+  arm_status status;
+
+  if (i == 0)
+  {
+    src = state->input_data + in_start * row_bytes(&layer->input_dims);
+  }
+  else
+  {
+    //pull rows from the previous layer until the whole window of this output row is available
+    while (state->next_row[i - 1] < in_end)
+    {
+      status = produce_row(state, i - 1);
+      if (status != ARM_MATH_SUCCESS)
+      {
+        return status;
+      }
+    }
+    src = state->window[i] + (in_start - state->window_base[i]) * row_bytes(&layer->input_dims);
+  }
+
+  if (i == state->net->num_layers - 1)
+  {
+    dst = state->output_data + out_row * row_bytes(&layer->output_dims);
+  }
+  else
+  {
+    dst = window_slot(state, i + 1, out_row);
+  }
+
+  status = lut_layer_run_rows(&state->scratch, layer, state->net->filter_pool_data, src, out_row, 1, dst);
+  state->next_row[i]++;
+  return status;
+}
+
+arm_status lut_network_stream_run(const cmsis_nn_context *ctx,
+                                  const lut_network *net,
+                                  const q7_t *input_data,
+                                  q7_t *output_data)
+{
+  if (net->num_layers < 1 || net->num_layers > LUT_STREAM_MAX_LAYERS ||
+      ctx->buf == NULL || ctx->size < lut_network_stream_get_buffer_size(net))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  lut_stream_state state;
+  q7_t *buf = (q7_t *)ctx->buf;
+  state.net = net;
+  state.input_data = input_data;
+  state.output_data = output_data;
+
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    const lut_layer *layer = &net->layers[i];
+    if (i > 0)
+    {
+      const cmsis_nn_dims *prev = &net->layers[i - 1].output_dims;
+      if (prev->h != layer->input_dims.h || prev->w != layer->input_dims.w || prev->c != layer->input_dims.c)
+      {
+        return ARM_MATH_ARGUMENT_ERROR;
+      }
+      state.window[i] = buf;
+      buf += LUT_STREAM_ALIGN(window_rows(layer) * row_bytes(&layer->input_dims));
+    }
+    state.window_base[i] = 0;
+    state.next_row[i] = 0;
+  }
+  state.scratch.buf = buf;
+  state.scratch.size = ctx->size - (int32_t)(buf - (q7_t *)ctx->buf);
+
+  const int32_t last = net->num_layers - 1;
+  while (state.next_row[last] < net->layers[last].output_dims.h)
+  {
+    const arm_status status = produce_row(&state, last);
+    if (status != ARM_MATH_SUCCESS)
+    {
+      return status;
+    }
+  }
+  return ARM_MATH_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/*
+Time-sliced execution of a weight pool network, for devices where inference shares the core with work that has
+deadlines (sensor acquisition, radio stacks). The run is cut into tiles of tile_rows output rows of one layer, computed
+with lut_layer_run_rows, and everything needed to resume lives in lut_network_task, so an RTOS task or a superloop can
+call lut_network_task_step with the time it can spare and go back to its other work in between.
+
+A step always runs at least one tile, then starts another one only if the last tile of the same layer says it fits in
+what is left of the budget. The first tile of a layer has no estimate yet, so a step also ends at every layer boundary.
+A step overruns its budget by at most one tile (max_tile_cycles).
+
+ctx->buf layout: [activation ping][activation pong][kernel scratch]
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_TASK_ALIGN(x) (((x) + 3) & ~3)
+
+static int32_t row_bytes(const cmsis_nn_dims *dims)
+{
+  return dims->w * dims->c;
+}
+
+static int32_t activation_size(const lut_network *net)
+{
+  int32_t act = 0;
+  for (int32_t i = 0; i < net->num_layers - 1; i++)
+  {
+    const cmsis_nn_dims *dims = &net->layers[i].output_dims;
+    act = MAX(act, LUT_TASK_ALIGN(dims->h * row_bytes(dims)));
+  }
+  return act;
+}
+
+int32_t lut_network_task_get_buffer_size(const lut_network *net)
+{
+  int32_t scratch = 0;
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    scratch = MAX(scratch, lut_layer_get_buffer_size(&net->layers[i]));
+  }
+  return 2 * activation_size(net) + scratch;
+}
+
+arm_status lut_network_task_init(lut_network_task *task,
+                                 const cmsis_nn_context *ctx,
+                                 const lut_network *net,
+                                 const q7_t *input_data,
+                                 q7_t *output_data,
+                                 const int32_t tile_rows,
+                                 lut_task_clock clock)
+{
+  if (net->num_layers < 1 || tile_rows < 1 || ctx->buf == NULL || ctx->size < lut_network_task_get_buffer_size(net))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+  for (int32_t i = 1; i < net->num_layers; i++)
+  {
+    const cmsis_nn_dims *prev = &net->layers[i - 1].output_dims;
+    const cmsis_nn_dims *dims = &net->layers[i].input_dims;
+    if (prev->h != dims->h || prev->w != dims->w || prev->c != dims->c)
+    {
+      return ARM_MATH_ARGUMENT_ERROR;
+    }
+  }
+
+  const int32_t act = activation_size(net);
+  task->net = net;
+  task->input_data = input_data;
+  task->output_data = output_data;
+  task->ping_pong[0] = (q7_t *)ctx->buf;
+  task->ping_pong[1] = (q7_t *)ctx->buf + act;
+  task->scratch.buf = (q7_t *)ctx->buf + 2 * act;
+  task->scratch.size = ctx->size - 2 * act;
+  task->clock = clock;
+  task->tile_rows = tile_rows;
+  task->layer = 0;
+  task->row = 0;
+  task->tile_cycles = 0;
+  task->steps = 0;
+  task->tiles = 0;
+  task->max_tile_cycles = 0;
+  task->overhead_cycles = 0;
+  return ARM_MATH_SUCCESS;
+}
+
+int32_t lut_network_task_done(const lut_network_task *task)
+{
+  return task->layer >= task->net->num_layers;
+}
+
+//run the next tile and move to the next one, *cycles is the time spent in the layer kernel (0 without a clock)
+static arm_status run_tile(lut_network_task *task, uint32_t *cycles)
+{
+  const lut_network *net = task->net;
+  const int32_t i = task->layer;
+  const lut_layer *layer = &net->layers[i];
+  const int32_t rows = MIN(task->tile_rows, layer->output_dims.h - task->row);
+  const int32_t in_row = lut_layer_input_row_start(layer, task->row);
+
+  const q7_t *src = i == 0 ? task->input_data : task->ping_pong[(i - 1) & 1];
+  q7_t *dst = i == net->num_layers - 1 ? task->output_data : task->ping_pong[i & 1];
+  src += in_row * row_bytes(&layer->input_dims);
+  dst += task->row * row_bytes(&layer->output_dims);
+
+  const uint32_t start = task->clock ? task->clock() : 0;
+  const arm_status status =
+      lut_layer_run_rows(&task->scratch, layer, net->filter_pool_data, src, task->row, rows, dst);
+  *cycles = task->clock ? task->clock() - start : 0;
+
+  task->tiles++;
+  task->max_tile_cycles = MAX(task->max_tile_cycles, *cycles);
+  task->tile_cycles = *cycles;
+  task->row += rows;
+  if (task->row >= layer->output_dims.h)
+  {
+    task->layer++;
+    task->row = 0;
+    task->tile_cycles = 0;
+  }
+  return status;
+}
+
+arm_status lut_network_task_step(lut_network_task *task, const uint32_t budget_cycles)
+{
+  if (lut_network_task_done(task))
+  {
+    return ARM_MATH_SUCCESS;
+  }
+  task->steps++;
+
+  uint32_t cycles;
+  arm_status status;
+  if (task->clock == NULL)
+  {
+    //no clock, the budget is a number of tiles
+    uint32_t tiles = 0;
+    do
+    {
+      status = run_tile(task, &cycles);
+    } while (status == ARM_MATH_SUCCESS && ++tiles < budget_cycles && !lut_network_task_done(task));
+    return status;
+  }
+
+  const uint32_t start = task->clock();
+  uint32_t kernel_cycles = 0;
+  uint32_t used;
+  do
+  {
+    status = run_tile(task, &cycles);
+    kernel_cycles += cycles;
+    used = task->clock() - start;
+    //stop at the end of a layer (cost of the next tile unknown) or when the next tile would not fit
+  } while (status == ARM_MATH_SUCCESS && task->tile_cycles != 0 && used + task->tile_cycles <= budget_cycles);
+  task->overhead_cycles += used - kernel_cycles;
+  return status;
+}
@@ -0,0 +1,301 @@
+/*
+Multi-threaded host backend for weight pool networks (Linux gateways, multi-core ARM/x86 hosts).
+Only built when LUT_HOST_THREADS is defined, the MCU targets never see pthreads.
+
+A fixed pool of workers is created once. A layer is split into contiguous bands of output rows, one per worker, and
+each band is computed with lut_layer_run_rows, so every worker runs the unmodified single-threaded kernels.
+Bands write disjoint parts of the output and nothing is accumulated across workers, so the result does not depend
+on the number of threads or on scheduling. Errors are reported in worker order.
+
+ctx->buf layout for lut_layer_run_parallel: [scratch of worker 0][scratch of worker 1]...
+ctx->buf layout for lut_network_run_parallel: [activation ping][activation pong][worker scratch]
+*/
+#if defined(LUT_HOST_THREADS)
+
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#define LUT_THREADS_ALIGN(x) (((x) + 15) & ~15)
+
+typedef struct
+{
+  const lut_layer *layer;
+  const uint8_t *filter_pool_data;
+  const q7_t *input_data;
+  q7_t *output_data;
+  q7_t *scratch;
+  int32_t scratch_size;
+  int32_t bands;
+} lut_parallel_job;
+
+struct lut_thread_pool
+{
+  int32_t num_threads;
+  pthread_t *threads;
+  arm_status *status;
+  pthread_mutex_t lock;
+  pthread_cond_t start;
+  pthread_cond_t done;
+  uint32_t generation; //incremented for every job, workers wait for it to change
+  int32_t pending;     //workers still running the current job
+  int32_t shutdown;
+  const lut_parallel_job *job;
+};
+
+typedef struct
+{
+  lut_thread_pool *pool;
+  int32_t id;
+} lut_worker_arg;
+
+static void run_band(const lut_parallel_job *job, const int32_t id, arm_status *status)
+{
+  const lut_layer *layer = job->layer;
+  const int32_t output_h = layer->output_dims.h;
+  //balanced split, the first output_h % bands bands get one extra row
+  const int32_t out_row_start = id * (output_h / job->bands) + MIN(id, output_h % job->bands);
+  const int32_t out_rows = output_h / job->bands + (id < output_h % job->bands ? 1 : 0);
+  const int32_t in_row_start = lut_layer_input_row_start(layer, out_row_start);
+  cmsis_nn_context ctx;
+
+  if (out_rows == 0)
+  {
+    *status = ARM_MATH_SUCCESS;
+    return;
+  }
+  ctx.buf = job->scratch + id * job->scratch_size;
+  ctx.size = job->scratch_size;
+  *status = lut_layer_run_rows(&ctx,
+                               layer,
+                               job->filter_pool_data,
+                               job->input_data + in_row_start * layer->input_dims.w * layer->input_dims.c,
+                               out_row_start,
+                               out_rows,
+                               job->output_data + out_row_start * layer->output_dims.w * layer->output_dims.c);
+}
+
+static void *worker_main(void *p)
+{
+  lut_worker_arg *arg = (lut_worker_arg *)p;
+  lut_thread_pool *pool = arg->pool;
+  const int32_t id = arg->id;
+  uint32_t seen = 0;
+  free(arg);
+
+  pthread_mutex_lock(&pool->lock);
+  while (1)
+  {
+    while (pool->generation == seen && !pool->shutdown)
+    {
+      pthread_cond_wait(&pool->start, &pool->lock);
+    }
+    if (pool->shutdown)
+    {
+      break;
+    }
+    seen = pool->generation;
+    const lut_parallel_job *job = pool->job;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (id < job->bands)
+    {
+      run_band(job, id, &pool->status[id]);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (--pool->pending == 0)
+    {
+      pthread_cond_signal(&pool->done);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+lut_thread_pool *lut_thread_pool_create(const int32_t num_threads)
+{
+  if (num_threads < 1)
+  {
+    return NULL;
+  }
+  lut_thread_pool *pool = calloc(1, sizeof(lut_thread_pool));
+  if (pool == NULL)
+  {
+    return NULL;
+  }
+  pool->threads = calloc(num_threads, sizeof(pthread_t));
+  pool->status = calloc(num_threads, sizeof(arm_status));
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->start, NULL);
+  pthread_cond_init(&pool->done, NULL);
+
+  for (int32_t i = 0; i < num_threads; i++)
+  {
+    lut_worker_arg *arg = malloc(sizeof(lut_worker_arg));
+    if (arg == NULL || pool->threads == NULL || pool->status == NULL)
+    {
+      free(arg);
+      lut_thread_pool_destroy(pool);
+      return NULL;
+    }
+    arg->pool = pool;
+    arg->id = i;
+    if (pthread_create(&pool->threads[i], NULL, worker_main, arg) != 0)
+    {
+      free(arg);
+      lut_thread_pool_destroy(pool);
+      return NULL;
+    }
+    pool->num_threads = i + 1;
+  }
+  return pool;
+}
+
+void lut_thread_pool_destroy(lut_thread_pool *pool)
+{
+  if (pool == NULL)
+  {
+    return;
+  }
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = 1;
+  pthread_cond_broadcast(&pool->start);
+  pthread_mutex_unlock(&pool->lock);
+  for (int32_t i = 0; i < pool->num_threads; i++)
+  {
+    pthread_join(pool->threads[i], NULL);
+  }
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->start);
+  pthread_cond_destroy(&pool->done);
+  free(pool->threads);
+  free(pool->status);
+  free(pool);
+}
+
+int32_t lut_thread_pool_size(const lut_thread_pool *pool)
+{
+  return pool->num_threads;
+}
+
+static int32_t worker_scratch_size(const lut_layer *layer)
+{
+  //padded so that workers never share a cache line
+  return LUT_THREADS_ALIGN(MAX(lut_layer_get_buffer_size(layer), 1));
+}
+
+int32_t lut_layer_parallel_get_buffer_size(const lut_layer *layer, const int32_t num_threads)
+{
+  return num_threads * worker_scratch_size(layer);
+}
+
+arm_status lut_layer_run_parallel(const cmsis_nn_context *ctx,
+                                  lut_thread_pool *pool,
+                                  const lut_layer *layer,
+                                  const uint8_t *filter_pool_data,
+                                  const q7_t *input_data,
+                                  q7_t *output_data)
+{
+  lut_parallel_job job;
+  job.layer = layer;
+  job.filter_pool_data = filter_pool_data;
+  job.input_data = input_data;
+  job.output_data = output_data;
+  job.scratch = (q7_t *)ctx->buf;
+  job.scratch_size = worker_scratch_size(layer);
+  //row bands only, a layer with fewer output rows than workers leaves the remaining workers idle
+  job.bands = MIN(pool->num_threads, layer->output_dims.h);
+
+  if (ctx->buf == NULL || ctx->size < job.bands * job.scratch_size)
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  pool->job = &job;
+  pool->pending = pool->num_threads;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->start);
+  while (pool->pending > 0)
+  {
+    pthread_cond_wait(&pool->done, &pool->lock);
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  for (int32_t i = 0; i < job.bands; i++)
+  {
+    if (pool->status[i] != ARM_MATH_SUCCESS)
+    {
+      return pool->status[i];
+    }
+  }
+  return ARM_MATH_SUCCESS;
+}
+
+static int32_t activation_size(const cmsis_nn_dims *dims)
+{
+  return LUT_THREADS_ALIGN(dims->h * dims->w * dims->c);
+}
+
+int32_t lut_network_parallel_get_buffer_size(const lut_network *net, const int32_t num_threads)
+{
+  int32_t act = 0;
+  int32_t scratch = 0;
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    if (i < net->num_layers - 1)
+    {
+      act = MAX(act, activation_size(&net->layers[i].output_dims));
+    }
+    scratch = MAX(scratch, lut_layer_parallel_get_buffer_size(&net->layers[i], num_threads));
+  }
+  return 2 * act + scratch;
+}
+
+arm_status lut_network_run_parallel(const cmsis_nn_context *ctx,
+                                    lut_thread_pool *pool,
+                                    const lut_network *net,
+                                    const q7_t *input_data,
+                                    q7_t *output_data)
+{
+  if (net->num_layers < 1 || ctx->buf == NULL || ctx->size < lut_network_parallel_get_buffer_size(net, pool->num_threads))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  int32_t act = 0;
+  for (int32_t i = 0; i < net->num_layers - 1; i++)
+  {
+    act = MAX(act, activation_size(&net->layers[i].output_dims));
+  }
+  q7_t *ping_pong[2] = {(q7_t *)ctx->buf, (q7_t *)ctx->buf + act};
+  cmsis_nn_context scratch;
+  scratch.buf = (q7_t *)ctx->buf + 2 * act;
+  scratch.size = ctx->size - 2 * act;
+
+  const q7_t *src = input_data;
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    const lut_layer *layer = &net->layers[i];
+    if (i > 0)
+    {
+      const cmsis_nn_dims *prev = &net->layers[i - 1].output_dims;
+      if (prev->h != layer->input_dims.h || prev->w != layer->input_dims.w || prev->c != layer->input_dims.c)
+      {
+        return ARM_MATH_ARGUMENT_ERROR;
+      }
+    }
+    q7_t *dst = (i == net->num_layers - 1) ? output_data : ping_pong[i & 1];
+    const arm_status status = lut_layer_run_parallel(&scratch, pool, layer, net->filter_pool_data, src, dst);
+    if (status != ARM_MATH_SUCCESS)
+    {
+      return status;
+    }
+    src = dst;
+  }
+  return ARM_MATH_SUCCESS;
+}
+
+#endif // LUT_HOST_THREADS
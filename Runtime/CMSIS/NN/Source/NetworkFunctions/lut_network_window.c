@@ -0,0 +1,187 @@
+/*
+Sliding window (streaming) execution of a weight pool network, for time-series models such as keyword spotting where
+consecutive input windows overlap: the input rows are the time axis and every new frame adds hop rows at the bottom
+of the window and drops hop rows at the top.
+
+The full output of every layer is kept between frames. With hop a multiple of the strides, an output row of the new
+window is the output row hop_out rows further down in the old window, as long as its whole receptive field is made of
+input rows that were themselves kept and none of it is padding. Those rows form one contiguous band per layer, they
+are moved up and only the rows above and below the band (the new frame, plus the padded edges) are computed, with
+lut_layer_run_rows on the narrowed regions. The outputs are identical to running the whole network on the window.
+
+The kept rows are shifted with one memmove per tensor and frame rather than addressed through a wrapping ring, as the
+kernels need the input rows of a band back to back. The copy is small next to the rows it saves.
+
+ctx->buf layout: [input window][output of layer 0]...[output of the last layer][kernel scratch]
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_WINDOW_ALIGN(x) (((x) + 3) & ~3)
+
+static int32_t row_bytes(const cmsis_nn_dims *dims)
+{
+  return dims->w * dims->c;
+}
+
+//input dims of tensor 0, output dims of layer i - 1 for tensor i
+static const cmsis_nn_dims *tensor_dims(const lut_network *net, const int32_t i)
+{
+  return i == 0 ? &net->layers[0].input_dims : &net->layers[i - 1].output_dims;
+}
+
+int32_t lut_network_window_get_buffer_size(const lut_network *net)
+{
+  int32_t size = 0;
+  int32_t scratch = 0;
+  for (int32_t i = 0; i <= net->num_layers; i++)
+  {
+    const cmsis_nn_dims *dims = tensor_dims(net, i);
+    size += LUT_WINDOW_ALIGN(dims->h * row_bytes(dims));
+  }
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    scratch = MAX(scratch, lut_layer_get_buffer_size(&net->layers[i]));
+  }
+  return size + scratch;
+}
+
+arm_status lut_network_window_init(lut_network_window *win,
+                                   const cmsis_nn_context *ctx,
+                                   const lut_network *net,
+                                   const int32_t hop)
+{
+  if (net->num_layers < 1 || net->num_layers > LUT_WINDOW_MAX_LAYERS || hop < 1 ||
+      hop > net->layers[0].input_dims.h || ctx->buf == NULL || ctx->size < lut_network_window_get_buffer_size(net))
+  {
+    return ARM_MATH_ARGUMENT_ERROR;
+  }
+
+  win->hop[0] = hop;
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    const lut_layer *layer = &net->layers[i];
+    if (i > 0)
+    {
+      const cmsis_nn_dims *prev = &net->layers[i - 1].output_dims;
+      if (prev->h != layer->input_dims.h || prev->w != layer->input_dims.w || prev->c != layer->input_dims.c)
+      {
+        return ARM_MATH_ARGUMENT_ERROR;
+      }
+    }
+    if (layer->type == LUT_LAYER_LUT_FC)
+    {
+      //covers the whole window, recomputed on every push
+      win->hop[i + 1] = 0;
+    }
+    else
+    {
+      //the output has to shift by whole rows
+      const int32_t stride = layer->conv_params.stride.h;
+      if (stride < 1 || win->hop[i] % stride != 0)
+      {
+        return ARM_MATH_ARGUMENT_ERROR;
+      }
+      win->hop[i + 1] = win->hop[i] / stride;
+    }
+  }
+
+  q7_t *buf = (q7_t *)ctx->buf;
+  for (int32_t i = 0; i <= net->num_layers; i++)
+  {
+    const cmsis_nn_dims *dims = tensor_dims(net, i);
+    win->tensor[i] = buf;
+    buf += LUT_WINDOW_ALIGN(dims->h * row_bytes(dims));
+  }
+  //the window starts as zero rows, the first push computes everything
+  memset(win->tensor[0], 0, tensor_dims(net, 0)->h * row_bytes(tensor_dims(net, 0)));
+  win->net = net;
+  win->scratch.buf = buf;
+  win->scratch.size = ctx->size - (int32_t)(buf - (q7_t *)ctx->buf);
+  win->primed = 0;
+  win->rows_computed = 0;
+  win->rows_reused = 0;
+  return ARM_MATH_SUCCESS;
+}
+
+const q7_t *lut_network_window_output(const lut_network_window *win)
+{
+  return win->tensor[win->net->num_layers];
+}
+
+//compute output rows [start, end) of layer i from the whole input tensor
+static arm_status run_band(lut_network_window *win, const int32_t i, const int32_t start, const int32_t end)
+{
+  const lut_layer *layer = &win->net->layers[i];
+  if (start >= end)
+  {
+    return ARM_MATH_SUCCESS;
+  }
+  const q7_t *src = win->tensor[i] + lut_layer_input_row_start(layer, start) * row_bytes(&layer->input_dims);
+  q7_t *dst = win->tensor[i + 1] + start * row_bytes(&layer->output_dims);
+  win->rows_computed += end - start;
+  return lut_layer_run_rows(&win->scratch, layer, win->net->filter_pool_data, src, start, end - start, dst);
+}
+
+arm_status lut_network_window_push(lut_network_window *win, const q7_t *frame)
+{
+  const lut_network *net = win->net;
+  const cmsis_nn_dims *in_dims = tensor_dims(net, 0);
+  const int32_t in_bytes = row_bytes(in_dims);
+
+  //shift the window and append the frame
+  memmove(win->tensor[0], win->tensor[0] + win->hop[0] * in_bytes, (in_dims->h - win->hop[0]) * in_bytes);
+  memcpy(win->tensor[0] + (in_dims->h - win->hop[0]) * in_bytes, frame, win->hop[0] * in_bytes);
+
+  //[clean_start, clean_end): rows of the current tensor equal to the rows hop further down in the previous window
+  int32_t clean_start = 0;
+  int32_t clean_end = win->primed ? in_dims->h - win->hop[0] : 0;
+
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    const lut_layer *layer = &net->layers[i];
+    const int32_t out_h = layer->output_dims.h;
+    const int32_t out_bytes = row_bytes(&layer->output_dims);
+    const int32_t hop_out = win->hop[i + 1];
+    int32_t start = 0;
+    int32_t end = 0;
+
+    if (layer->type != LUT_LAYER_LUT_FC && clean_start < clean_end)
+    {
+      //output rows whose input rows are all clean, without padding
+      const int32_t stride = layer->conv_params.stride.h;
+      const int32_t pad = layer->conv_params.padding.h;
+      const int32_t last = clean_end + pad - layer->filter_dims.h;
+      start = (clean_start + pad + stride - 1) / stride;
+      end = last < 0 ? 0 : MIN(last / stride + 1, out_h - hop_out);
+    }
+
+    arm_status status;
+    if (start < end)
+    {
+      memmove(win->tensor[i + 1] + start * out_bytes, win->tensor[i + 1] + (start + hop_out) * out_bytes,
+              (end - start) * out_bytes);
+      win->rows_reused += end - start;
+      status = run_band(win, i, 0, start);
+      if (status == ARM_MATH_SUCCESS)
+      {
+        status = run_band(win, i, end, out_h);
+      }
+    }
+    else
+    {
+      start = end = 0;
+      status = run_band(win, i, 0, out_h);
+    }
+    if (status != ARM_MATH_SUCCESS)
+    {
+      //the kept rows can no longer be trusted
+      win->primed = 0;
+      return status;
+    }
+    clean_start = start;
+    clean_end = end;
+  }
+  win->primed = 1;
+  return ARM_MATH_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+On-device synthesis of the weight pool lookup table from the compact pool vectors.
+A precomputed LUT is 256 x LUT_SIZE bytes of flash (16 KB for 64 kernels) while the pool itself is LUT_SIZE x 8 int8
+weights. Entry [row][k] is the partial sum of the weights of pool kernel k on the channels whose bit is set in row,
+requantized and clamped like the offline LUT generation: clamp(arm_nn_requantize(sum, multiplier, shift)).
+The table is built in SRAM at model load (lut_synth_network) or layer start (lut_synth_layer), and only the columns
+of the kernels the layer(s) actually reference are computed. Each row reuses the sum of the row without its lowest set
+bit, so a column costs 255 adds and 255 requantizations.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+#define LUT_SYNTH_ROWS 256 //one row per 8-bit input index
+
+int32_t lut_synth_get_buffer_size(void)
+{
+  return LUT_SYNTH_ROWS * LUT_SIZE;
+}
+
+arm_status lut_synth_columns(const lut_pool_vectors *pool, const uint8_t *used, uint8_t *lut)
+{
+  if (pool->pool_size > LUT_SIZE)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+  int16_t sum[LUT_SYNTH_ROWS];
+  for (int32_t k = 0; k < pool->pool_size; k++)
+  {
+    if (used && !used[k])
+    {
+      continue;
+    }
+    const int8_t *v = pool->vectors + k * FW_GRAN;
+    sum[0] = 0;
+    for (int32_t row = 1; row < LUT_SYNTH_ROWS; row++)
+    {
+      //lowest set bit of the row, the rest of the row is already done
+      const int32_t low = row & -row;
+      sum[row] = sum[row - low] + v[31 - __CLZ(low)];
+    }
+    for (int32_t row = 0; row < LUT_SYNTH_ROWS; row++)
+    {
+      int32_t entry = arm_nn_requantize(sum[row], pool->multiplier, pool->shift);
+      entry = MAX(entry, pool->entry_min);
+      entry = MIN(entry, pool->entry_max);
+      lut[row * LUT_SIZE + k] = (uint8_t)entry;
+    }
+  }
+  return ARM_MATH_SUCCESS;
+}
+
+//mark the pool kernels referenced by the index array of a layer
+static arm_status lut_synth_mark_used(const lut_layer *layer, const int32_t pool_size, uint8_t *used)
+{
+  int32_t idx_count;
+  switch (layer->type)
+  {
+    case LUT_LAYER_CONV_S8:
+    case LUT_LAYER_MAX_POOL_S8:
+      return ARM_MATH_SUCCESS;
+    case LUT_LAYER_LUT_FC:
+      idx_count = layer->input_dims.h * layer->input_dims.w * layer->input_dims.c / FW_GRAN * layer->output_dims.c;
+      break;
+    default:
+      idx_count = layer->filter_dims.h * layer->filter_dims.w * (layer->input_dims.c / FW_GRAN) * layer->output_dims.c;
+      break;
+  }
+  for (int32_t i = 0; i < idx_count; i++)
+  {
+    if (layer->kernel_idx[i] >= pool_size)
+    {
+      return ARM_MATH_ARGUMENT_ERROR;
+    }
+    used[layer->kernel_idx[i]] = 1;
+  }
+  return ARM_MATH_SUCCESS;
+}
+
+arm_status lut_synth_layer(const lut_layer *layer, const lut_pool_vectors *pool, uint8_t *lut, int32_t *columns)
+{
+  uint8_t used[LUT_SIZE] = {0};
+  if (pool->pool_size > LUT_SIZE)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+  const arm_status status = lut_synth_mark_used(layer, pool->pool_size, used);
+  if (status != ARM_MATH_SUCCESS)
+  {
+    return status;
+  }
+  if (columns)
+  {
+    *columns = 0;
+    for (int32_t k = 0; k < pool->pool_size; k++)
+    {
+      *columns += used[k];
+    }
+  }
+  return lut_synth_columns(pool, used, lut);
+}
+
+arm_status lut_synth_network(lut_network *net, const lut_pool_vectors *pool, uint8_t *lut, int32_t *columns)
+{
+  uint8_t used[LUT_SIZE] = {0};
+  if (pool->pool_size > LUT_SIZE)
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+  for (int32_t i = 0; i < net->num_layers; i++)
+  {
+    const arm_status status = lut_synth_mark_used(&net->layers[i], pool->pool_size, used);
+    if (status != ARM_MATH_SUCCESS)
+    {
+      return status;
+    }
+  }
+  if (columns)
+  {
+    *columns = 0;
+    for (int32_t k = 0; k < pool->pool_size; k++)
+    {
+      *columns += used[k];
+    }
+  }
+  const arm_status status = lut_synth_columns(pool, used, lut);
+  if (status == ARM_MATH_SUCCESS)
+  {
+    net->filter_pool_data = lut;
+  }
+  return status;
+}
@@ -0,0 +1,61 @@
+/*
+arm_max_pool_s8 on packed n-bit activations (lut_pack_params). Input and output use the same packing: the stored
+values are x + offset in 0..(1 << bits) - 1, so the maximum is taken directly on them. The activation clamp of
+pool_params is applied in the q7 domain, like arm_max_pool_s8.
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+arm_status lut_max_pool_packed(const cmsis_nn_pool_params *pool_params,
+                               const lut_pack_params *pack,
+                               const cmsis_nn_dims *input_dims,
+                               const uint8_t *src,
+                               const cmsis_nn_dims *filter_dims,
+                               const cmsis_nn_dims *output_dims,
+                               uint8_t *dst)
+{
+  const int32_t input_y = input_dims->h;
+  const int32_t input_x = input_dims->w;
+  const int32_t output_y = output_dims->h;
+  const int32_t output_x = output_dims->w;
+  const int32_t stride_y = pool_params->stride.h;
+  const int32_t stride_x = pool_params->stride.w;
+  const int32_t kernel_y = filter_dims->h;
+  const int32_t kernel_x = filter_dims->w;
+  const int32_t pad_y = pool_params->padding.h;
+  const int32_t pad_x = pool_params->padding.w;
+  const int32_t channels = input_dims->c;
+  const int32_t bits = pack->bits;
+  //clamp of the stored values
+  const int32_t act_min = MAX(pool_params->activation.min + pack->offset, 0);
+  const int32_t act_max = MIN(pool_params->activation.max + pack->offset, (1 << bits) - 1);
+
+  for (int32_t i_y = 0; i_y < output_y; i_y++)
+  {
+    const int32_t base_y = i_y * stride_y - pad_y;
+    const int32_t ker_y_start = MAX(0, -base_y);
+    const int32_t ker_y_end = MIN(kernel_y, input_y - base_y);
+    for (int32_t i_x = 0; i_x < output_x; i_x++)
+    {
+      const int32_t base_x = i_x * stride_x - pad_x;
+      const int32_t ker_x_start = MAX(0, -base_x);
+      const int32_t ker_x_end = MIN(kernel_x, input_x - base_x);
+      for (int32_t ch = 0; ch < channels; ch++)
+      {
+        int32_t max = 0;
+        for (int32_t k_y = ker_y_start; k_y < ker_y_end; k_y++)
+        {
+          for (int32_t k_x = ker_x_start; k_x < ker_x_end; k_x++)
+          {
+            const int32_t i = ((base_y + k_y) * input_x + base_x + k_x) * channels + ch;
+            max = MAX(max, lut_nn_packed_get(src, i, bits));
+          }
+        }
+        max = MAX(max, act_min);
+        max = MIN(max, act_max);
+        lut_nn_packed_set(dst, (i_y * output_x + i_x) * channels + ch, bits, (uint8_t)max);
+      }
+    }
+  }
+  return ARM_MATH_SUCCESS;
+}
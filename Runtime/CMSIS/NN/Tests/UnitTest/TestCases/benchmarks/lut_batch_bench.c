@@ -0,0 +1,113 @@
+/*
+Host benchmark of the batch-interleaved kernel lut_conv_zdim_v2_batch on the benchmarklayers shapes and indices
+(64-wide pool). For each layer a batch of post-relu inputs (values 0..31, half of them zero) is run once through
+lut_conv_zdim_v2_batch and once image by image through lut_conv_zdim_v1 and lut_conv_zdim_v2_double_lookup, the
+outputs are compared and the throughput of the three is printed. The batch sizes include ragged ones that are not a
+multiple of the 8 image tile.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_batch_bench.c lut_utiles.c ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c -o lut_batch_bench
+./lut_batch_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+
+typedef enum
+{
+    RUN_V1,
+    RUN_V2,
+    RUN_BATCH
+} run_kind;
+
+//time of one pass over the batch in ms, the output of the last pass is left in out
+static double run_batch(const bench_layer *l, const run_kind kind, const int32_t batch, const q7_t *input,
+                        const int32_t repeats, q7_t *out)
+{
+    const int32_t in_size = l->input_dims.h * l->input_dims.w * l->input_dims.c;
+    const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+    cmsis_nn_dims input_dims = l->input_dims;
+    cmsis_nn_dims output_dims = l->output_dims;
+    input_dims.n = batch;
+    output_dims.n = batch;
+    cmsis_nn_context ctx;
+    ctx.size = kind == RUN_BATCH ? lut_conv_zdim_batch_get_buffer_size(&input_dims, &output_dims)
+                                 : lut_conv_zdim_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        if (kind == RUN_BATCH)
+        {
+            lut_conv_zdim_v2_batch(&ctx, &l->conv_params, &l->quant_params, &input_dims, input, &l->filter_dims,
+                                   l->kernel_idx, &l->bias_dims, l->bias, &output_dims, lut_data, out);
+            continue;
+        }
+        for (int32_t b = 0; b < batch; b++)
+        {
+            (kind == RUN_V2 ? lut_conv_zdim_v2_double_lookup : lut_conv_zdim_v1)(
+                &ctx, &l->conv_params, &l->quant_params, &l->input_dims, input + b * in_size, &l->filter_dims,
+                l->kernel_idx, &l->bias_dims, l->bias, &l->output_dims, lut_data, out + b * out_size);
+        }
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+int main(int argc, char **argv)
+{
+    static const int32_t batches[] = {1, 3, 8, 11, 17};
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 3;
+
+    bench_layer layers[BENCH_LAYERS];
+    SET_BENCHMARKLAYERS_LAYER(&layers[0], 1);
+    SET_BENCHMARKLAYERS_LAYER(&layers[1], 2);
+    SET_BENCHMARKLAYERS_LAYER(&layers[2], 3);
+    SET_BENCHMARKLAYERS_LAYER(&layers[3], 4);
+
+    printf("%-7s %6s %12s %12s %12s %8s %8s %10s %10s\n", "layer", "images", "v1 img/s", "v2 img/s", "batch img/s",
+           "/ v1", "/ v2", "vs v1", "vs v2");
+    srand(1);
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const bench_layer *l = &layers[i];
+        const int32_t in_size = l->input_dims.h * l->input_dims.w * l->input_dims.c;
+        const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+
+        for (uint32_t s = 0; s < sizeof(batches) / sizeof(batches[0]); s++)
+        {
+            const int32_t batch = batches[s];
+            q7_t *input = malloc(batch * in_size);
+            q7_t *ref_v1 = malloc(batch * out_size);
+            q7_t *ref_v2 = malloc(batch * out_size);
+            q7_t *out = malloc(batch * out_size);
+            for (int32_t j = 0; j < batch * in_size; j++)
+            {
+                input[j] = rand() % 2 ? 0 : (q7_t)(rand() % 32);
+            }
+
+            const double v1_ms = run_batch(l, RUN_V1, batch, input, repeats, ref_v1);
+            const double v2_ms = run_batch(l, RUN_V2, batch, input, repeats, ref_v2);
+            const double batch_ms = run_batch(l, RUN_BATCH, batch, input, repeats, out);
+
+            printf("%-7s %6d %12.1f %12.1f %12.1f %7.2fx %7.2fx %10s %10s\n", l->name, (int)batch, 1e3 * batch / v1_ms,
+                   1e3 * batch / v2_ms, 1e3 * batch / batch_ms, v1_ms / batch_ms, v2_ms / batch_ms,
+                   memcmp(ref_v1, out, batch * out_size) == 0 ? "bit-exact" : "MISMATCH",
+                   memcmp(ref_v2, out, batch * out_size) == 0 ? "bit-exact" : "MISMATCH");
+            free(input);
+            free(ref_v1);
+            free(ref_v2);
+            free(out);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+Host benchmark of the bit-plane activation format (lut_conv_zdim_v1_bitplane / lut_conv_zdim_v2_bitplane) on the
+benchmarklayers shapes and indices (64-wide pool). Every benchmark layer keeps its channel count, so each one is run
+twice in a row: once with q7 activations between the two runs, and once with the first run writing bit planes that the
+second run reads (the input is converted with lut_bitplane_from_s8, the final output stays q7). The outputs are
+compared, and the consumer times and activation sizes of both formats are printed.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_bitplane_bench.c lut_utiles.c ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c -o lut_bitplane_bench
+./lut_bitplane_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+
+//time of one call in ms
+static double run_layer(const bench_layer *l, const int32_t v2, const int32_t in_planes, const int32_t out_planes,
+                        const q7_t *input, const int32_t repeats, q7_t *out)
+{
+    //the layer consumes its own output, so the planes are written with its own input offset
+    const lut_bitplane_params bp_params = {in_planes, out_planes, l->conv_params.input_offset};
+    cmsis_nn_context ctx;
+    ctx.size = lut_conv_zdim_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        (v2 ? lut_conv_zdim_v2_bitplane : lut_conv_zdim_v1_bitplane)(
+            &ctx, &l->conv_params, &l->quant_params, &bp_params, &l->input_dims, input, &l->filter_dims, l->kernel_idx,
+            &l->bias_dims, l->bias, &l->output_dims, lut_data, out);
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 5;
+    bench_layer layers[BENCH_LAYERS];
+    SET_BENCHMARKLAYERS_LAYER(&layers[0], 1);
+    SET_BENCHMARKLAYERS_LAYER(&layers[1], 2);
+    SET_BENCHMARKLAYERS_LAYER(&layers[2], 3);
+    SET_BENCHMARKLAYERS_LAYER(&layers[3], 4);
+
+    printf("%-7s %-4s %8s %8s %10s %10s %8s %10s\n", "layer", "kern", "q7 B", "plane B", "q7 ms", "plane ms",
+           "speedup", "output");
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const bench_layer *l = &layers[i];
+        const int32_t size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        const int32_t plane_size = lut_bitplane_get_size(&l->output_dims);
+        q7_t *mid = malloc(size);
+        q7_t *ref = malloc(size);
+        q7_t *out = malloc(size);
+        uint8_t *planes_in = malloc(lut_bitplane_get_size(&l->input_dims));
+        uint8_t *planes_mid = malloc(plane_size);
+        for (int32_t v2 = 0; v2 <= 1; v2++)
+        {
+            //q7 chain
+            run_layer(l, v2, 0, 0, l->input, 1, mid);
+            const double q7_ms = run_layer(l, v2, 0, 0, mid, repeats, ref);
+            //bit-plane chain, converted at the network input
+            lut_bitplane_from_s8(l->input, &l->input_dims, l->conv_params.input_offset, planes_in);
+            run_layer(l, v2, 1, 1, (const q7_t *)planes_in, 1, (q7_t *)planes_mid);
+            const double plane_ms = run_layer(l, v2, 1, 0, (const q7_t *)planes_mid, repeats, out);
+            printf("%-7s %-4s %8d %8d %10.3f %10.3f %8.2f %10s\n", l->name, v2 ? "v2" : "v1", (int)size, (int)plane_size,
+                   q7_ms, plane_ms, q7_ms / plane_ms, memcmp(ref, out, size) == 0 ? "bit-exact" : "MISMATCH");
+        }
+        free(mid);
+        free(ref);
+        free(out);
+        free(planes_in);
+        free(planes_mid);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+Host benchmark of the per-block coefficient kernels lut_conv_zdim_v1_coeff, lut_conv_zdim_v2_coeff and
+lut_conv_zdim_v2_coeff_shift on the indices and coefficients of full_network_index_data.h / full_network_coeff_data.h (64-wide pool).
+The shapes of that data set are not in the tree, so every layer is a 16x16 1x1 convolution whose 8-channel block count
+times output channels matches the length of the arrays. The inputs are post-relu values 0..31, the requantization is
+random per channel. full_network_coeff_layer_N is used as is for the multiplier variant and as coeff % 4 for the
+shift variant (larger shifts overflow the 32-bit accumulators). All three are compared with a scalar reference that computes
+every logical kernel from the LUT on its own, and their time is printed next to lut_conv_zdim_v2_double_lookup on the
+same indices.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_coeff_bench.c lut_utiles.c ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c -o lut_coeff_bench
+./lut_coeff_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../index_data/full_network_index_data.h"
+#include "../../../../../../index_data/full_network_coeff_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+#define BENCH_DIM 16
+#define BENCH_PREC 5
+
+typedef struct
+{
+    const char *name;
+    int32_t in_ch, out_ch;
+    const uint8_t *kernel_idx;
+    const uint8_t *coeffs;
+} coeff_layer;
+
+//every logical kernel read from the LUT separately, no shared physical kernel results
+static void reference_conv(const cmsis_nn_conv_params *conv_params, const cmsis_nn_per_channel_quant_params *quant_params,
+                           const coeff_layer *l, const q7_t *input, const int32_t *bias, const uint8_t *coeffs,
+                           const int32_t coeff_is_shift, q7_t *output)
+{
+    const int32_t blocks = l->in_ch / 8;
+    for (int32_t pix = 0; pix < BENCH_DIM * BENCH_DIM; pix++)
+    {
+        for (int32_t n = 0; n < l->out_ch; n++)
+        {
+            int32_t acc = 0;
+            for (int32_t blk = 0; blk < blocks; blk++)
+            {
+                const int32_t logical = blk * l->out_ch + n;
+                int32_t result = 0;
+                for (int32_t bit = 0; bit < BENCH_PREC; bit++)
+                {
+                    int32_t row = 0;
+                    for (int32_t j = 0; j < 8; j++)
+                    {
+                        const uint8_t val = (uint8_t)(input[pix * l->in_ch + blk * 8 + j] + conv_params->input_offset);
+                        row |= ((val >> bit) & 1) << j;
+                    }
+                    result += lut_data[row * LUT_SIZE + l->kernel_idx[logical]] << bit;
+                }
+                acc += coeff_is_shift ? result << coeffs[logical] : result * coeffs[logical];
+            }
+            acc += bias[n];
+            acc = arm_nn_requantize(acc, quant_params->multiplier[n], quant_params->shift[n]);
+            acc += conv_params->output_offset;
+            acc = MAX(acc, conv_params->activation.min);
+            acc = MIN(acc, conv_params->activation.max);
+            output[pix * l->out_ch + n] = (q7_t)acc;
+        }
+    }
+}
+
+typedef enum
+{
+    RUN_V2,
+    RUN_COEFF_V1,
+    RUN_COEFF,
+    RUN_COEFF_SHIFT
+} run_kind;
+
+//time of one call in ms, the output of the last call is left in out
+static double run_layer(const cmsis_nn_conv_params *conv_params, const cmsis_nn_per_channel_quant_params *quant_params,
+                        const coeff_layer *l, const run_kind kind, const q7_t *input, const int32_t *bias,
+                        const uint8_t *coeffs, const int32_t repeats, q7_t *out)
+{
+    const cmsis_nn_dims input_dims = {1, BENCH_DIM, BENCH_DIM, l->in_ch};
+    const cmsis_nn_dims filter_dims = {l->out_ch, 1, 1, l->in_ch};
+    const cmsis_nn_dims bias_dims = {1, 1, 1, l->out_ch};
+    const cmsis_nn_dims output_dims = {1, BENCH_DIM, BENCH_DIM, l->out_ch};
+    cmsis_nn_context ctx;
+    ctx.size = kind == RUN_V2 ? lut_conv_zdim_get_buffer_size(&output_dims)
+                              : lut_conv_zdim_coeff_get_buffer_size(&output_dims);
+    ctx.buf = malloc(ctx.size);
+
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        if (kind == RUN_V2)
+        {
+            lut_conv_zdim_v2_double_lookup(&ctx, conv_params, quant_params, &input_dims, input, &filter_dims,
+                                           l->kernel_idx, &bias_dims, bias, &output_dims, lut_data, out);
+        }
+        else
+        {
+            (kind == RUN_COEFF_SHIFT ? lut_conv_zdim_v2_coeff_shift
+                                     : (kind == RUN_COEFF_V1 ? lut_conv_zdim_v1_coeff : lut_conv_zdim_v2_coeff))(
+                &ctx, conv_params, quant_params, &input_dims, input, &filter_dims, l->kernel_idx, &bias_dims, bias,
+                &output_dims, lut_data, coeffs, out);
+        }
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 10;
+    const coeff_layer layers[BENCH_LAYERS] = {
+        {"layer1", 8, 48, full_network_index_layer_1, full_network_coeff_layer_1},
+        {"layer2", 64, 64, full_network_index_layer_2, full_network_coeff_layer_2},
+        {"layer3", 128, 64, full_network_index_layer_3, full_network_coeff_layer_3},
+        {"layer4", 64, 128, full_network_index_layer_4, full_network_coeff_layer_4},
+    };
+
+    cmsis_nn_conv_params conv_params;
+    conv_params.input_offset = 0;
+    conv_params.output_offset = 0;
+    conv_params.stride.w = 1;
+    conv_params.stride.h = 1;
+    conv_params.padding.w = 0;
+    conv_params.padding.h = 0;
+    conv_params.activation.min = -128;
+    conv_params.activation.max = 127;
+
+    printf("%-7s %-13s %11s %11s %11s %11s %8s %10s\n", "layer", "shape", "v2 ms", "v1 coeff ms", "v2 coeff ms",
+           "v2 shift ms", "coeff/v2", "reference");
+    srand(1);
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const coeff_layer *l = &layers[i];
+        const int32_t in_size = BENCH_DIM * BENCH_DIM * l->in_ch;
+        const int32_t out_size = BENCH_DIM * BENCH_DIM * l->out_ch;
+        const int32_t logical = l->in_ch / 8 * l->out_ch;
+        q7_t *input = malloc(in_size);
+        q7_t *ref = malloc(out_size);
+        q7_t *out = malloc(out_size);
+        uint8_t *shifts = malloc(logical);
+        int32_t *bias = malloc(l->out_ch * sizeof(int32_t));
+        int32_t *mult = malloc(l->out_ch * sizeof(int32_t));
+        int32_t *shift = malloc(l->out_ch * sizeof(int32_t));
+        for (int32_t j = 0; j < in_size; j++)
+        {
+            input[j] = rand() % 2 ? 0 : (q7_t)(rand() % 32);
+        }
+        for (int32_t j = 0; j < logical; j++)
+        {
+            shifts[j] = l->coeffs[j] % 4;
+        }
+        for (int32_t n = 0; n < l->out_ch; n++)
+        {
+            bias[n] = rand() % 2048 - 1024;
+            mult[n] = (1 << 30) + rand() % (1 << 29);
+            shift[n] = -10 - rand() % 3;
+        }
+        cmsis_nn_per_channel_quant_params quant_params = {mult, shift};
+
+        const double v2_ms = run_layer(&conv_params, &quant_params, l, RUN_V2, input, bias, NULL, repeats, out);
+        reference_conv(&conv_params, &quant_params, l, input, bias, l->coeffs, 0, ref);
+        const double v1_coeff_ms =
+            run_layer(&conv_params, &quant_params, l, RUN_COEFF_V1, input, bias, l->coeffs, repeats, out);
+        const int exact_v1 = memcmp(ref, out, out_size) == 0;
+        const double coeff_ms =
+            run_layer(&conv_params, &quant_params, l, RUN_COEFF, input, bias, l->coeffs, repeats, out);
+        const int exact = memcmp(ref, out, out_size) == 0;
+        const double shift_ms =
+            run_layer(&conv_params, &quant_params, l, RUN_COEFF_SHIFT, input, bias, shifts, repeats, out);
+        reference_conv(&conv_params, &quant_params, l, input, bias, shifts, 1, ref);
+        const int exact_shift = memcmp(ref, out, out_size) == 0;
+
+        char shape[32];
+        snprintf(shape, sizeof(shape), "%dx%dx%d->%d", BENCH_DIM, BENCH_DIM, (int)l->in_ch, (int)l->out_ch);
+        printf("%-7s %-13s %11.3f %11.3f %11.3f %11.3f %7.2fx %10s\n", l->name, shape, v2_ms, v1_coeff_ms, coeff_ms,
+               shift_ms, coeff_ms / v2_ms, exact_v1 && exact && exact_shift ? "bit-exact" : "MISMATCH");
+        free(input);
+        free(ref);
+        free(out);
+        free(shifts);
+        free(bias);
+        free(mult);
+        free(shift);
+    }
+    return 0;
+}
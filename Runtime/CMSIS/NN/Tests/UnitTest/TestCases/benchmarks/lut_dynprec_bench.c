@@ -0,0 +1,122 @@
+/*
+Host benchmark of the dynamic precision LUT kernels (lut_conv_zdim_v1_dynprec / lut_conv_zdim_v2_dynprec) on the
+benchmarklayers shapes and indices (64-wide pool).
+Every layer is run on its test input and on generated inputs of 2, 3 and 4 bits (uniform in 0..2^bits-1), with the
+dense and the dynamic precision kernel. The outputs are compared and the mean number of planes looked up per block is
+printed next to the block precision histogram.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_dynprec_bench.c lut_utiles.c ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c -o lut_dynprec_bench
+./lut_dynprec_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/input_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+
+static void narrow_input(q7_t *input, const int32_t size, const int32_t bits)
+{
+    for (int32_t i = 0; i < size; i++)
+    {
+        input[i] = (q7_t)(rand() % (1 << bits));
+    }
+}
+
+//time of one call in ms, the output of the last call is left in out
+static double run_layer(const bench_layer *l, const q7_t *input, const uint8_t *lut, const int32_t dynprec,
+                        lut_precision_stats *stats, const int32_t repeats, q7_t *out)
+{
+    cmsis_nn_context ctx;
+    ctx.size = lut_conv_zdim_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        if (dynprec)
+        {
+            (l->double_lookup ? lut_conv_zdim_v2_dynprec : lut_conv_zdim_v1_dynprec)(
+                &ctx, &l->conv_params, &l->quant_params, &l->input_dims, input, &l->filter_dims, l->kernel_idx,
+                &l->bias_dims, l->bias, &l->output_dims, lut, r == 0 ? stats : NULL, out);
+        }
+        else
+        {
+            (l->double_lookup ? lut_conv_zdim_v2_double_lookup : lut_conv_zdim_v1)(
+                &ctx, &l->conv_params, &l->quant_params, &l->input_dims, input, &l->filter_dims, l->kernel_idx,
+                &l->bias_dims, l->bias, &l->output_dims, lut, out);
+        }
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+int main(int argc, char **argv)
+{
+    static const int32_t input_bits[] = {0, 2, 3, 4}; //0: test input
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 5;
+
+    bench_layer layers[BENCH_LAYERS];
+    SET_BENCHMARKLAYERS_LAYER(&layers[0], 1);
+    SET_BENCHMARKLAYERS_LAYER(&layers[1], 2);
+    SET_BENCHMARKLAYERS_LAYER(&layers[2], 3);
+    layers[2].double_lookup = 1;
+    SET_BENCHMARKLAYERS_LAYER(&layers[3], 4);
+    layers[3].double_lookup = 1;
+
+    printf("%-7s %-4s %-6s %-34s %7s %10s %10s %10s\n", "layer", "kern", "input", "blocks of 0..5 bits (%)",
+           "planes", "dense ms", "dynprec ms", "output");
+    srand(1);
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const bench_layer *l = &layers[i];
+        const int32_t in_size = l->input_dims.h * l->input_dims.w * l->input_dims.c;
+        const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        q7_t *input = malloc(in_size);
+        q7_t *ref = malloc(out_size);
+        q7_t *out = malloc(out_size);
+
+        for (uint32_t s = 0; s < sizeof(input_bits) / sizeof(input_bits[0]); s++)
+        {
+            lut_precision_stats stats = {{0}};
+            char name[8] = "test";
+            if (input_bits[s])
+            {
+                narrow_input(input, in_size, input_bits[s]);
+                snprintf(name, sizeof(name), "%d bit", (int)input_bits[s]);
+            }
+            else
+            {
+                memcpy(input, l->input, in_size);
+            }
+            const double dense_ms = run_layer(l, input, lut_data, 0, NULL, repeats, ref);
+            const double dynprec_ms = run_layer(l, input, lut_data, 1, &stats, repeats, out);
+
+            uint32_t blocks = 0, planes = 0;
+            char hist[64];
+            int32_t pos = 0;
+            for (int32_t p = 0; p <= 5; p++)
+            {
+                blocks += stats.blocks[p];
+                planes += stats.blocks[p] * p;
+            }
+            for (int32_t p = 0; p <= 5; p++)
+            {
+                pos += snprintf(hist + pos, sizeof(hist) - pos, "%5.1f ", 100.0 * stats.blocks[p] / blocks);
+            }
+            printf("%-7s %-4s %-6s %-34s %7.2f %10.3f %10.3f %10s\n", l->name, l->double_lookup ? "v2" : "v1", name,
+                   hist, (double)planes / blocks, dense_ms, dynprec_ms,
+                   memcmp(ref, out, out_size) == 0 ? "bit-exact" : "MISMATCH");
+        }
+        free(input);
+        free(ref);
+        free(out);
+    }
+    return 0;
+}
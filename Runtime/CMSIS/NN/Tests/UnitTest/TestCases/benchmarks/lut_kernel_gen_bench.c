@@ -0,0 +1,135 @@
+/*
+Host benchmark of the shape specialised kernels of lut_kernel_gen.py against the generic LUT kernels, on the
+benchmarklayers shapes (layers 1-2 lut_conv_zdim_v1, layers 3-4 lut_conv_zdim_v2_double_lookup, 64-wide pool).
+Every layer is run through lut_layer_run_rows on the whole output and in bands of 3 rows, first with the generic kernel
+and then with the kernel bound by benchmarklayers_bind; the outputs are compared.
+
+Build from this directory:
+python3 ../../../../../../lut_kernel_gen.py --config ../../../../../../TestData_fullnetwork/benchmarklayers/config_data.h \
+    --layers 1-4 --v1 1-2 --lut-size 64 --name benchmarklayers --out lut_kernels_benchmarklayers
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I. -I../../../../Include -I../../../../../DSP/Include \
+    lut_kernel_gen_bench.c lut_utiles.c lut_kernels_benchmarklayers.c \
+    ../../../../Source/NetworkFunctions/lut_network.c \
+    ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c ../../../../Source/FullyConnectedFunctions/lut_fully_connected_zdim.c \
+    ../../../../Source/ConvolutionFunctions/arm_convolve_s8.c ../../../../Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s8_s16.c \
+    ../../../../Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s8.c ../../../../Source/NNSupportFunctions/arm_q7_to_q15_with_offset.c \
+    ../../../../Source/PoolingFunctions/arm_max_pool_s8.c -o lut_kernel_gen_bench
+./lut_kernel_gen_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "lut_kernels_benchmarklayers.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_BAND_ROWS 3
+
+static void set_layer(lut_layer *layer, lut_layer_type type,
+                      int32_t input_w, int32_t input_h, int32_t in_ch, int32_t out_ch,
+                      int32_t filter_x, int32_t filter_y, int32_t stride, int32_t pad,
+                      const int32_t *bias, const int32_t *mult, const int32_t *shift,
+                      const uint8_t *kernel_idx)
+{
+    memset(layer, 0, sizeof(lut_layer));
+    layer->type = type;
+    layer->input_dims.n = 1;
+    layer->input_dims.w = input_w;
+    layer->input_dims.h = input_h;
+    layer->input_dims.c = in_ch;
+    layer->filter_dims.n = out_ch;
+    layer->filter_dims.w = filter_x;
+    layer->filter_dims.h = filter_y;
+    layer->filter_dims.c = in_ch;
+    layer->output_dims.n = 1;
+    layer->output_dims.w = (input_w + 2 * pad - filter_x) / stride + 1;
+    layer->output_dims.h = (input_h + 2 * pad - filter_y) / stride + 1;
+    layer->output_dims.c = out_ch;
+    layer->conv_params.stride.w = stride;
+    layer->conv_params.stride.h = stride;
+    layer->conv_params.padding.w = pad;
+    layer->conv_params.padding.h = pad;
+    layer->conv_params.input_offset = CONVLAYER1_INPUT_OFFSET;
+    layer->conv_params.output_offset = CONVLAYER1_OUTPUT_OFFSET;
+    layer->conv_params.activation.min = CONVLAYER1_OUT_ACTIVATION_MIN;
+    layer->conv_params.activation.max = CONVLAYER1_OUT_ACTIVATION_MAX;
+    layer->quant_params.multiplier = (int32_t *)mult;
+    layer->quant_params.shift = (int32_t *)shift;
+    layer->bias_data = bias;
+    layer->kernel_idx = kernel_idx;
+}
+
+#define SET_LUT_LAYER(layer, type, N, index) \
+    set_layer(layer, type, CONVLAYER##N##_INPUT_W, CONVLAYER##N##_INPUT_H, CONVLAYER##N##_IN_CH, CONVLAYER##N##_OUT_CH, \
+              CONVLAYER##N##_FILTER_X, CONVLAYER##N##_FILTER_Y, CONVLAYER##N##_STRIDE_X, CONVLAYER##N##_PAD_X, \
+              convlayer##N##_biases, convlayer##N##_output_mult, convlayer##N##_output_shift, index)
+
+#define SET_LUT_LAYER(layer, type, N, index) \
+    set_layer(layer, type, CONVLAYER##N##_INPUT_W, CONVLAYER##N##_INPUT_H, CONVLAYER##N##_IN_CH, CONVLAYER##N##_OUT_CH, \
+              CONVLAYER##N##_FILTER_X, CONVLAYER##N##_FILTER_Y, CONVLAYER##N##_STRIDE_X, CONVLAYER##N##_PAD_X, \
+              convlayer##N##_biases, convlayer##N##_output_mult, convlayer##N##_output_shift, index)
+
+//time of one run of the layer in ms, whole output or in bands of band_rows rows
+static double run_layer(const lut_layer *layer, const q7_t *input, const int32_t band_rows, const int32_t repeats,
+                        q7_t *out)
+{
+    cmsis_nn_context ctx;
+    ctx.size = lut_layer_get_buffer_size(layer);
+    ctx.buf = malloc(ctx.size);
+    const int32_t rows = layer->output_dims.h;
+    const int32_t row_size = layer->output_dims.w * layer->output_dims.c;
+    const int32_t in_row_size = layer->input_dims.w * layer->input_dims.c;
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        for (int32_t row = 0; row < rows; row += band_rows)
+        {
+            const int32_t band = band_rows < rows - row ? band_rows : rows - row;
+            lut_layer_run_rows(&ctx, layer, lut_data, input + lut_layer_input_row_start(layer, row) * in_row_size, row,
+                               band, out + row * row_size);
+        }
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 5;
+    static lut_layer layers[4];
+    static const q7_t *inputs[4] = {convlayer1_input, convlayer2_input, convlayer3_input, convlayer4_input};
+    SET_LUT_LAYER(&layers[0], LUT_LAYER_LUT_CONV_V1, 1, benchmarklayers_index_layer_1);
+    SET_LUT_LAYER(&layers[1], LUT_LAYER_LUT_CONV_V1, 2, benchmarklayers_index_layer_2);
+    SET_LUT_LAYER(&layers[2], LUT_LAYER_LUT_CONV_V2, 3, benchmarklayers_index_layer_3);
+    SET_LUT_LAYER(&layers[3], LUT_LAYER_LUT_CONV_V2, 4, benchmarklayers_index_layer_4);
+
+    static lut_layer bound[4];
+    memcpy(bound, layers, sizeof(layers));
+    printf("%d of 4 layers bound to a generated kernel\n", (int)benchmarklayers_bind(bound, 4));
+
+    printf("%-7s %-4s %11s %12s %8s %10s %10s\n", "layer", "kern", "generic ms", "generated ms", "speedup", "whole",
+           "bands");
+    for (int32_t i = 0; i < 4; i++)
+    {
+        const lut_layer *l = &layers[i];
+        const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        q7_t *ref = malloc(out_size);
+        q7_t *out = malloc(out_size);
+
+        const double generic_ms = run_layer(l, inputs[i], l->output_dims.h, repeats, ref);
+        const double generated_ms = run_layer(&bound[i], inputs[i], l->output_dims.h, repeats, out);
+        const int whole = memcmp(ref, out, out_size) == 0;
+        memset(out, 0, out_size);
+        run_layer(&bound[i], inputs[i], BENCH_BAND_ROWS, 1, out);
+        const int bands = memcmp(ref, out, out_size) == 0;
+        printf("layer%-2d %-4s %11.3f %12.3f %8.2f %10s %10s\n", (int)(i + 1),
+               l->type == LUT_LAYER_LUT_CONV_V1 ? "v1" : "v2", generic_ms, generated_ms, generic_ms / generated_ms,
+               whole ? "bit-exact" : "MISMATCH", bands ? "bit-exact" : "MISMATCH");
+        free(ref);
+        free(out);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+Host benchmark of binary weight pool models (lut_model.c), written by Runtime/model_pack.py.
+Every model given on the command line is mapped, checked and run with lut_network_stream_run on a random input, so
+model sweeps need no rebuild. Runs on Linux, not on the STM32 boards. The models must be packed with the LUT_SIZE the
+kernels are built with (lut_model_load returns ARM_MATH_SIZE_MISMATCH otherwise).
+On the boards the same model is used in place from flash, e.g. lut_model_load((const uint8_t *)0x08040000, ...) after
+writing the file to that address.
+
+Build from this directory:
+gcc -O2 -DLUT_HOST_MMAP -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_model_bench.c lut_utiles.c ../../../../Source/NetworkFunctions/lut_model.c \
+    ../../../../Source/NetworkFunctions/lut_network.c \
+    ../../../../Source/NetworkFunctions/lut_network_stream.c \
+    ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c ../../../../Source/ConvolutionFunctions/arm_convolve_s8.c \
+    ../../../../Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s8_s16.c ../../../../Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s8.c \
+    ../../../../Source/NNSupportFunctions/arm_q7_to_q15_with_offset.c ../../../../Source/PoolingFunctions/arm_max_pool_s8.c \
+    ../../../../Source/FullyConnectedFunctions/lut_fully_connected_zdim.c -o lut_model_bench
+./lut_model_bench [-r repeats] model.lutm [model.lutm ...]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LUT_MODEL_BENCH_MAX_LAYERS 64
+
+static int bench_model(const char *path, const int32_t repeats)
+{
+    static lut_layer layers[LUT_MODEL_BENCH_MAX_LAYERS];
+    const uint8_t *model;
+    int32_t size;
+    lut_network net;
+
+    arm_status status = lut_model_map(path, &model, &size);
+    if (status != ARM_MATH_SUCCESS)
+    {
+        printf("%s: cannot map\n", path);
+        return 1;
+    }
+    double start = now_ms();
+    status = lut_model_load(model, size, 1, layers, LUT_MODEL_BENCH_MAX_LAYERS, &net);
+    const double load_ms = now_ms() - start;
+    if (status != ARM_MATH_SUCCESS)
+    {
+        printf("%s: load failed, status %d\n", path, (int)status);
+        lut_model_unmap(model, size);
+        return 1;
+    }
+
+    const cmsis_nn_dims *in = &net.layers[0].input_dims;
+    const cmsis_nn_dims *out = &net.layers[net.num_layers - 1].output_dims;
+    const int32_t input_size = in->h * in->w * in->c;
+    const int32_t output_size = out->h * out->w * out->c;
+    q7_t *input = malloc(input_size);
+    q7_t *output = malloc(output_size);
+    cmsis_nn_context ctx;
+    ctx.size = lut_network_stream_get_buffer_size(&net);
+    ctx.buf = malloc(ctx.size);
+
+    srand(1);
+    for (int32_t i = 0; i < input_size; i++)
+    {
+        input[i] = (q7_t)(rand() & 0xFF);
+    }
+    status = lut_network_stream_run(&ctx, &net, input, output); //warm up, also pages the model in
+    start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        status |= lut_network_stream_run(&ctx, &net, input, output);
+    }
+    const double ms = (now_ms() - start) / repeats;
+
+    uint32_t checksum = 0;
+    for (int32_t i = 0; i < output_size; i++)
+    {
+        checksum = checksum * 31 + (uint8_t)output[i];
+    }
+    printf("%-32s %3d layers %8d bytes  load %7.3f ms  run %9.3f ms  buffer %7d  status %d  output %08x\n", path,
+           (int)net.num_layers, (int)size, load_ms, ms, (int)ctx.size, (int)status, (unsigned)checksum);
+
+    free(ctx.buf);
+    free(output);
+    free(input);
+    lut_model_unmap(model, size);
+    return status != ARM_MATH_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    int32_t repeats = 10;
+    int failed = 0;
+    int arg = 1;
+    if (argc > 2 && strcmp(argv[1], "-r") == 0)
+    {
+        repeats = atoi(argv[2]);
+        arg = 3;
+    }
+    if (arg >= argc)
+    {
+        printf("usage: %s [-r repeats] model.lutm [model.lutm ...]\n", argv[0]);
+        return 1;
+    }
+    for (; arg < argc; arg++)
+    {
+        failed |= bench_model(argv[arg], repeats);
+    }
+    return failed;
+}
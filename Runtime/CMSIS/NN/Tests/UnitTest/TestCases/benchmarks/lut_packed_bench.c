@@ -0,0 +1,134 @@
+/*
+Host benchmark of the packed 4-bit activation kernels (lut_packed_act.c) on the benchmarklayers shapes and indices
+(64-wide pool). The producer clamp of every layer is set to 0..15 so its outputs fit 4 bits, and each layer is run twice
+in a row: once with q7 activations between the two runs, and once with the first run writing packed 4-bit values that
+the second run reads (q7 at the network input and output). lut_max_pool_packed and lut_elementwise_add_packed are
+checked against arm_max_pool_s8 and arm_elementwise_add_s8 on the same values, and the consumer times and activation
+sizes of both formats are printed.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_packed_bench.c lut_utiles.c ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c \
+    ../../../../Source/NNSupportFunctions/lut_packed_act.c ../../../../Source/PoolingFunctions/lut_max_pool_packed.c \
+    ../../../../Source/BasicMathFunctions/lut_elementwise_add_packed.c \
+    ../../../../Source/PoolingFunctions/arm_max_pool_s8.c ../../../../Source/BasicMathFunctions/arm_elementwise_add_s8.c \
+    -o lut_packed_bench
+./lut_packed_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+
+//time of one call in ms
+static double run_layer(const bench_layer *l, const int32_t v2, const lut_pack_params *in_pack,
+                        const lut_pack_params *out_pack, const uint8_t *input, const int32_t repeats, uint8_t *out)
+{
+    cmsis_nn_context ctx;
+    ctx.size = lut_conv_zdim_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        (v2 ? lut_conv_zdim_v2_packed : lut_conv_zdim_v1_packed)(
+            &ctx, &l->conv_params, &l->quant_params, in_pack, out_pack, &l->input_dims, input, &l->filter_dims,
+            l->kernel_idx, &l->bias_dims, l->bias, &l->output_dims, lut_data, out);
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+//2x2 max pool and residual add of a 4-bit tensor against the q7 kernels
+static int check_pool_add(const q7_t *act, const cmsis_nn_dims *dims, const lut_pack_params *pack)
+{
+    const int32_t size = dims->h * dims->w * dims->c;
+    const cmsis_nn_dims filter_dims = {1, 2, 2, 1};
+    const cmsis_nn_dims pool_dims = {1, dims->h / 2, dims->w / 2, dims->c};
+    const int32_t pool_size = pool_dims.h * pool_dims.w * pool_dims.c;
+    cmsis_nn_pool_params pool_params;
+    pool_params.stride.w = 2;
+    pool_params.stride.h = 2;
+    pool_params.padding.w = 0;
+    pool_params.padding.h = 0;
+    pool_params.activation.min = 0;
+    pool_params.activation.max = 15;
+    cmsis_nn_context ctx = {NULL, 0};
+
+    uint8_t *packed = malloc(lut_packed_get_size(size, pack));
+    uint8_t *packed_out = malloc(lut_packed_get_size(size, pack));
+    q7_t *ref = malloc(size);
+    q7_t *out = malloc(size);
+    int ok = 1;
+    lut_pack_s8(act, size, pack, packed);
+
+    arm_max_pool_s8(&ctx, &pool_params, dims, act, &filter_dims, &pool_dims, ref);
+    lut_max_pool_packed(&pool_params, pack, dims, packed, &filter_dims, &pool_dims, packed_out);
+    lut_unpack_s8(packed_out, pool_size, pack, out);
+    ok &= memcmp(ref, out, pool_size) == 0;
+
+    //x + x with a 0.5 output scale, clamped back to 4 bits
+    const int32_t mult = 1 << 30, shift = 0, left_shift = 20;
+    arm_elementwise_add_s8(act, act, 0, mult, shift, 0, mult, shift, left_shift, ref, 0, mult, -left_shift, 0, 15,
+                           size);
+    lut_elementwise_add_packed(packed, pack, packed, pack, 0, mult, shift, 0, mult, shift, left_shift, packed_out, pack,
+                               0, mult, -left_shift, 0, 15, size);
+    lut_unpack_s8(packed_out, size, pack, out);
+    ok &= memcmp(ref, out, size) == 0;
+
+    free(packed);
+    free(packed_out);
+    free(ref);
+    free(out);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 5;
+    const lut_pack_params pack4 = {4, 0};
+    bench_layer layers[BENCH_LAYERS];
+    SET_BENCHMARKLAYERS_LAYER(&layers[0], 1);
+    SET_BENCHMARKLAYERS_LAYER(&layers[1], 2);
+    SET_BENCHMARKLAYERS_LAYER(&layers[2], 3);
+    SET_BENCHMARKLAYERS_LAYER(&layers[3], 4);
+
+    printf("%-7s %-4s %8s %8s %10s %10s %8s %10s %10s\n", "layer", "kern", "q7 B", "4-bit B", "q7 ms", "4-bit ms",
+           "speedup", "output", "pool/add");
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        bench_layer *l = &layers[i];
+        //clamped relu, the outputs fit 4 bits
+        l->conv_params.activation.min = 0;
+        l->conv_params.activation.max = 15;
+        const int32_t size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        const int32_t packed_size = lut_packed_get_size(size, &pack4);
+        q7_t *mid = malloc(size);
+        q7_t *ref = malloc(size);
+        q7_t *out = malloc(size);
+        uint8_t *packed_mid = malloc(packed_size);
+        for (int32_t v2 = 0; v2 <= 1; v2++)
+        {
+            //q7 chain
+            run_layer(l, v2, NULL, NULL, (const uint8_t *)l->input, 1, (uint8_t *)mid);
+            const double q7_ms = run_layer(l, v2, NULL, NULL, (const uint8_t *)mid, repeats, (uint8_t *)ref);
+            //4-bit chain
+            run_layer(l, v2, NULL, &pack4, (const uint8_t *)l->input, 1, packed_mid);
+            const double packed_ms = run_layer(l, v2, &pack4, NULL, packed_mid, repeats, (uint8_t *)out);
+            printf("%-7s %-4s %8d %8d %10.3f %10.3f %8.2f %10s %10s\n", l->name, v2 ? "v2" : "v1", (int)size,
+                   (int)packed_size, q7_ms, packed_ms, q7_ms / packed_ms,
+                   memcmp(ref, out, size) == 0 ? "bit-exact" : "MISMATCH",
+                   check_pool_add(mid, &l->output_dims, &pack4) ? "bit-exact" : "MISMATCH");
+        }
+        free(mid);
+        free(ref);
+        free(out);
+        free(packed_mid);
+    }
+    return 0;
+}
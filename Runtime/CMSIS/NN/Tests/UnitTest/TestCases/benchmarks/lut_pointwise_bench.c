@@ -0,0 +1,107 @@
+/*
+Host benchmark of the pointwise LUT kernels (lut_conv_zdim_v1_pointwise / lut_conv_zdim_v2_pointwise) against the
+generic lut_conv_zdim_v1 / lut_conv_zdim_v2_double_lookup on the 1x1 expansion and projection layers of mobilenet_v2.
+The data set has no index header for mobilenet_v2, so inputs and indices are random; quantization comes from the data
+set. Every layer is checked out of place and, when C_OUT <= C_IN, in place (output written over the input).
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_pointwise_bench.c lut_utiles.c ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c \
+    -o lut_pointwise_bench
+./lut_pointwise_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/mobilenet_v2/config_data.h"
+#include "../../../../../../TestData_fullnetwork/mobilenet_v2/biases_data.h"
+#include "../../../../../../TestData_fullnetwork/mobilenet_v2/output_mult_data.h"
+#include "../../../../../../TestData_fullnetwork/mobilenet_v2/output_shift_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//expansion / projection pairs of every resolution, plus the last 1x1 layer
+#define BENCH_LAYERS 10
+
+//time of one call in ms
+static double run_layer(const bench_layer *l, const q7_t *input, const uint8_t *kernel_idx, const int32_t v2,
+                        const int32_t pointwise, const int32_t repeats, q7_t *out)
+{
+    cmsis_nn_context ctx;
+    ctx.size = lut_conv_zdim_pointwise_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+    lut_conv_kernel kernel = v2 ? (pointwise ? lut_conv_zdim_v2_pointwise : lut_conv_zdim_v2_double_lookup)
+                                : (pointwise ? lut_conv_zdim_v1_pointwise : lut_conv_zdim_v1);
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        kernel(&ctx, &l->conv_params, &l->quant_params, &l->input_dims, input, &l->filter_dims, kernel_idx,
+               &l->bias_dims, l->bias, &l->output_dims, lut_data, out);
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 5;
+    bench_layer layers[BENCH_LAYERS];
+    SET_BENCH_LAYER(&layers[0], 6);
+    SET_BENCH_LAYER(&layers[1], 8);
+    SET_BENCH_LAYER(&layers[2], 17);
+    SET_BENCH_LAYER(&layers[3], 19);
+    SET_BENCH_LAYER(&layers[4], 26);
+    SET_BENCH_LAYER(&layers[5], 28);
+    SET_BENCH_LAYER(&layers[6], 39);
+    SET_BENCH_LAYER(&layers[7], 41);
+    SET_BENCH_LAYER(&layers[8], 48);
+    SET_BENCH_LAYER(&layers[9], 58);
+
+    printf("%-8s %-14s %-4s %10s %12s %8s %10s %10s\n", "layer", "shape", "kern", "generic ms", "pointwise ms",
+           "speedup", "output", "in place");
+    srand(1);
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const bench_layer *l = &layers[i];
+        const int32_t in_size = l->input_dims.h * l->input_dims.w * l->input_dims.c;
+        const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        const int32_t idx_size = l->input_dims.c / 8 * l->output_dims.c;
+        q7_t *input = malloc(in_size);
+        uint8_t *kernel_idx = malloc(idx_size);
+        q7_t *ref = malloc(out_size);
+        q7_t *out = malloc(out_size > in_size ? out_size : in_size);
+        for (int32_t j = 0; j < in_size; j++)
+        {
+            input[j] = (q7_t)(rand() % 256 - 128);
+        }
+        for (int32_t j = 0; j < idx_size; j++)
+        {
+            kernel_idx[j] = (uint8_t)(rand() % LUT_SIZE);
+        }
+
+        for (int32_t v2 = 0; v2 <= 1; v2++)
+        {
+            char shape[32];
+            snprintf(shape, sizeof(shape), "%dx%dx%d->%d", (int)l->input_dims.h, (int)l->input_dims.w,
+                     (int)l->input_dims.c, (int)l->output_dims.c);
+            const double generic_ms = run_layer(l, input, kernel_idx, v2, 0, repeats, ref);
+            const double pointwise_ms = run_layer(l, input, kernel_idx, v2, 1, repeats, out);
+            const int exact = memcmp(ref, out, out_size) == 0;
+            const char *in_place = "-";
+            if (l->output_dims.c <= l->input_dims.c)
+            {
+                memcpy(out, input, in_size);
+                run_layer(l, out, kernel_idx, v2, 1, 1, out);
+                in_place = memcmp(ref, out, out_size) == 0 ? "bit-exact" : "MISMATCH";
+            }
+            printf("layer%-3d %-14s %-4s %10.3f %12.3f %8.2f %10s %10s\n", (int)l->n, shape, v2 ? "v2" : "v1",
+                   generic_ms, pointwise_ms, generic_ms / pointwise_ms, exact ? "bit-exact" : "MISMATCH", in_place);
+        }
+        free(input);
+        free(kernel_idx);
+        free(ref);
+        free(out);
+    }
+    return 0;
+}
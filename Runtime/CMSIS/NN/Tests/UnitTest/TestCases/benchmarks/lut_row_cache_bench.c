@@ -0,0 +1,108 @@
+/*
+Host benchmark of the SRAM LUT row cache (lut_row_cache.c) on the benchmarklayers data set (64-wide pool).
+For a range of cache sizes it runs lut_conv_zdim_v1_cached / lut_conv_zdim_v2_cached on every layer and prints the
+hit rate, the flash bytes read for LUT rows compared to the uncached kernels, and checks the output against them.
+Each size is run cold, and again after lut_row_cache_warm with the row counts of the cold run (warm: the warmed rows
+can still be replaced, pinned: they stay).
+Runs on Linux, on the boards the hit rates are the same and every hit saves a LUT_SIZE byte flash copy.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_row_cache_bench.c lut_utiles.c ../../../../Source/NNSupportFunctions/lut_row_cache.c \
+    ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c -o lut_row_cache_bench
+./lut_row_cache_bench
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+
+static arm_status run_layer(const bench_layer *l, lut_row_cache *cache, q7_t *out)
+{
+    cmsis_nn_context ctx;
+    ctx.size = lut_conv_zdim_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+    arm_status status;
+    if (cache == NULL)
+    {
+        status = (l->double_lookup ? lut_conv_zdim_v2_double_lookup : lut_conv_zdim_v1)(
+            &ctx, &l->conv_params, &l->quant_params, &l->input_dims, l->input, &l->filter_dims, l->kernel_idx,
+            &l->bias_dims, l->bias, &l->output_dims, lut_data, out);
+    }
+    else
+    {
+        status = (l->double_lookup ? lut_conv_zdim_v2_cached : lut_conv_zdim_v1_cached)(
+            &ctx, &l->conv_params, &l->quant_params, &l->input_dims, l->input, &l->filter_dims, l->kernel_idx,
+            &l->bias_dims, l->bias, &l->output_dims, lut_data, cache, out);
+    }
+    free(ctx.buf);
+    return status;
+}
+
+int main(void)
+{
+    static const int32_t cache_rows[] = {4, 8, 16, 32, 64};
+    bench_layer layers[BENCH_LAYERS];
+    SET_BENCHMARKLAYERS_LAYER(&layers[0], 1);
+    SET_BENCHMARKLAYERS_LAYER(&layers[1], 2);
+    SET_BENCHMARKLAYERS_LAYER(&layers[2], 3);
+    layers[2].double_lookup = 1;
+    SET_BENCHMARKLAYERS_LAYER(&layers[3], 4);
+    layers[3].double_lookup = 1;
+
+    printf("%-8s %5s %4s %9s %8s %12s %12s %10s\n", "layer", "rows", "ways", "KB sram", "warm", "hit rate", "flash KB",
+           "output");
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const bench_layer *l = &layers[i];
+        const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        q7_t *ref = malloc(out_size);
+        q7_t *out = malloc(out_size);
+        run_layer(l, NULL, ref);
+
+        for (uint32_t r = 0; r < sizeof(cache_rows) / sizeof(cache_rows[0]); r++)
+        {
+            for (int32_t ways = 1; ways <= 2; ways++)
+            {
+                static uint32_t row_count[256];
+                lut_row_cache cache;
+                const int32_t size = lut_row_cache_get_buffer_size(cache_rows[r] / ways, ways);
+                void *buf = malloc(size);
+                lut_row_cache_init(&cache, buf, size, ways, lut_data);
+
+                static const char *modes[] = {"cold", "warm", "pinned"};
+                for (int32_t warm = 0; warm <= 2; warm++)
+                {
+                    if (warm)
+                    {
+                        lut_row_cache_warm(&cache, row_count, warm == 2);
+                    }
+                    else
+                    {
+                        memset(row_count, 0, sizeof(row_count));
+                        cache.row_count = row_count;
+                    }
+                    memset(out, 0, out_size);
+                    const arm_status status = run_layer(l, &cache, out);
+                    cache.row_count = NULL;
+
+                    const uint32_t fetches = cache.hits + cache.misses;
+                    printf("%-8s %5d %4d %9.2f %8s %11.1f%% %5.1f/%-6.1f %10s\n", l->name, (int)cache_rows[r],
+                           (int)ways, size / 1024.0, modes[warm], 100.0 * cache.hits / fetches,
+                           cache.misses * (double)LUT_SIZE / 1024.0, fetches * (double)LUT_SIZE / 1024.0,
+                           status != ARM_MATH_SUCCESS ? "ERROR" : memcmp(ref, out, out_size) ? "MISMATCH" : "bit-exact");
+                }
+                free(buf);
+            }
+        }
+        free(ref);
+        free(out);
+    }
+    return 0;
+}
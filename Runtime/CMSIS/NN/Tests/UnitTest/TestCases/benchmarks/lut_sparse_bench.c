@@ -0,0 +1,114 @@
+/*
+Host benchmark of the zero skipping LUT kernels (lut_conv_zdim_v1_sparse / lut_conv_zdim_v2_sparse) on the
+benchmarklayers shapes and indices (64-wide pool).
+The test inputs of the data set are dense, so post-relu inputs are generated: every 8-channel group is zero with
+probability group_zero, the other values are zero with probability value_zero and uniform in 1..31 otherwise.
+Each layer is run with the dense and the sparse kernel, the outputs are compared and the zero block / zero plane
+counters are printed. The sparse kernel is also run on a copy of the LUT with row 0 cleared (a pool where a zero input
+gives a zero result), where zero blocks skip the filter walk.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_sparse_bench.c lut_utiles.c ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c -o lut_sparse_bench
+./lut_sparse_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+
+static void relu_input(q7_t *input, const int32_t size, const double group_zero, const double value_zero)
+{
+    for (int32_t i = 0; i < size; i += 8)
+    {
+        const int group = rand() < group_zero * RAND_MAX;
+        for (int32_t j = i; j < i + 8 && j < size; j++)
+        {
+            input[j] = (group || rand() < value_zero * RAND_MAX) ? 0 : (q7_t)(1 + rand() % 31);
+        }
+    }
+}
+
+//time of one call in ms, the output of the last call is left in out
+static double run_layer(const bench_layer *l, const q7_t *input, const uint8_t *lut, const int32_t sparse,
+                        lut_sparsity_stats *stats, const int32_t repeats, q7_t *out)
+{
+    cmsis_nn_context ctx;
+    ctx.size = lut_conv_zdim_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+    const double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        if (sparse)
+        {
+            (l->double_lookup ? lut_conv_zdim_v2_sparse : lut_conv_zdim_v1_sparse)(
+                &ctx, &l->conv_params, &l->quant_params, &l->input_dims, input, &l->filter_dims, l->kernel_idx,
+                &l->bias_dims, l->bias, &l->output_dims, lut, r == 0 ? stats : NULL, out);
+        }
+        else
+        {
+            (l->double_lookup ? lut_conv_zdim_v2_double_lookup : lut_conv_zdim_v1)(
+                &ctx, &l->conv_params, &l->quant_params, &l->input_dims, input, &l->filter_dims, l->kernel_idx,
+                &l->bias_dims, l->bias, &l->output_dims, lut, out);
+        }
+    }
+    free(ctx.buf);
+    return (now_ms() - start) / repeats;
+}
+
+int main(int argc, char **argv)
+{
+    static const double sparsity[][2] = {{0, 0}, {0, 0.5}, {0.25, 0.5}, {0.5, 0.5}, {0.75, 0.5}};
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 5;
+    static uint8_t lut_row0_zero[sizeof(lut_data)];
+    memcpy(lut_row0_zero, lut_data, sizeof(lut_data));
+    memset(lut_row0_zero, 0, LUT_SIZE);
+
+    bench_layer layers[BENCH_LAYERS];
+    SET_BENCHMARKLAYERS_LAYER(&layers[0], 1);
+    SET_BENCHMARKLAYERS_LAYER(&layers[1], 2);
+    SET_BENCHMARKLAYERS_LAYER(&layers[2], 3);
+    layers[2].double_lookup = 1;
+    SET_BENCHMARKLAYERS_LAYER(&layers[3], 4);
+    layers[3].double_lookup = 1;
+
+    printf("%-7s %-4s %6s %6s %8s %8s %10s %10s %10s %12s %10s\n", "layer", "kern", "group", "value", "zero blk",
+           "zero pl", "dense ms", "sparse ms", "row0=0 ms", "output", "row0=0");
+    srand(1);
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const bench_layer *l = &layers[i];
+        const int32_t in_size = l->input_dims.h * l->input_dims.w * l->input_dims.c;
+        const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        q7_t *input = malloc(in_size);
+        q7_t *ref = malloc(out_size);
+        q7_t *out = malloc(out_size);
+
+        for (uint32_t s = 0; s < sizeof(sparsity) / sizeof(sparsity[0]); s++)
+        {
+            lut_sparsity_stats stats = {0}, stats_row0 = {0};
+            relu_input(input, in_size, sparsity[s][0], sparsity[s][1]);
+            const double dense_ms = run_layer(l, input, lut_data, 0, NULL, repeats, ref);
+            const double sparse_ms = run_layer(l, input, lut_data, 1, &stats, repeats, out);
+            const int exact = memcmp(ref, out, out_size) == 0;
+            run_layer(l, input, lut_row0_zero, 0, NULL, 1, ref);
+            const double row0_ms = run_layer(l, input, lut_row0_zero, 1, &stats_row0, repeats, out);
+            const int exact_row0 = memcmp(ref, out, out_size) == 0;
+
+            printf("%-7s %-4s %6.2f %6.2f %7.1f%% %7.1f%% %10.3f %10.3f %10.3f %12s %10s\n", l->name,
+                   l->double_lookup ? "v2" : "v1", sparsity[s][0], sparsity[s][1],
+                   100.0 * stats.zero_blocks / stats.blocks, 100.0 * stats.zero_planes / stats.planes, dense_ms,
+                   sparse_ms, row0_ms, exact ? "bit-exact" : "MISMATCH", exact_row0 ? "bit-exact" : "MISMATCH");
+        }
+        free(input);
+        free(ref);
+        free(out);
+    }
+    return 0;
+}
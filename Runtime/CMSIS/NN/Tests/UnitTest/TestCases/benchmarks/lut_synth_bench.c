@@ -0,0 +1,134 @@
+/*
+Host benchmark of the on-device LUT synthesis (lut_synth.c) on the benchmarklayers shapes and indices (64-wide pool).
+The data set has no pool vectors for this pool, so a random int8 pool is used with a fixed entry requantization.
+The synthesized table is checked against a direct evaluation of every entry. Then, for every layer, only the
+columns the layer references are synthesized into a table filled with garbage, and the layer output is compared with
+the output on the full reference table. The synthesis time is printed next to the layer time.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_synth_bench.c lut_utiles.c ../../../../Source/NetworkFunctions/lut_synth.c \
+    ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c -o lut_synth_bench
+./lut_synth_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LAYERS 4
+
+//layer table entry of a benchmarklayers layer, lut_synth reads the indices of the lut_layer entries
+static void set_lut_layer(lut_layer *l, const bench_layer *b)
+{
+    memset(l, 0, sizeof(lut_layer));
+    l->type = LUT_LAYER_LUT_CONV_V2;
+    l->conv_params = b->conv_params;
+    l->quant_params = b->quant_params;
+    l->input_dims = b->input_dims;
+    l->filter_dims = b->filter_dims;
+    l->output_dims = b->output_dims;
+    l->bias_data = b->bias;
+    l->kernel_idx = b->kernel_idx;
+}
+
+static void run_layer(const lut_layer *l, const q7_t *input, const uint8_t *lut, q7_t *out)
+{
+    cmsis_nn_context ctx;
+    cmsis_nn_dims bias_dims = {1, 1, 1, l->output_dims.c};
+    ctx.size = lut_conv_zdim_get_buffer_size(&l->output_dims);
+    ctx.buf = malloc(ctx.size);
+    lut_conv_zdim_v2_double_lookup(&ctx, &l->conv_params, &l->quant_params, &l->input_dims, input, &l->filter_dims,
+                                   l->kernel_idx, &bias_dims, l->bias_data, &l->output_dims, lut, out);
+    free(ctx.buf);
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 20;
+    static int8_t vectors[LUT_SIZE][8];
+    static uint8_t ref[256 * LUT_SIZE];
+    static uint8_t lut[256 * LUT_SIZE];
+    //partial sums of 8 int8 weights, scaled by 1/16 into a 6-bit signed entry
+    const lut_pool_vectors pool = {&vectors[0][0], LUT_SIZE, 0x40000000, -3, -32, 31};
+
+    srand(1);
+    for (int32_t k = 0; k < LUT_SIZE; k++)
+    {
+        for (int32_t j = 0; j < 8; j++)
+        {
+            vectors[k][j] = (int8_t)(rand() % 255 - 127);
+        }
+    }
+    for (int32_t row = 0; row < 256; row++)
+    {
+        for (int32_t k = 0; k < LUT_SIZE; k++)
+        {
+            int32_t sum = 0;
+            for (int32_t j = 0; j < 8; j++)
+            {
+                sum += (row >> j & 1) ? vectors[k][j] : 0;
+            }
+            const int32_t entry = arm_nn_requantize(sum, pool.multiplier, pool.shift);
+            ref[row * LUT_SIZE + k] = (uint8_t)MIN(MAX(entry, pool.entry_min), pool.entry_max);
+        }
+    }
+
+    double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        lut_synth_columns(&pool, NULL, lut);
+    }
+    const double full_ms = (now_ms() - start) / repeats;
+    printf("full table: %d bytes from %d bytes of pool vectors, %.3f ms, %s\n", (int)sizeof(lut), (int)sizeof(vectors),
+           full_ms, memcmp(ref, lut, sizeof(lut)) == 0 ? "exact" : "MISMATCH");
+
+    bench_layer bench[BENCH_LAYERS];
+    SET_BENCHMARKLAYERS_LAYER(&bench[0], 1);
+    SET_BENCHMARKLAYERS_LAYER(&bench[1], 2);
+    SET_BENCHMARKLAYERS_LAYER(&bench[2], 3);
+    SET_BENCHMARKLAYERS_LAYER(&bench[3], 4);
+    lut_layer layers[BENCH_LAYERS];
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        set_lut_layer(&layers[i], &bench[i]);
+    }
+
+    printf("%-7s %8s %10s %10s %10s\n", "layer", "columns", "synth ms", "layer ms", "output");
+    for (int32_t i = 0; i < BENCH_LAYERS; i++)
+    {
+        const lut_layer *l = &layers[i];
+        const int32_t in_size = l->input_dims.h * l->input_dims.w * l->input_dims.c;
+        const int32_t out_size = l->output_dims.h * l->output_dims.w * l->output_dims.c;
+        q7_t *input = malloc(in_size);
+        q7_t *expected = malloc(out_size);
+        q7_t *out = malloc(out_size);
+        for (int32_t j = 0; j < in_size; j++)
+        {
+            input[j] = (q7_t)(rand() % 256 - 128);
+        }
+        int32_t columns = 0;
+        //unused columns keep whatever was in the table
+        memset(lut, 0xA5, sizeof(lut));
+        start = now_ms();
+        for (int32_t r = 0; r < repeats; r++)
+        {
+            lut_synth_layer(l, &pool, lut, &columns);
+        }
+        const double synth_ms = (now_ms() - start) / repeats;
+        start = now_ms();
+        run_layer(l, input, lut, out);
+        const double layer_ms = now_ms() - start;
+        run_layer(l, input, ref, expected);
+        printf("layer%-2d %8d %10.3f %10.3f %10s\n", (int)i + 1, (int)columns, synth_ms, layer_ms,
+               memcmp(expected, out, out_size) == 0 ? "bit-exact" : "MISMATCH");
+        free(input);
+        free(expected);
+        free(out);
+    }
+    return 0;
+}
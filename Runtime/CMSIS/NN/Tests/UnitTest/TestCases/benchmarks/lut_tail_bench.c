@@ -0,0 +1,172 @@
+/*
+Host benchmark of the fused classifier tail (lut_classifier_tail) against the unfused chain arm_avgpool_s8 (global),
+lut_fully_connected_zdim and arm_softmax_s8 followed by a stable top-k sort. The feature map has the shape of the last
+resnet_14 layer (4x4x256) with random values, the FC indices and requantization are random. Classes, scores and the
+buffer bytes of both are printed, for softmax probabilities and for raw logits.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_tail_bench.c lut_utiles.c ../../../../Source/FullyConnectedFunctions/lut_classifier_tail.c \
+    ../../../../Source/FullyConnectedFunctions/lut_fully_connected_zdim.c ../../../../Source/PoolingFunctions/arm_avgpool_s8.c \
+    ../../../../Source/SoftmaxFunctions/arm_softmax_s8.c -o lut_tail_bench
+./lut_tail_bench [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAP_H 4
+#define MAP_W 4
+#define MAP_C 256
+#define TOP_K 5
+
+//unfused reference, returns the bytes of the intermediate tensors
+static int32_t reference_tail(const lut_tail_params *p, const q7_t *map, const int32_t num_classes, const int32_t k,
+                              int32_t *classes, q7_t *scores)
+{
+    const cmsis_nn_dims map_dims = {1, MAP_H, MAP_W, MAP_C};
+    const cmsis_nn_dims pool_filter_dims = {1, MAP_H, MAP_W, 1};
+    const cmsis_nn_dims pooled_dims = {1, 1, 1, MAP_C};
+    cmsis_nn_pool_params pool_params;
+    pool_params.stride.w = MAP_W;
+    pool_params.stride.h = MAP_H;
+    pool_params.padding.w = 0;
+    pool_params.padding.h = 0;
+    pool_params.activation = p->pool_activation;
+    q7_t pooled[MAP_C];
+    cmsis_nn_context pool_ctx;
+    pool_ctx.size = arm_avgpool_s8_get_buffer_size(1, MAP_C);
+    pool_ctx.buf = malloc(pool_ctx.size + 1);
+    arm_avgpool_s8(&pool_ctx, &pool_params, &map_dims, map, &pool_filter_dims, &pooled_dims, pooled);
+    free(pool_ctx.buf);
+
+    const cmsis_nn_dims fc_input_dims = {1, 1, 1, MAP_C};
+    const cmsis_nn_dims fc_filter_dims = {MAP_C, 1, 1, num_classes};
+    const cmsis_nn_dims out_dims = {1, 1, 1, num_classes};
+    q7_t *logits = malloc(num_classes);
+    q7_t *probs = malloc(num_classes);
+    cmsis_nn_context fc_ctx;
+    fc_ctx.size = lut_fully_connected_zdim_get_buffer_size(&out_dims);
+    fc_ctx.buf = malloc(fc_ctx.size);
+    lut_fully_connected_zdim(&fc_ctx, &p->fc_params, &p->fc_quant_params, &fc_input_dims, pooled, &fc_filter_dims,
+                             p->kernel_idx, &out_dims, p->bias, &out_dims, lut_data, p->coeffs, logits);
+    free(fc_ctx.buf);
+    const q7_t *out = logits;
+    if (p->softmax)
+    {
+        arm_softmax_s8(logits, 1, num_classes, p->softmax_mult, p->softmax_shift, p->softmax_diff_min, probs);
+        out = probs;
+    }
+    //stable top-k: best logit first, lower class first on ties
+    for (int32_t i = 0; i < k; i++)
+    {
+        int32_t best = -1;
+        for (int32_t n = 0; n < num_classes; n++)
+        {
+            int32_t taken = 0;
+            for (int32_t j = 0; j < i; j++)
+            {
+                taken |= classes[j] == n;
+            }
+            if (!taken && (best < 0 || logits[n] > logits[best]))
+            {
+                best = n;
+            }
+        }
+        classes[i] = best;
+        scores[i] = out[best];
+    }
+    free(logits);
+    free(probs);
+    return MAP_C + 2 * num_classes + fc_ctx.size;
+}
+
+static void run(const int32_t num_classes, const int32_t softmax, const q7_t *map, const int32_t repeats)
+{
+    uint8_t *kernel_idx = malloc(MAP_C / 8 * num_classes);
+    int32_t *bias = malloc(num_classes * sizeof(int32_t));
+    int32_t *mult = malloc(num_classes * sizeof(int32_t));
+    int32_t *shift = malloc(num_classes * sizeof(int32_t));
+    for (int32_t i = 0; i < MAP_C / 8 * num_classes; i++)
+    {
+        kernel_idx[i] = rand() % LUT_SIZE;
+    }
+    for (int32_t n = 0; n < num_classes; n++)
+    {
+        bias[n] = rand() % 4096 - 2048;
+        mult[n] = (1 << 30) + rand() % (1 << 29);
+        shift[n] = -9 - rand() % 2;
+    }
+    lut_tail_params p;
+    p.pool_activation.min = -128;
+    p.pool_activation.max = 127;
+    p.fc_params.input_offset = 0;
+    p.fc_params.filter_offset = 0;
+    p.fc_params.output_offset = -100;
+    p.fc_params.activation.min = -128;
+    p.fc_params.activation.max = 127;
+    p.fc_quant_params.multiplier = mult;
+    p.fc_quant_params.shift = shift;
+    p.kernel_idx = kernel_idx;
+    p.bias = bias;
+    p.coeffs = NULL;
+    p.softmax = softmax;
+    //softmax parameters of the CMSIS-NN softmax unit test
+    p.softmax_mult = 1077952576;
+    p.softmax_shift = 23;
+    p.softmax_diff_min = -248;
+
+    const cmsis_nn_dims map_dims = {1, MAP_H, MAP_W, MAP_C};
+    cmsis_nn_context ctx;
+    ctx.size = lut_classifier_tail_get_buffer_size(&map_dims);
+    ctx.buf = malloc(ctx.size);
+    int32_t ref_classes[TOP_K], classes[TOP_K];
+    q7_t ref_scores[TOP_K], scores[TOP_K];
+    int32_t ref_bytes = 0;
+    arm_status status = ARM_MATH_SUCCESS;
+
+    double start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        ref_bytes = reference_tail(&p, map, num_classes, TOP_K, ref_classes, ref_scores);
+    }
+    const double ref_ms = (now_ms() - start) / repeats;
+    start = now_ms();
+    for (int32_t r = 0; r < repeats; r++)
+    {
+        status |= lut_classifier_tail(&ctx, &p, &map_dims, map, num_classes, lut_data, TOP_K, classes, scores);
+    }
+    const double tail_ms = (now_ms() - start) / repeats;
+
+    const int32_t exact = memcmp(ref_classes, classes, sizeof(classes)) == 0 && memcmp(ref_scores, scores, TOP_K) == 0;
+    printf("classes %5d  %-7s  unfused %8.4f ms %6d B  fused %8.4f ms %6d B  top-1 %4d (%4d)  status %d  %s\n",
+           (int)num_classes, softmax ? "softmax" : "logits", ref_ms, (int)ref_bytes, tail_ms, (int)ctx.size,
+           (int)classes[0], (int)scores[0], (int)status, exact ? "bit-exact" : "MISMATCH");
+    free(ctx.buf);
+    free(kernel_idx);
+    free(bias);
+    free(mult);
+    free(shift);
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t repeats = argc > 1 ? atoi(argv[1]) : 20;
+    srand(1);
+    q7_t *map = malloc(MAP_H * MAP_W * MAP_C);
+    for (int32_t i = 0; i < MAP_H * MAP_W * MAP_C; i++)
+    {
+        map[i] = (q7_t)(rand() % 256 - 128);
+    }
+    const int32_t class_counts[] = {10, 100, 1000};
+    for (int32_t i = 0; i < 3; i++)
+    {
+        run(class_counts[i], 1, map, repeats);
+        run(class_counts[i], 0, map, repeats);
+    }
+    free(map);
+    return 0;
+}
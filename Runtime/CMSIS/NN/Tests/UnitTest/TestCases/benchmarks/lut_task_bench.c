@@ -0,0 +1,152 @@
+/*
+Host benchmark of the time-sliced executor (lut_network_task.c) on the LUT part of resnet_14 (32-wide pool).
+The network is run to completion with lut_network_task_step for several tile sizes and budgets, the host clock standing
+in for the cycle counter (1 cycle = 1 ns here). The output is compared with lut_network_stream_run, and the number of
+steps, the longest step against its budget and the step overhead outside the kernels are printed.
+
+Build from this directory:
+gcc -O2 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_task_bench.c ../../../../Source/NetworkFunctions/lut_network.c \
+    ../../../../Source/NetworkFunctions/lut_network_stream.c ../../../../Source/NetworkFunctions/lut_network_task.c \
+    ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c ../../../../Source/ConvolutionFunctions/arm_convolve_s8.c \
+    ../../../../Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s8_s16.c ../../../../Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s8.c \
+    ../../../../Source/NNSupportFunctions/arm_q7_to_q15_with_offset.c ../../../../Source/PoolingFunctions/arm_max_pool_s8.c \
+    ../../../../Source/FullyConnectedFunctions/lut_fully_connected_zdim.c -o lut_task_bench
+./lut_task_bench
+*/
+#include "arm_nnfunctions.h"
+#include "../../../../../../lut_zdim64_data.h"
+//test_data.h also pulls in the dense weights, which are not part of the resnet_14 data set
+#include "../../../../../../TestData_fullnetwork/resnet_14/config_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/biases_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/output_mult_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/output_shift_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/input_data.h"
+#include "../../../../../../index_data/resnet_14_data/resnet_14_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint32_t clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+
+static void set_layer(lut_layer *layer, lut_layer_type type,
+                      int32_t input_w, int32_t input_h, int32_t in_ch, int32_t out_ch,
+                      int32_t filter_x, int32_t filter_y, int32_t stride, int32_t pad,
+                      const int32_t *bias, const int32_t *mult, const int32_t *shift,
+                      const uint8_t *kernel_idx)
+{
+    memset(layer, 0, sizeof(lut_layer));
+    layer->type = type;
+    layer->input_dims.n = 1;
+    layer->input_dims.w = input_w;
+    layer->input_dims.h = input_h;
+    layer->input_dims.c = in_ch;
+    layer->filter_dims.n = out_ch;
+    layer->filter_dims.w = filter_x;
+    layer->filter_dims.h = filter_y;
+    layer->filter_dims.c = in_ch;
+    layer->output_dims.n = 1;
+    layer->output_dims.w = (input_w + 2 * pad - filter_x) / stride + 1;
+    layer->output_dims.h = (input_h + 2 * pad - filter_y) / stride + 1;
+    layer->output_dims.c = out_ch;
+    layer->conv_params.stride.w = stride;
+    layer->conv_params.stride.h = stride;
+    layer->conv_params.padding.w = pad;
+    layer->conv_params.padding.h = pad;
+    layer->conv_params.input_offset = CONVLAYER1_INPUT_OFFSET;
+    layer->conv_params.output_offset = CONVLAYER1_OUTPUT_OFFSET;
+    layer->conv_params.activation.min = CONVLAYER1_OUT_ACTIVATION_MIN;
+    layer->conv_params.activation.max = CONVLAYER1_OUT_ACTIVATION_MAX;
+    layer->quant_params.multiplier = (int32_t *)mult;
+    layer->quant_params.shift = (int32_t *)shift;
+    layer->bias_data = bias;
+    layer->kernel_idx = kernel_idx;
+}
+
+#define SET_LUT_LAYER(layer, type, N, index) \
+    set_layer(layer, type, CONVLAYER##N##_INPUT_W, CONVLAYER##N##_INPUT_H, CONVLAYER##N##_IN_CH, CONVLAYER##N##_OUT_CH, \
+              CONVLAYER##N##_FILTER_X, CONVLAYER##N##_FILTER_Y, CONVLAYER##N##_STRIDE_X, CONVLAYER##N##_PAD_X, \
+              convlayer##N##_biases, convlayer##N##_output_mult, convlayer##N##_output_shift, index)
+
+//run the whole network in steps of budget (ns, or tiles without a clock) and print the step statistics
+static void run_task(const lut_network *net, const int32_t tile_rows, const uint32_t budget, const lut_task_clock clock,
+                     const q7_t *ref)
+{
+    q7_t *out = malloc(CONVLAYER13_DST_SIZE);
+    cmsis_nn_context ctx;
+    ctx.size = lut_network_task_get_buffer_size(net);
+    ctx.buf = malloc(ctx.size);
+    lut_network_task task;
+    arm_status status = lut_network_task_init(&task, &ctx, net, convlayer2_input, out, tile_rows, clock);
+
+    uint32_t max_step = 0;
+    uint64_t total = 0;
+    while (status == ARM_MATH_SUCCESS && !lut_network_task_done(&task))
+    {
+        const uint32_t start = clock_ns();
+        status = lut_network_task_step(&task, budget);
+        const uint32_t step = clock_ns() - start;
+        max_step = step > max_step ? step : max_step;
+        total += step;
+        //the other work of the superloop would run here
+    }
+    printf("%4d %-6s %10u %7u %7u %10.3f %10.3f %10.3f %9.3f%% %10s\n", (int)tile_rows, clock ? "ns" : "tiles",
+           (unsigned)budget, (unsigned)task.steps, (unsigned)task.tiles, total * 1e-6, max_step * 1e-6,
+           task.max_tile_cycles * 1e-6, total ? 100.0 * task.overhead_cycles / total : 0.0,
+           status == ARM_MATH_SUCCESS && memcmp(ref, out, CONVLAYER13_DST_SIZE) == 0 ? "bit-exact" : "MISMATCH");
+    free(ctx.buf);
+    free(out);
+}
+
+int main(void)
+{
+    //LUT part of resnet_14 (layers 2 to 13), with the 2x2 pools implied by the layer dims
+    static lut_layer layers[14];
+    lut_layer *l = layers;
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 2, resnet_14_index_layer_2);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 3, resnet_14_index_layer_3);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 4, resnet_14_index_layer_4);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 5, resnet_14_index_layer_5);
+    set_layer(l++, LUT_LAYER_MAX_POOL_S8, 16, 16, 64, 64, 2, 2, 2, 0, NULL, NULL, NULL, NULL);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 6, resnet_14_index_layer_6);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 7, resnet_14_index_layer_7);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 8, resnet_14_index_layer_8);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 9, resnet_14_index_layer_9);
+    set_layer(l++, LUT_LAYER_MAX_POOL_S8, 8, 8, 128, 128, 2, 2, 2, 0, NULL, NULL, NULL, NULL);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 10, resnet_14_index_layer_10);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 11, resnet_14_index_layer_11);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 12, resnet_14_index_layer_12);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 13, resnet_14_index_layer_13);
+    lut_network net;
+    net.layers = layers;
+    net.num_layers = 14;
+    net.filter_pool_data = lut_data;
+
+    //reference: the depth-first executor in one call
+    q7_t *ref = malloc(CONVLAYER13_DST_SIZE);
+    cmsis_nn_context ctx;
+    ctx.size = lut_network_stream_get_buffer_size(&net);
+    ctx.buf = malloc(ctx.size);
+    lut_network_stream_run(&ctx, &net, convlayer2_input, ref);
+    free(ctx.buf);
+
+    printf("%4s %-6s %10s %7s %7s %10s %10s %10s %10s %10s\n", "rows", "budget", "", "steps", "tiles", "total ms",
+           "max step", "max tile", "overhead", "output");
+    run_task(&net, 1, 1, NULL, ref);
+    const uint32_t budgets[] = {100000, 500000, 2000000};
+    for (int32_t rows = 1; rows <= 4; rows *= 2)
+    {
+        for (int32_t b = 0; b < 3; b++)
+        {
+            run_task(&net, rows, budgets[b], clock_ns, ref);
+        }
+    }
+    free(ref);
+    return 0;
+}
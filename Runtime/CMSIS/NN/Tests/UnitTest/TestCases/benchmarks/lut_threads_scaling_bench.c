@@ -0,0 +1,157 @@
+/*
+Host scaling benchmark of the multi-threaded backend (lut_network_threads.c), 1 to N worker threads.
+Runs on Linux, not on the STM32 boards. Default data set is benchmarklayers (the 4 layers are timed separately), its
+indices address a 64-wide pool so it needs -DLUT_SIZE=64. Build with -DLUT_BENCH_RESNET14 instead to time the
+resnet_14 LUT layers (32-wide pool) as one network.
+
+Build from this directory:
+gcc -O2 -DLUT_SIZE=64 -DLUT_HOST_THREADS -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_threads_scaling_bench.c lut_utiles.c ../../../../Source/NetworkFunctions/lut_network.c \
+    ../../../../Source/NetworkFunctions/lut_network_stream.c ../../../../Source/NetworkFunctions/lut_network_threads.c \
+    ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c ../../../../Source/FullyConnectedFunctions/lut_fully_connected_zdim.c \
+    ../../../../Source/ConvolutionFunctions/arm_convolve_s8.c \
+    ../../../../Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s8_s16.c ../../../../Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s8.c \
+    ../../../../Source/NNSupportFunctions/arm_q7_to_q15_with_offset.c ../../../../Source/PoolingFunctions/arm_max_pool_s8.c \
+    -lpthread -o lut_threads_scaling_bench
+./lut_threads_scaling_bench [max_threads] [repeats]
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+#if defined(LUT_BENCH_RESNET14)
+//test_data.h also pulls in the dense weights, which are not part of the resnet_14 data set
+#include "../../../../../../TestData_fullnetwork/resnet_14/config_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/biases_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/output_mult_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/output_shift_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/input_data.h"
+#include "../../../../../../index_data/resnet_14_data/resnet_14_index_data.h"
+#else
+#include "../../../../../../TestData_fullnetwork/benchmarklayers/test_data.h"
+#include "../../../../../../index_data/benchmarklayers_data/benchmarklayers_index_data.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void set_layer(lut_layer *layer, lut_layer_type type,
+                      int32_t input_w, int32_t input_h, int32_t in_ch, int32_t out_ch,
+                      int32_t filter_x, int32_t filter_y, int32_t stride, int32_t pad,
+                      const int32_t *bias, const int32_t *mult, const int32_t *shift,
+                      const uint8_t *kernel_idx)
+{
+    memset(layer, 0, sizeof(lut_layer));
+    layer->type = type;
+    layer->input_dims.n = 1;
+    layer->input_dims.w = input_w;
+    layer->input_dims.h = input_h;
+    layer->input_dims.c = in_ch;
+    layer->filter_dims.n = out_ch;
+    layer->filter_dims.w = filter_x;
+    layer->filter_dims.h = filter_y;
+    layer->filter_dims.c = in_ch;
+    layer->output_dims.n = 1;
+    layer->output_dims.w = (input_w + 2 * pad - filter_x) / stride + 1;
+    layer->output_dims.h = (input_h + 2 * pad - filter_y) / stride + 1;
+    layer->output_dims.c = out_ch;
+    layer->conv_params.stride.w = stride;
+    layer->conv_params.stride.h = stride;
+    layer->conv_params.padding.w = pad;
+    layer->conv_params.padding.h = pad;
+    layer->conv_params.input_offset = CONVLAYER1_INPUT_OFFSET;
+    layer->conv_params.output_offset = CONVLAYER1_OUTPUT_OFFSET;
+    layer->conv_params.activation.min = CONVLAYER1_OUT_ACTIVATION_MIN;
+    layer->conv_params.activation.max = CONVLAYER1_OUT_ACTIVATION_MAX;
+    layer->quant_params.multiplier = (int32_t *)mult;
+    layer->quant_params.shift = (int32_t *)shift;
+    layer->bias_data = bias;
+    layer->kernel_idx = kernel_idx;
+}
+
+#define SET_LUT_LAYER(layer, type, N, index) \
+    set_layer(layer, type, CONVLAYER##N##_INPUT_W, CONVLAYER##N##_INPUT_H, CONVLAYER##N##_IN_CH, CONVLAYER##N##_OUT_CH, \
+              CONVLAYER##N##_FILTER_X, CONVLAYER##N##_FILTER_Y, CONVLAYER##N##_STRIDE_X, CONVLAYER##N##_PAD_X, \
+              convlayer##N##_biases, convlayer##N##_output_mult, convlayer##N##_output_shift, index)
+
+//time one network for 1..max_threads workers, the output of every run is compared with the single worker run
+static void scale_network(const char *name, const lut_network *net, const q7_t *input, const int32_t output_size,
+                          const int32_t max_threads, const int32_t repeats)
+{
+    q7_t *ref = malloc(output_size);
+    q7_t *out = malloc(output_size);
+    double base = 0;
+
+    for (int32_t threads = 1; threads <= max_threads; threads++)
+    {
+        lut_thread_pool *pool = lut_thread_pool_create(threads);
+        cmsis_nn_context ctx;
+        ctx.size = lut_network_parallel_get_buffer_size(net, threads);
+        ctx.buf = malloc(ctx.size);
+
+        arm_status status = lut_network_run_parallel(&ctx, pool, net, input, out); //warm up
+        const double start = now_ms();
+        for (int32_t r = 0; r < repeats; r++)
+        {
+            status |= lut_network_run_parallel(&ctx, pool, net, input, out);
+        }
+        const double ms = (now_ms() - start) / repeats;
+
+        if (threads == 1)
+        {
+            base = ms;
+            memcpy(ref, out, output_size);
+        }
+        printf("%-12s threads %2d  %9.3f ms  speedup %5.2f  status %d  %s\n", name, (int)threads, ms, base / ms,
+               (int)status, memcmp(ref, out, output_size) == 0 ? "bit-exact" : "MISMATCH");
+
+        free(ctx.buf);
+        lut_thread_pool_destroy(pool);
+    }
+    free(ref);
+    free(out);
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t max_threads = argc > 1 ? atoi(argv[1]) : (int32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    const int32_t repeats = argc > 2 ? atoi(argv[2]) : 10;
+    lut_network net;
+    net.filter_pool_data = lut_data;
+
+#if defined(LUT_BENCH_RESNET14)
+    //LUT part of resnet_14 (layers 2 to 13), with the 2x2 pools implied by the layer dims
+    static lut_layer layers[14];
+    lut_layer *l = layers;
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 2, resnet_14_index_layer_2);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 3, resnet_14_index_layer_3);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 4, resnet_14_index_layer_4);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 5, resnet_14_index_layer_5);
+    set_layer(l++, LUT_LAYER_MAX_POOL_S8, 16, 16, 64, 64, 2, 2, 2, 0, NULL, NULL, NULL, NULL);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 6, resnet_14_index_layer_6);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 7, resnet_14_index_layer_7);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 8, resnet_14_index_layer_8);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 9, resnet_14_index_layer_9);
+    set_layer(l++, LUT_LAYER_MAX_POOL_S8, 8, 8, 128, 128, 2, 2, 2, 0, NULL, NULL, NULL, NULL);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 10, resnet_14_index_layer_10);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 11, resnet_14_index_layer_11);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 12, resnet_14_index_layer_12);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 13, resnet_14_index_layer_13);
+    net.layers = layers;
+    net.num_layers = 14;
+    scale_network("resnet_14", &net, convlayer2_input, CONVLAYER13_DST_SIZE, max_threads, repeats);
+#else
+    lut_layer layer;
+    net.layers = &layer;
+    net.num_layers = 1;
+    SET_LUT_LAYER(&layer, LUT_LAYER_LUT_CONV_V1, 1, benchmarklayers_index_layer_1);
+    scale_network("layer1 v1", &net, convlayer1_input, CONVLAYER1_DST_SIZE, max_threads, repeats);
+    SET_LUT_LAYER(&layer, LUT_LAYER_LUT_CONV_V1, 2, benchmarklayers_index_layer_2);
+    scale_network("layer2 v1", &net, convlayer2_input, CONVLAYER2_DST_SIZE, max_threads, repeats);
+    SET_LUT_LAYER(&layer, LUT_LAYER_LUT_CONV_V2, 3, benchmarklayers_index_layer_3);
+    scale_network("layer3 v2", &net, convlayer3_input, CONVLAYER3_DST_SIZE, max_threads, repeats);
+    SET_LUT_LAYER(&layer, LUT_LAYER_LUT_CONV_V2, 4, benchmarklayers_index_layer_4);
+    scale_network("layer4 v2", &net, convlayer4_input, CONVLAYER4_DST_SIZE, max_threads, repeats);
+#endif
+    return 0;
+}
@@ -5,7 +5,7 @@ void mem_write_range(int start_addr, int size){
     for (int i = 0; i < size; i++){
         volatile unsigned char *ptr;
         int addr = start_addr + i;
-        ptr = (char*)addr;
+        ptr = (volatile unsigned char *)(uintptr_t)addr;
         *ptr = i;
     }
 }
@@ -14,4 +14,15 @@ void kernel_idx_gen(uint32_t* kernel_idx, const uint32_t start_addr, const int s
    for(int i = 0; i < size; i++){
       kernel_idx[i] = start_addr + 9*i;
    }
-}
\ No newline at end of file
+}
+
+#if defined(__GNUC_PYTHON__)
+#include <time.h>
+
+double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+#endif
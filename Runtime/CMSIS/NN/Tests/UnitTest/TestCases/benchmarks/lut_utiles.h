@@ -1,4 +1,60 @@
 #include <stdint.h>
+#include <string.h>
+#include "arm_nnfunctions.h"
 
 void mem_write_range(int start_addr, int size);
 void kernel_idx_gen(uint32_t* kernel_idx, const uint32_t start_addr, const int size);
+
+#if defined(__GNUC_PYTHON__)
+//host clock of the lut_*_bench.c benchmarks, monotonic, in ms
+double now_ms(void);
+#endif
+
+//one convolution layer of a TestData_fullnetwork data set, as the lut_*_bench.c benchmarks run it
+typedef struct
+{
+    const char *name;
+    int32_t n;             //layer number in the data set
+    int32_t double_lookup; //run with the v2 kernel, set by the benchmarks that mix v1 and v2 layers
+    cmsis_nn_conv_params conv_params;
+    cmsis_nn_per_channel_quant_params quant_params;
+    cmsis_nn_dims input_dims, filter_dims, bias_dims, output_dims;
+    const int32_t *bias;
+    const q7_t *input;        //NULL unless set by SET_BENCHMARKLAYERS_LAYER
+    const uint8_t *kernel_idx; //NULL unless set by SET_BENCHMARKLAYERS_LAYER
+} bench_layer;
+
+//shape, offsets, activation range, requantization and bias of layer N, from the CONVLAYER<N>_* defines and the
+//convlayer<N>_* arrays of the data set
+#define SET_BENCH_LAYER(l, N)                                                                                          \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        memset((l), 0, sizeof(bench_layer));                                                                           \
+        (l)->name = "layer" #N;                                                                                        \
+        (l)->n = N;                                                                                                    \
+        (l)->conv_params.input_offset = CONVLAYER##N##_INPUT_OFFSET;                                                   \
+        (l)->conv_params.output_offset = CONVLAYER##N##_OUTPUT_OFFSET;                                                 \
+        (l)->conv_params.stride.w = CONVLAYER##N##_STRIDE_X;                                                           \
+        (l)->conv_params.stride.h = CONVLAYER##N##_STRIDE_Y;                                                           \
+        (l)->conv_params.padding.w = CONVLAYER##N##_PAD_X;                                                             \
+        (l)->conv_params.padding.h = CONVLAYER##N##_PAD_Y;                                                             \
+        (l)->conv_params.activation.min = CONVLAYER##N##_OUT_ACTIVATION_MIN;                                           \
+        (l)->conv_params.activation.max = CONVLAYER##N##_OUT_ACTIVATION_MAX;                                           \
+        (l)->quant_params.multiplier = (int32_t *)convlayer##N##_output_mult;                                          \
+        (l)->quant_params.shift = (int32_t *)convlayer##N##_output_shift;                                              \
+        (l)->input_dims = (cmsis_nn_dims){1, CONVLAYER##N##_INPUT_H, CONVLAYER##N##_INPUT_W, CONVLAYER##N##_IN_CH};    \
+        (l)->filter_dims = (cmsis_nn_dims){CONVLAYER##N##_OUT_CH, CONVLAYER##N##_FILTER_Y, CONVLAYER##N##_FILTER_X,    \
+                                           CONVLAYER##N##_IN_CH};                                                      \
+        (l)->bias_dims = (cmsis_nn_dims){1, 1, 1, CONVLAYER##N##_OUT_CH};                                              \
+        (l)->output_dims = (cmsis_nn_dims){1, CONVLAYER##N##_OUTPUT_H, CONVLAYER##N##_OUTPUT_W, CONVLAYER##N##_OUT_CH}; \
+        (l)->bias = convlayer##N##_biases;                                                                             \
+    } while (0)
+
+//SET_BENCH_LAYER plus the test input and the weight pool indices of the benchmarklayers data set
+#define SET_BENCHMARKLAYERS_LAYER(l, N)                                                                                \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        SET_BENCH_LAYER(l, N);                                                                                         \
+        (l)->input = convlayer##N##_input;                                                                             \
+        (l)->kernel_idx = benchmarklayers_index_layer_##N;                                                             \
+    } while (0)
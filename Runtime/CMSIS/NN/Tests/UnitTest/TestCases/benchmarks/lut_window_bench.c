@@ -0,0 +1,166 @@
+/*
+Host benchmark of the sliding window executor (lut_network_window.c) on the LUT part of resnet_14 (32-wide pool), the
+input rows being the time axis. A stream of input rows is pushed hop rows at a time. After every push the output is
+compared with lut_network_stream_run on the same window, and the time per frame of both and the share of output rows
+computed are printed. The 16 row stage (layers 2 to 5) slides by any hop, the whole LUT part has two 2x2 pools and
+needs a multiple of 4.
+
+Build from this directory:
+gcc -O2 -D__GNUC_PYTHON__ -D__RESTRICT=__restrict -I../../../../Include -I../../../../../DSP/Include \
+    lut_window_bench.c lut_utiles.c ../../../../Source/NetworkFunctions/lut_network.c \
+    ../../../../Source/NetworkFunctions/lut_network_stream.c ../../../../Source/NetworkFunctions/lut_network_window.c \
+    ../../../../Source/ConvolutionFunctions/lut_convolve_zdim.c ../../../../Source/ConvolutionFunctions/arm_convolve_s8.c \
+    ../../../../Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s8_s16.c ../../../../Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s8.c \
+    ../../../../Source/NNSupportFunctions/arm_q7_to_q15_with_offset.c ../../../../Source/PoolingFunctions/arm_max_pool_s8.c \
+    ../../../../Source/FullyConnectedFunctions/lut_fully_connected_zdim.c -o lut_window_bench
+./lut_window_bench [frames]   (frames >= 2, default 32)
+*/
+#include "arm_nnfunctions.h"
+#include "lut_utiles.h"
+#include "../../../../../../lut_zdim64_data.h"
+//test_data.h also pulls in the dense weights, which are not part of the resnet_14 data set
+#include "../../../../../../TestData_fullnetwork/resnet_14/config_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/biases_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/output_mult_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/output_shift_data.h"
+#include "../../../../../../TestData_fullnetwork/resnet_14/input_data.h"
+#include "../../../../../../index_data/resnet_14_data/resnet_14_index_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void set_layer(lut_layer *layer, lut_layer_type type,
+                      int32_t input_w, int32_t input_h, int32_t in_ch, int32_t out_ch,
+                      int32_t filter_x, int32_t filter_y, int32_t stride, int32_t pad,
+                      const int32_t *bias, const int32_t *mult, const int32_t *shift,
+                      const uint8_t *kernel_idx)
+{
+    memset(layer, 0, sizeof(lut_layer));
+    layer->type = type;
+    layer->input_dims.n = 1;
+    layer->input_dims.w = input_w;
+    layer->input_dims.h = input_h;
+    layer->input_dims.c = in_ch;
+    layer->filter_dims.n = out_ch;
+    layer->filter_dims.w = filter_x;
+    layer->filter_dims.h = filter_y;
+    layer->filter_dims.c = in_ch;
+    layer->output_dims.n = 1;
+    layer->output_dims.w = (input_w + 2 * pad - filter_x) / stride + 1;
+    layer->output_dims.h = (input_h + 2 * pad - filter_y) / stride + 1;
+    layer->output_dims.c = out_ch;
+    layer->conv_params.stride.w = stride;
+    layer->conv_params.stride.h = stride;
+    layer->conv_params.padding.w = pad;
+    layer->conv_params.padding.h = pad;
+    layer->conv_params.input_offset = CONVLAYER1_INPUT_OFFSET;
+    layer->conv_params.output_offset = CONVLAYER1_OUTPUT_OFFSET;
+    layer->conv_params.activation.min = CONVLAYER1_OUT_ACTIVATION_MIN;
+    layer->conv_params.activation.max = CONVLAYER1_OUT_ACTIVATION_MAX;
+    layer->quant_params.multiplier = (int32_t *)mult;
+    layer->quant_params.shift = (int32_t *)shift;
+    layer->bias_data = bias;
+    layer->kernel_idx = kernel_idx;
+}
+
+#define SET_LUT_LAYER(layer, type, N, index) \
+    set_layer(layer, type, CONVLAYER##N##_INPUT_W, CONVLAYER##N##_INPUT_H, CONVLAYER##N##_IN_CH, CONVLAYER##N##_OUT_CH, \
+              CONVLAYER##N##_FILTER_X, CONVLAYER##N##_FILTER_Y, CONVLAYER##N##_STRIDE_X, CONVLAYER##N##_PAD_X, \
+              convlayer##N##_biases, convlayer##N##_output_mult, convlayer##N##_output_shift, index)
+
+//push frames of hop rows of the stream, comparing every output with a full run of the same window
+static void run_hop(const char *name, const lut_network *net, const int32_t hop, const int32_t frames,
+                    const q7_t *stream)
+{
+    const cmsis_nn_dims *in_dims = &net->layers[0].input_dims;
+    const cmsis_nn_dims *out_dims = &net->layers[net->num_layers - 1].output_dims;
+    const int32_t row = in_dims->w * in_dims->c;
+    const int32_t out_size = out_dims->h * out_dims->w * out_dims->c;
+    //window of the reference, starting as zero rows like the sliding window
+    q7_t *window = calloc(in_dims->h * row, 1);
+    q7_t *ref = malloc(out_size);
+    cmsis_nn_context stream_ctx, win_ctx;
+    stream_ctx.size = lut_network_stream_get_buffer_size(net);
+    stream_ctx.buf = malloc(stream_ctx.size);
+    win_ctx.size = lut_network_window_get_buffer_size(net);
+    win_ctx.buf = malloc(win_ctx.size);
+
+    lut_network_window win;
+    arm_status status = lut_network_window_init(&win, &win_ctx, net, hop);
+    double full_ms = 0, push_ms = 0;
+    int32_t exact = 1;
+    for (int32_t f = 0; f < frames && status == ARM_MATH_SUCCESS; f++)
+    {
+        const q7_t *frame = stream + f * hop * row;
+        memmove(window, window + hop * row, (in_dims->h - hop) * row);
+        memcpy(window + (in_dims->h - hop) * row, frame, hop * row);
+
+        double start = now_ms();
+        status = lut_network_stream_run(&stream_ctx, net, window, ref);
+        full_ms += now_ms() - start;
+
+        start = now_ms();
+        status |= lut_network_window_push(&win, frame);
+        //the first push computes the whole network, not timed
+        push_ms += f > 0 ? now_ms() - start : 0;
+        exact &= memcmp(ref, lut_network_window_output(&win), out_size) == 0;
+    }
+    printf("%-10s hop %2d  full %8.3f ms  push %8.3f ms  speedup %5.2f  rows computed %5.1f%%  status %d  %s\n", name,
+           (int)hop, full_ms / frames, push_ms / (frames - 1), full_ms / frames / (push_ms / (frames - 1)),
+           100.0 * win.rows_computed / (win.rows_computed + win.rows_reused), (int)status,
+           exact ? "bit-exact" : "MISMATCH");
+    free(window);
+    free(ref);
+    free(stream_ctx.buf);
+    free(win_ctx.buf);
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t frames = argc > 1 ? atoi(argv[1]) : 32;
+    //the first push is not timed, so the push average needs at least two frames
+    if (frames < 2)
+    {
+        printf("usage: %s [frames], frames >= 2\n", argv[0]);
+        return 1;
+    }
+    //LUT part of resnet_14 (layers 2 to 13), with the 2x2 pools implied by the layer dims
+    static lut_layer layers[14];
+    lut_layer *l = layers;
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 2, resnet_14_index_layer_2);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 3, resnet_14_index_layer_3);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 4, resnet_14_index_layer_4);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 5, resnet_14_index_layer_5);
+    set_layer(l++, LUT_LAYER_MAX_POOL_S8, 16, 16, 64, 64, 2, 2, 2, 0, NULL, NULL, NULL, NULL);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 6, resnet_14_index_layer_6);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 7, resnet_14_index_layer_7);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 8, resnet_14_index_layer_8);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 9, resnet_14_index_layer_9);
+    set_layer(l++, LUT_LAYER_MAX_POOL_S8, 8, 8, 128, 128, 2, 2, 2, 0, NULL, NULL, NULL, NULL);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 10, resnet_14_index_layer_10);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 11, resnet_14_index_layer_11);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 12, resnet_14_index_layer_12);
+    SET_LUT_LAYER(l++, LUT_LAYER_LUT_CONV_V2, 13, resnet_14_index_layer_13);
+    lut_network net;
+    net.layers = layers;
+    net.filter_pool_data = lut_data;
+
+    //input rows over time: the test input repeated with a different bias on every pass
+    const int32_t row = CONVLAYER2_INPUT_W * CONVLAYER2_IN_CH;
+    const int32_t stream_rows = frames * 4;
+    q7_t *stream = malloc(stream_rows * row);
+    for (int32_t r = 0; r < stream_rows; r++)
+    {
+        for (int32_t j = 0; j < row; j++)
+        {
+            stream[r * row + j] = (q7_t)(convlayer2_input[(r % CONVLAYER2_INPUT_H) * row + j] + r / CONVLAYER2_INPUT_H);
+        }
+    }
+    net.num_layers = 4;
+    run_hop("layers 2-5", &net, 1, frames, stream);
+    run_hop("layers 2-5", &net, 2, frames, stream);
+    net.num_layers = 14;
+    run_hop("resnet_14", &net, 4, frames, stream);
+    free(stream);
+    return 0;
+}
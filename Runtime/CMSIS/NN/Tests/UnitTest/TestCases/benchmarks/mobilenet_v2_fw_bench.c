@@ -900,12 +900,12 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf);
 
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv2, &filter_dims_conv2);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv2);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
     //result_arm = lut_conv_zdim_v1(&ctx,
-    result_arm = lut_conv_zdim_v1(&ctx,
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv2,
@@ -940,12 +940,12 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf);    
 
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv4, &filter_dims_conv4);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv4);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
     //result_arm = lut_conv_zdim_v1(&ctx,
-    result_arm = lut_conv_zdim_v1(&ctx,
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv4,
@@ -960,12 +960,12 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf); 
     
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv5, &filter_dims_conv5);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv5);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
     //result_arm = lut_conv_zdim_v1(&ctx,
-    result_arm = lut_conv_zdim_v1(&ctx,
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv5,
@@ -980,11 +980,11 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf); 
     
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv6, &filter_dims_conv6);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv6);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv6,
@@ -1017,11 +1017,11 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf); 
     
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv8, &filter_dims_conv8);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv8);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv8,
@@ -1036,11 +1036,11 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf); 
     
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv9, &filter_dims_conv9);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv9);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv9,
@@ -1055,11 +1055,11 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf); 
 
-			buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv10, &filter_dims_conv10);
+			buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv10);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv10,
@@ -1092,11 +1092,11 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf); 
     
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv12, &filter_dims_conv12);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv12);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv12,
@@ -1111,11 +1111,11 @@ void conv_fw_mobilenet_v2(void)
 
     free(ctx.buf); 
     
-    buf_size = arm_convolve_s8_get_buffer_size(&input_dims_conv13, &filter_dims_conv13);
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv13);
     ctx.buf = malloc(buf_size);
-    ctx.size = 0;
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,
                                         &conv_params,
                                         &quant_params,
                                         &input_dims_conv13,
@@ -1134,181 +1134,274 @@ void conv_fw_mobilenet_v2(void)
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv14,actbuf2,&filter_dims_conv14,kernel_data_conv14,&bias_dims_conv14,bias_data_conv14,&output_dims_conv14,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv15);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv15,actbuf1,&filter_dims_conv15,mobilenet_v2_index_layer_15,&bias_dims_conv15,bias_data_conv15,&output_dims_conv15,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv15,actbuf1,&filter_dims_conv15,mobilenet_v2_index_layer_15,&bias_dims_conv15,bias_data_conv15,&output_dims_conv15,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv16);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,&conv_params,&quant_params,&input_dims_conv16,actbuf2,&filter_dims_conv16,mobilenet_v2_index_layer_16,&bias_dims_conv16,bias_data_conv16,&output_dims_conv16,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv16,actbuf2,&filter_dims_conv16,mobilenet_v2_index_layer_16,&bias_dims_conv16,bias_data_conv16,&output_dims_conv16,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv17);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,&conv_params,&quant_params,&input_dims_conv17,actbuf1,&filter_dims_conv17,mobilenet_v2_index_layer_17,&bias_dims_conv17,bias_data_conv17,&output_dims_conv17,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv17,actbuf1,&filter_dims_conv17,mobilenet_v2_index_layer_17,&bias_dims_conv17,bias_data_conv17,&output_dims_conv17,lut_data,actbuf2);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv18,actbuf2,&filter_dims_conv18,kernel_data_conv18,&bias_dims_conv18,bias_data_conv18,&output_dims_conv18,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv19);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv19,actbuf1,&filter_dims_conv19,mobilenet_v2_index_layer_19,&bias_dims_conv19,bias_data_conv19,&output_dims_conv19,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv19,actbuf1,&filter_dims_conv19,mobilenet_v2_index_layer_19,&bias_dims_conv19,bias_data_conv19,&output_dims_conv19,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv20);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,&conv_params,&quant_params,&input_dims_conv20,actbuf2,&filter_dims_conv20,mobilenet_v2_index_layer_20,&bias_dims_conv20,bias_data_conv20,&output_dims_conv20,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv20,actbuf2,&filter_dims_conv20,mobilenet_v2_index_layer_20,&bias_dims_conv20,bias_data_conv20,&output_dims_conv20,lut_data,actbuf1);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv21,actbuf1,&filter_dims_conv21,kernel_data_conv21,&bias_dims_conv21,bias_data_conv21,&output_dims_conv21,actbuf2);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv22);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv22,actbuf2,&filter_dims_conv22,mobilenet_v2_index_layer_22,&bias_dims_conv22,bias_data_conv22,&output_dims_conv22,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv22,actbuf2,&filter_dims_conv22,mobilenet_v2_index_layer_22,&bias_dims_conv22,bias_data_conv22,&output_dims_conv22,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv23);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v1(&ctx,&conv_params,&quant_params,&input_dims_conv23,actbuf1,&filter_dims_conv23,mobilenet_v2_index_layer_23,&bias_dims_conv23,bias_data_conv23,&output_dims_conv23,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v1_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv23,actbuf1,&filter_dims_conv23,mobilenet_v2_index_layer_23,&bias_dims_conv23,bias_data_conv23,&output_dims_conv23,lut_data,actbuf2);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&stride2_conv_params,&quant_params,&input_dims_conv24,actbuf2,&filter_dims_conv24,kernel_data_conv24,&bias_dims_conv24,bias_data_conv24,&output_dims_conv24,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv25);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv25,actbuf1,&filter_dims_conv25,mobilenet_v2_index_layer_25,&bias_dims_conv25,bias_data_conv25,&output_dims_conv25,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv25,actbuf1,&filter_dims_conv25,mobilenet_v2_index_layer_25,&bias_dims_conv25,bias_data_conv25,&output_dims_conv25,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv26);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv26,actbuf2,&filter_dims_conv26,mobilenet_v2_index_layer_26,&bias_dims_conv26,bias_data_conv26,&output_dims_conv26,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv26,actbuf2,&filter_dims_conv26,mobilenet_v2_index_layer_26,&bias_dims_conv26,bias_data_conv26,&output_dims_conv26,lut_data,actbuf1);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv27,actbuf1,&filter_dims_conv27,kernel_data_conv27,&bias_dims_conv27,bias_data_conv27,&output_dims_conv27,actbuf2);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv28);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv28,actbuf2,&filter_dims_conv28,mobilenet_v2_index_layer_28,&bias_dims_conv28,bias_data_conv28,&output_dims_conv28,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv28,actbuf2,&filter_dims_conv28,mobilenet_v2_index_layer_28,&bias_dims_conv28,bias_data_conv28,&output_dims_conv28,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv29);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv29,actbuf1,&filter_dims_conv29,mobilenet_v2_index_layer_29,&bias_dims_conv29,bias_data_conv29,&output_dims_conv29,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv29,actbuf1,&filter_dims_conv29,mobilenet_v2_index_layer_29,&bias_dims_conv29,bias_data_conv29,&output_dims_conv29,lut_data,actbuf2);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv30,actbuf2,&filter_dims_conv30,kernel_data_conv30,&bias_dims_conv30,bias_data_conv30,&output_dims_conv30,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv31);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv31,actbuf1,&filter_dims_conv31,mobilenet_v2_index_layer_31,&bias_dims_conv31,bias_data_conv31,&output_dims_conv31,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv31,actbuf1,&filter_dims_conv31,mobilenet_v2_index_layer_31,&bias_dims_conv31,bias_data_conv31,&output_dims_conv31,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv32);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv32,actbuf2,&filter_dims_conv32,mobilenet_v2_index_layer_32,&bias_dims_conv32,bias_data_conv32,&output_dims_conv32,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv32,actbuf2,&filter_dims_conv32,mobilenet_v2_index_layer_32,&bias_dims_conv32,bias_data_conv32,&output_dims_conv32,lut_data,actbuf1);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv33,actbuf1,&filter_dims_conv33,kernel_data_conv33,&bias_dims_conv33,bias_data_conv33,&output_dims_conv33,actbuf2);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv34);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv34,actbuf2,&filter_dims_conv34,mobilenet_v2_index_layer_34,&bias_dims_conv34,bias_data_conv34,&output_dims_conv34,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv34,actbuf2,&filter_dims_conv34,mobilenet_v2_index_layer_34,&bias_dims_conv34,bias_data_conv34,&output_dims_conv34,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv35);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv35,actbuf1,&filter_dims_conv35,mobilenet_v2_index_layer_35,&bias_dims_conv35,bias_data_conv35,&output_dims_conv35,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv35,actbuf1,&filter_dims_conv35,mobilenet_v2_index_layer_35,&bias_dims_conv35,bias_data_conv35,&output_dims_conv35,lut_data,actbuf2);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv36,actbuf2,&filter_dims_conv36,kernel_data_conv36,&bias_dims_conv36,bias_data_conv36,&output_dims_conv36,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv37);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv37,actbuf1,&filter_dims_conv37,mobilenet_v2_index_layer_37,&bias_dims_conv37,bias_data_conv37,&output_dims_conv37,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv37,actbuf1,&filter_dims_conv37,mobilenet_v2_index_layer_37,&bias_dims_conv37,bias_data_conv37,&output_dims_conv37,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv38);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv38,actbuf2,&filter_dims_conv38,mobilenet_v2_index_layer_38,&bias_dims_conv38,bias_data_conv38,&output_dims_conv38,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv38,actbuf2,&filter_dims_conv38,mobilenet_v2_index_layer_38,&bias_dims_conv38,bias_data_conv38,&output_dims_conv38,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv39);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv39,actbuf1,&filter_dims_conv39,mobilenet_v2_index_layer_39,&bias_dims_conv39,bias_data_conv39,&output_dims_conv39,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv39,actbuf1,&filter_dims_conv39,mobilenet_v2_index_layer_39,&bias_dims_conv39,bias_data_conv39,&output_dims_conv39,lut_data,actbuf2);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv40,actbuf2,&filter_dims_conv40,kernel_data_conv40,&bias_dims_conv40,bias_data_conv40,&output_dims_conv40,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv41);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv41,actbuf1,&filter_dims_conv41,mobilenet_v2_index_layer_41,&bias_dims_conv41,bias_data_conv41,&output_dims_conv41,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv41,actbuf1,&filter_dims_conv41,mobilenet_v2_index_layer_41,&bias_dims_conv41,bias_data_conv41,&output_dims_conv41,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv42);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv42,actbuf2,&filter_dims_conv42,mobilenet_v2_index_layer_42,&bias_dims_conv42,bias_data_conv42,&output_dims_conv42,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv42,actbuf2,&filter_dims_conv42,mobilenet_v2_index_layer_42,&bias_dims_conv42,bias_data_conv42,&output_dims_conv42,lut_data,actbuf1);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv43,actbuf1,&filter_dims_conv43,kernel_data_conv43,&bias_dims_conv43,bias_data_conv43,&output_dims_conv43,actbuf2);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv44);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv44,actbuf2,&filter_dims_conv44,mobilenet_v2_index_layer_44,&bias_dims_conv44,bias_data_conv44,&output_dims_conv44,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv44,actbuf2,&filter_dims_conv44,mobilenet_v2_index_layer_44,&bias_dims_conv44,bias_data_conv44,&output_dims_conv44,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv45);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv45,actbuf1,&filter_dims_conv45,mobilenet_v2_index_layer_45,&bias_dims_conv45,bias_data_conv45,&output_dims_conv45,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv45,actbuf1,&filter_dims_conv45,mobilenet_v2_index_layer_45,&bias_dims_conv45,bias_data_conv45,&output_dims_conv45,lut_data,actbuf2);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&stride2_conv_params,&conv_params,&quant_params,&input_dims_conv46,actbuf2,&filter_dims_conv46,kernel_data_conv46,&bias_dims_conv46,bias_data_conv46,&output_dims_conv46,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv47);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv47,actbuf1,&filter_dims_conv47,mobilenet_v2_index_layer_47,&bias_dims_conv47,bias_data_conv47,&output_dims_conv47,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv47,actbuf1,&filter_dims_conv47,mobilenet_v2_index_layer_47,&bias_dims_conv47,bias_data_conv47,&output_dims_conv47,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv48);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv48,actbuf2,&filter_dims_conv48,mobilenet_v2_index_layer_48,&bias_dims_conv48,bias_data_conv48,&output_dims_conv48,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv48,actbuf2,&filter_dims_conv48,mobilenet_v2_index_layer_48,&bias_dims_conv48,bias_data_conv48,&output_dims_conv48,lut_data,actbuf1);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv49,actbuf1,&filter_dims_conv49,kernel_data_conv49,&bias_dims_conv49,bias_data_conv49,&output_dims_conv49,actbuf2);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv50);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv50,actbuf2,&filter_dims_conv50,mobilenet_v2_index_layer_50,&bias_dims_conv50,bias_data_conv50,&output_dims_conv50,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv50,actbuf2,&filter_dims_conv50,mobilenet_v2_index_layer_50,&bias_dims_conv50,bias_data_conv50,&output_dims_conv50,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv51);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv51,actbuf1,&filter_dims_conv51,mobilenet_v2_index_layer_51,&bias_dims_conv51,bias_data_conv51,&output_dims_conv51,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv51,actbuf1,&filter_dims_conv51,mobilenet_v2_index_layer_51,&bias_dims_conv51,bias_data_conv51,&output_dims_conv51,lut_data,actbuf2);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv52,actbuf2,&filter_dims_conv52,kernel_data_conv52,&bias_dims_conv52,bias_data_conv52,&output_dims_conv52,actbuf1);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv53);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv53,actbuf1,&filter_dims_conv53,mobilenet_v2_index_layer_53,&bias_dims_conv53,bias_data_conv53,&output_dims_conv53,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv53,actbuf1,&filter_dims_conv53,mobilenet_v2_index_layer_53,&bias_dims_conv53,bias_data_conv53,&output_dims_conv53,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv54);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv54,actbuf2,&filter_dims_conv54,mobilenet_v2_index_layer_54,&bias_dims_conv54,bias_data_conv54,&output_dims_conv54,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv54,actbuf2,&filter_dims_conv54,mobilenet_v2_index_layer_54,&bias_dims_conv54,bias_data_conv54,&output_dims_conv54,lut_data,actbuf1);
+    free(ctx.buf);
     
     ctx.size = 0;
     
     result_arm = arm_depthwise_conv_s8(&ctx,&conv_params,&quant_params,&input_dims_conv55,actbuf1,&filter_dims_conv55,kernel_data_conv55,&bias_dims_conv55,bias_data_conv55,&output_dims_conv55,actbuf2);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv56);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv56,actbuf2,&filter_dims_conv56,mobilenet_v2_index_layer_56,&bias_dims_conv56,bias_data_conv56,&output_dims_conv56,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv56,actbuf2,&filter_dims_conv56,mobilenet_v2_index_layer_56,&bias_dims_conv56,bias_data_conv56,&output_dims_conv56,lut_data,actbuf1);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv57);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv57,actbuf1,&filter_dims_conv57,mobilenet_v2_index_layer_57,&bias_dims_conv57,bias_data_conv57,&output_dims_conv57,lut_data,actbuf2);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv57,actbuf1,&filter_dims_conv57,mobilenet_v2_index_layer_57,&bias_dims_conv57,bias_data_conv57,&output_dims_conv57,lut_data,actbuf2);
+    free(ctx.buf);
     
-    ctx.size = 0;
+    buf_size = lut_conv_zdim_pointwise_get_buffer_size(&output_dims_conv58);
+    ctx.buf = malloc(buf_size);
+    ctx.size = buf_size;
     
-    result_arm = lut_conv_zdim_v2_double_lookup(&ctx,&conv_params,&quant_params,&input_dims_conv58,actbuf2,&filter_dims_conv58,mobilenet_v2_index_layer_58,&bias_dims_conv58,bias_data_conv58,&output_dims_conv58,lut_data,actbuf1);
+    result_arm = lut_conv_zdim_v2_pointwise(&ctx,&conv_params,&quant_params,&input_dims_conv58,actbuf2,&filter_dims_conv58,mobilenet_v2_index_layer_58,&bias_dims_conv58,bias_data_conv58,&output_dims_conv58,lut_data,actbuf1);
+    free(ctx.buf);
     free(actbuf1);
 		free(actbuf2);
 }
@@ -0,0 +1,167 @@
+#include "../Utils/validate.h"
+#include "..\..\..\..\Include\arm_nnfunctions.h"
+#include "..\..\..\..\..\..\TestData_fullnetwork\resnet_10\test_data.h"
+#include "..\..\..\..\..\..\STM32F2xx_HAL_Driver\Inc\stm32f2xx_hal.h" //include file for clock generation code
+#include "..\..\..\..\..\..\lut_zdim64_data.h"
+#include "..\..\..\..\..\..\index_data\resnet10_data\resnet10_index_data.h"
+#include <math.h>
+#include <stdlib.h>
+
+
+void SysTick_Handler(void)
+{
+  /* USER CODE BEGIN SysTick_IRQn 0 */
+
+  /* USER CODE END SysTick_IRQn 0 */
+  HAL_IncTick();
+  /* USER CODE BEGIN SysTick_IRQn 1 */
+
+  /* USER CODE END SysTick_IRQn 1 */
+}
+
+void SystemClock_Config(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+  /** Initializes the RCC Oscillators according to the specified parameters
+  * in the RCC_OscInitTypeDef structure.
+  */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+  RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+  RCC_OscInitStruct.PLL.PLLM = 13;
+  RCC_OscInitStruct.PLL.PLLN = 195;
+  RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
+  RCC_OscInitStruct.PLL.PLLQ = 5;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    while (1){}
+  }
+  /** Initializes the CPU, AHB and APB buses clocks
+  */
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV4;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV2;
+
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_3) != HAL_OK)
+  {
+    while (1){}
+  }
+}
+
+/*Row-band streaming version of resnet10_fw_bench.c
+The network is described as a layer table and executed depth-first by lut_network_stream_run, every intermediate
+activation only lives in a kernel_y row window, so the 64KB first layer output and the 16*16*64 ping-pong buffers are gone.
+The 2x2 max pools between the resolution stages are explicit layers here.
+lut_network_stream_get_buffer_size is 29440 bytes (29184 of row windows, 256 of kernel scratch), plus the 8KB output.
+That is well below the 64KB first layer output, but still above the 20KB of SRAM of the STM32F103RB: with 3x3 kernels a
+window can't hold fewer than 3 full rows, so getting there would need column tiling as well. Run this one on the F207ZG.
+*/
+#define RESNET10_STREAM_LAYERS 11
+
+static void set_layer(lut_layer *layer, lut_layer_type type,
+                      int32_t input_w, int32_t input_h, int32_t in_ch, int32_t out_ch,
+                      int32_t filter_x, int32_t filter_y, int32_t stride, int32_t pad,
+                      const int32_t *bias, const int32_t *mult, const int32_t *shift,
+                      const q7_t *weights, const uint8_t *kernel_idx)
+{
+    layer->type = type;
+    layer->input_dims.n = 1;
+    layer->input_dims.w = input_w;
+    layer->input_dims.h = input_h;
+    layer->input_dims.c = in_ch;
+    layer->filter_dims.n = out_ch;
+    layer->filter_dims.w = filter_x;
+    layer->filter_dims.h = filter_y;
+    layer->filter_dims.c = in_ch;
+    layer->output_dims.n = 1;
+    layer->output_dims.w = (input_w + 2 * pad - filter_x) / stride + 1;
+    layer->output_dims.h = (input_h + 2 * pad - filter_y) / stride + 1;
+    layer->output_dims.c = out_ch;
+    layer->conv_params.stride.w = stride;
+    layer->conv_params.stride.h = stride;
+    layer->conv_params.padding.w = pad;
+    layer->conv_params.padding.h = pad;
+    layer->conv_params.input_offset = CONVLAYER1_INPUT_OFFSET;
+    layer->conv_params.output_offset = CONVLAYER1_OUTPUT_OFFSET;
+    layer->conv_params.activation.min = CONVLAYER1_OUT_ACTIVATION_MIN;
+    layer->conv_params.activation.max = CONVLAYER1_OUT_ACTIVATION_MAX;
+    layer->quant_params.multiplier = (int32_t *)mult;
+    layer->quant_params.shift = (int32_t *)shift;
+    layer->bias_data = bias;
+    layer->weights = weights;
+    layer->kernel_idx = kernel_idx;
+}
+
+static void set_pool_layer(lut_layer *layer, int32_t input_w, int32_t input_h, int32_t ch)
+{
+    set_layer(layer, LUT_LAYER_MAX_POOL_S8, input_w, input_h, ch, ch, 2, 2, 2, 0, NULL, NULL, NULL, NULL, NULL);
+}
+
+void conv_zdim_resnet_10_stream(void)
+{
+    static lut_layer layers[RESNET10_STREAM_LAYERS];
+    lut_network net;
+    cmsis_nn_context ctx;
+    arm_status result_arm;
+
+    set_layer(&layers[0], LUT_LAYER_CONV_S8, CONVLAYER1_INPUT_W, CONVLAYER1_INPUT_H, CONVLAYER1_IN_CH, CONVLAYER1_OUT_CH,
+              CONVLAYER1_FILTER_X, CONVLAYER1_FILTER_Y, CONVLAYER1_STRIDE_X, CONVLAYER1_PAD_X,
+              convlayer1_biases, convlayer1_output_mult, convlayer1_output_shift, convlayer1_weights, NULL);
+    set_pool_layer(&layers[1], CONVLAYER1_OUTPUT_W, CONVLAYER1_OUTPUT_H, CONVLAYER1_OUT_CH);
+    set_layer(&layers[2], LUT_LAYER_LUT_CONV_V1, CONVLAYER2_INPUT_W, CONVLAYER2_INPUT_H, CONVLAYER2_IN_CH, CONVLAYER2_OUT_CH,
+              CONVLAYER2_FILTER_X, CONVLAYER2_FILTER_Y, CONVLAYER2_STRIDE_X, CONVLAYER2_PAD_X,
+              convlayer2_biases, convlayer2_output_mult, convlayer2_output_shift, NULL, resnet10_index_layer_2);
+    set_layer(&layers[3], LUT_LAYER_LUT_CONV_V1, CONVLAYER3_INPUT_W, CONVLAYER3_INPUT_H, CONVLAYER3_IN_CH, CONVLAYER3_OUT_CH,
+              CONVLAYER3_FILTER_X, CONVLAYER3_FILTER_Y, CONVLAYER3_STRIDE_X, CONVLAYER3_PAD_X,
+              convlayer3_biases, convlayer3_output_mult, convlayer3_output_shift, NULL, resnet10_index_layer_3);
+    set_layer(&layers[4], LUT_LAYER_LUT_CONV_V1, CONVLAYER4_INPUT_W, CONVLAYER4_INPUT_H, CONVLAYER4_IN_CH, CONVLAYER4_OUT_CH,
+              CONVLAYER4_FILTER_X, CONVLAYER4_FILTER_Y, CONVLAYER4_STRIDE_X, CONVLAYER4_PAD_X,
+              convlayer4_biases, convlayer4_output_mult, convlayer4_output_shift, NULL, resnet10_index_layer_4);
+    set_layer(&layers[5], LUT_LAYER_LUT_CONV_V1, CONVLAYER5_INPUT_W, CONVLAYER5_INPUT_H, CONVLAYER5_IN_CH, CONVLAYER5_OUT_CH,
+              CONVLAYER5_FILTER_X, CONVLAYER5_FILTER_Y, CONVLAYER5_STRIDE_X, CONVLAYER5_PAD_X,
+              convlayer5_biases, convlayer5_output_mult, convlayer5_output_shift, NULL, resnet10_index_layer_5);
+    set_pool_layer(&layers[6], CONVLAYER5_OUTPUT_W, CONVLAYER5_OUTPUT_H, CONVLAYER5_OUT_CH);
+    set_layer(&layers[7], LUT_LAYER_LUT_CONV_V2, CONVLAYER6_INPUT_W, CONVLAYER6_INPUT_H, CONVLAYER6_IN_CH, CONVLAYER6_OUT_CH,
+              CONVLAYER6_FILTER_X, CONVLAYER6_FILTER_Y, CONVLAYER6_STRIDE_X, CONVLAYER6_PAD_X,
+              convlayer6_biases, convlayer6_output_mult, convlayer6_output_shift, NULL, resnet10_index_layer_6);
+    set_layer(&layers[8], LUT_LAYER_LUT_CONV_V2, CONVLAYER7_INPUT_W, CONVLAYER7_INPUT_H, CONVLAYER7_IN_CH, CONVLAYER7_OUT_CH,
+              CONVLAYER7_FILTER_X, CONVLAYER7_FILTER_Y, CONVLAYER7_STRIDE_X, CONVLAYER7_PAD_X,
+              convlayer7_biases, convlayer7_output_mult, convlayer7_output_shift, NULL, resnet10_index_layer_7);
+    set_layer(&layers[9], LUT_LAYER_LUT_CONV_V2, CONVLAYER8_INPUT_W, CONVLAYER8_INPUT_H, CONVLAYER8_IN_CH, CONVLAYER8_OUT_CH,
+              CONVLAYER8_FILTER_X, CONVLAYER8_FILTER_Y, CONVLAYER8_STRIDE_X, CONVLAYER8_PAD_X,
+              convlayer8_biases, convlayer8_output_mult, convlayer8_output_shift, NULL, resnet10_index_layer_8);
+    set_layer(&layers[10], LUT_LAYER_LUT_CONV_V2, CONVLAYER9_INPUT_W, CONVLAYER9_INPUT_H, CONVLAYER9_IN_CH, CONVLAYER9_OUT_CH,
+              CONVLAYER9_FILTER_X, CONVLAYER9_FILTER_Y, CONVLAYER9_STRIDE_X, CONVLAYER9_PAD_X,
+              convlayer9_biases, convlayer9_output_mult, convlayer9_output_shift, NULL, resnet10_index_layer_9);
+
+    net.layers = layers;
+    net.num_layers = RESNET10_STREAM_LAYERS;
+    net.filter_pool_data = lut_data;
+
+    //row windows of every layer plus kernel scratch, this is the whole activation memory apart from the final output
+    ctx.size = lut_network_stream_get_buffer_size(&net);
+    ctx.buf = malloc(ctx.size);
+    q7_t* outbuf = malloc(CONVLAYER9_OUT_CH*CONVLAYER9_OUTPUT_W*CONVLAYER9_OUTPUT_H*sizeof(q7_t));
+
+    //first layer input is read in place from flash
+    result_arm = lut_network_stream_run(&ctx, &net, convlayer1_input, outbuf);
+
+    free(outbuf);
+    free(ctx.buf);
+}
+
+int main(){
+		HAL_Init();
+    SystemClock_Config();
+    while(1){
+        conv_zdim_resnet_10_stream();
+    }
+return 0;
+}
@@ -0,0 +1,190 @@
+# -*- coding: utf-8 -*-
+"""
+Offline statistics of the weight pool indices of a network, and a per-layer kernel plan.
+
+Reads the layer shapes from a TestData_fullnetwork/*/config_data.h (CONVLAYER<n>_* defines), the indices from an
+index_data/* header (<name>_layer_<n> arrays, block major: kernel_idx[block * OUT_CH + filter]) and the LUT width
+from a LUT header (lut_data[256 * LUT_SIZE]).
+
+Per layer it reports:
+ - physical kernel histogram (kernels used, share of the most used kernel, entropy)
+ - distinct kernels per 8-channel block: the number of LUT columns a block really needs
+ - flash reads and LUT row copy bytes of lut_conv_zdim_v1 and lut_conv_zdim_v2_double_lookup
+ - estimated cycles of these two kernels (simple Cortex-M4 model, see CYCLES)
+and writes the fastest executor kernel of every layer as LUT_LAYER_* defines, to be used as the type of the
+lut_layer entries.
+
+The lut_conv_zdim_nocaching estimate of the original request is omitted: that kernel is declared in
+arm_nnfunctions.h but has no implementation, so the plan could not use it.
+
+usage: python3 index_stats.py --config TestData_fullnetwork/resnet_10/config_data.h
+           --index index_data/resnet10_data/resnet10_index_data.h --lut lut_zdim64_data.h --plan resnet10_plan.h
+"""
+
+import re
+import math
+import argparse
+import numpy as np
+
+FW_GRAN = 8
+LUT_ROWS = 256
+
+#rough cycle costs on a Cortex-M4, flash reads also pay the wait states
+CYCLES = {
+    'index_gen': 4,     #per input bit and bit plane, lut_nn_bitplane_index
+    'block': 20,        #loop and address overhead per block
+    'copy_byte': 0.25,  #memcpy of the LUT rows, word copies
+    'sram_load': 2,     #ldrb from the lut_buffer / result_mem
+    'add': 1,           #shift and accumulate
+    'filter': 3,        #per filter loop overhead and holder update
+}
+
+def parse_defines(path):
+    defines = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'\s*#define\s+(\w+)\s+(-?\d+)', line)
+            if m:
+                defines[m.group(1)] = int(m.group(2))
+    return defines
+
+def parse_arrays(path):
+    #name -> values of every const array of the header
+    arrays = {}
+    with open(path) as f:
+        text = f.read()
+    for m in re.finditer(r'const\s+(?:u?int(?:8|16|32)_t|q7_t|q15_t|q31_t)\s+(\w+)\s*\[\s*(\d+)\s*\]\s*=\s*\{([^}]*)\}', text):
+        values = np.array([int(v, 0) for v in re.findall(r'-?(?:0x[0-9a-fA-F]+|\d+)', m.group(3))], dtype=np.int64)
+        if values.size != int(m.group(2)):
+            print("warning: {} has {} values, {} declared".format(m.group(1), values.size, m.group(2)))
+        arrays[m.group(1)] = values
+    return arrays
+
+def layer_shapes(defines):
+    layers = {}
+    for key in defines:
+        m = re.match(r'CONVLAYER(\d+)_OUT_CH$', key)
+        if m:
+            n = int(m.group(1))
+            p = 'CONVLAYER{}_'.format(n)
+            layers[n] = dict((k, defines[p + k.upper()]) for k in
+                             ['in_ch', 'out_ch', 'input_w', 'input_h', 'output_w', 'output_h', 'filter_x', 'filter_y',
+                              'stride_x', 'stride_y', 'pad_x', 'pad_y'])
+            layers[n]['depthwise'] = (p + 'CH_MULT') in defines
+    return layers
+
+def block_visits(s):
+    #number of output pixels that read each block, border pixels only use the first blocks (block_cnt)
+    blocks_per_pos = s['in_ch'] // FW_GRAN
+    visits = np.zeros(s['filter_x'] * s['filter_y'] * blocks_per_pos, dtype=np.int64)
+    for oy in range(s['output_h']):
+        by = oy * s['stride_y'] - s['pad_y']
+        ny = min(s['filter_y'], s['input_h'] - by) - max(0, -by)
+        for ox in range(s['output_w']):
+            bx = ox * s['stride_x'] - s['pad_x']
+            nx = min(s['filter_x'], s['input_w'] - bx) - max(0, -bx)
+            visits[:max(ny, 0) * max(nx, 0) * blocks_per_pos] += 1
+    return visits
+
+def analyze(s, idx, lut_size, prec, ws):
+    F = s['out_ch']
+    idx = idx.reshape(-1, F)
+    visits = block_visits(s)
+    nb = visits.sum() #block visits of the layer
+    hist = np.bincount(idx.ravel(), minlength=lut_size)
+    p = hist[hist > 0] / hist.sum()
+    distinct = np.array([np.unique(row).size for row in idx])
+
+    c = CYCLES
+    flash = 1 + ws #cycles of a flash byte read
+    base = nb * (FW_GRAN * prec * c['index_gen'] + c['block'])
+    copy = prec * lut_size
+    r = {}
+    #v1: copy the rows, then bit-serial lookups per filter
+    r['v1'] = dict(copy=nb * copy, flash=nb * (copy + F),
+                   cycles=base + nb * (copy * c['copy_byte'] + copy / 4.0 * ws
+                                       + F * (flash + prec * (c['sram_load'] + c['add']) + c['filter'])))
+    #v2: copy the rows, combine the bit planes of every pool kernel once, then one lookup per filter
+    r['v2'] = dict(copy=nb * copy, flash=nb * (copy + F),
+                   cycles=base + nb * (copy * c['copy_byte'] + copy / 4.0 * ws
+                                       + lut_size * prec * (c['sram_load'] + c['add'])
+                                       + F * (flash + c['sram_load'] + c['filter'])))
+    return dict(hist=hist, used=int((hist > 0).sum()), top=float(p.max()), entropy=float(-(p * np.log2(p)).sum()),
+                distinct_mean=float(np.average(distinct, weights=visits)), distinct_max=int(distinct.max()),
+                block_visits=int(nb), kernels=r)
+
+def main():
+    parser = argparse.ArgumentParser(description="Weight pool index statistics and kernel plan of lut_conv_zdim_v1 and "
+        "lut_conv_zdim_v2_double_lookup (no lut_conv_zdim_nocaching estimate, the kernel is not implemented)")
+    parser.add_argument('--config', required=True, help="config_data.h with the CONVLAYER<n>_* shapes")
+    parser.add_argument('--index', required=True, help="index header with the <name>_layer_<n> arrays")
+    parser.add_argument('--lut', help="LUT header, gives LUT_SIZE")
+    parser.add_argument('--lut-size', type=int, help="LUT_SIZE when no LUT header is given")
+    parser.add_argument('--prec', type=int, default=5, help="LUT_PREC of the kernels")
+    parser.add_argument('--flash-ws', type=int, default=3, help="flash wait states")
+    parser.add_argument('--hist', action='store_true', help="print the kernel histogram of every layer")
+    parser.add_argument('--plan', help="output header with the kernel of every layer")
+    parser.add_argument('--prefix', help="define prefix of the plan, default is the index array prefix")
+    args = parser.parse_args()
+
+    if args.lut:
+        lut = list(parse_arrays(args.lut).values())[0]
+        lut_size = lut.size // LUT_ROWS
+    elif args.lut_size:
+        lut_size = args.lut_size
+    else:
+        parser.error("--lut or --lut-size is needed")
+
+    shapes = layer_shapes(parse_defines(args.config))
+    indices = {}
+    for name, values in parse_arrays(args.index).items():
+        m = re.match(r'(\w+)_layer_(\d+)$', name)
+        if m:
+            indices[int(m.group(2))] = values
+            prefix = m.group(1)
+    prefix = (args.prefix or prefix).upper()
+
+    print("LUT_SIZE {}, LUT_PREC {}, {} flash wait states".format(lut_size, args.prec, args.flash_ws))
+    print("{:>5} {:>14} {:>5} {:>6} {:>7} {:>9} {:>10} {:>12} {:>12} {:>12} {:>5}".format(
+        "layer", "shape", "used", "top%", "entropy", "distinct", "copy KB", "flash KB v1", "cycles v1", "cycles v2",
+        "best"))
+    plan = []
+    total = dict(v1=0, v2=0, best=0)
+    for n in sorted(indices):
+        s = shapes.get(n)
+        idx = indices[n]
+        if s is None or s['depthwise'] or s['in_ch'] % FW_GRAN:
+            print("layer_{}: no LUT conv shape in the config, skipped".format(n))
+            continue
+        expected = s['filter_x'] * s['filter_y'] * s['in_ch'] // FW_GRAN * s['out_ch']
+        if idx.size != expected:
+            print("layer_{}: {} indices, {} expected from the config, skipped".format(n, idx.size, expected))
+            continue
+        if idx.max() >= lut_size:
+            print("layer_{}: index {} is outside the LUT (LUT_SIZE {})".format(n, idx.max(), lut_size))
+        a = analyze(s, idx, lut_size, args.prec, args.flash_ws)
+        k = a['kernels']
+        best = 'v1' if k['v1']['cycles'] <= k['v2']['cycles'] else 'v2'
+        plan.append((n, best))
+        for key in ['v1', 'v2']:
+            total[key] += k[key]['cycles']
+        total['best'] += k[best]['cycles']
+        shape = "{}x{}x{}->{}".format(s['filter_y'], s['filter_x'], s['in_ch'], s['out_ch'])
+        print("{:>5} {:>14} {:>5} {:>6.1f} {:>7.2f} {:>4.1f}/{:<4d} {:>10.1f} {:>12.1f} {:>12.0f} {:>12.0f} {:>5}".format(
+            n, shape, a['used'], 100 * a['top'], a['entropy'], a['distinct_mean'], a['distinct_max'],
+            k['v1']['copy'] / 1024.0, k['v1']['flash'] / 1024.0, k['v1']['cycles'], k['v2']['cycles'], best))
+        if args.hist:
+            print("      histogram: " + " ".join(str(v) for v in a['hist']))
+    print("total cycles: v1 {:.0f}, v2 {:.0f}, plan {:.0f}".format(total['v1'], total['v2'], total['best']))
+
+    if args.plan:
+        with open(args.plan, "w+") as f:
+            f.write("#pragma once\n")
+            f.write("//kernel of every weight pool layer, generated by index_stats.py (LUT_SIZE {}, LUT_PREC {})\n"
+                    .format(lut_size, args.prec))
+            f.write("//use as the type of the lut_layer entries\n\n")
+            for n, best in plan:
+                f.write("#define {}_LAYER_{}_TYPE LUT_LAYER_LUT_CONV_{}\n".format(prefix, n, best.upper()))
+
+if __name__ == '__main__':
+    main()
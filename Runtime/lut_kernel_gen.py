@@ -0,0 +1,298 @@
+# -*- coding: utf-8 -*-
+"""
+Generates shape specialised LUT convolution kernels for the layers of a network.
+
+The generic lut_conv_zdim_v1 / lut_conv_zdim_v2_double_lookup take every size at run time and clip the kernel window
+of every output pixel with MIN/MAX. For a network whose shapes are fixed at deployment this emits one kernel per layer
+with the sizes, strides and horizontal padding as constants, the bit-plane loop unrolled, and the output pixels of a
+row split into border / interior / border loops: interior pixels run the full window with no clipping.
+
+The output is <out>.c and <out>.h. <name>_bind(layers, num_layers) stores the matching specialised kernel in the
+kernel field of every lut_layer entry with the same type and shape, lut_layer_run_rows then calls it instead of the
+generic kernel. Layers without a generated kernel keep the generic one. The kernels take the number of rows and the
+vertical padding from their arguments, so row bands (stream, threads executors) work like with the generic kernels.
+
+usage: python3 lut_kernel_gen.py --config TestData_fullnetwork/resnet_10/config_data.h --layers 2-9
+           --plan resnet10_plan.h --lut-size 32 --name resnet10 --out resnet10_kernels
+"""
+
+import re
+import argparse
+import os.path
+
+from index_stats import parse_defines, layer_shapes, FW_GRAN
+from model_pack import parse_layers
+
+LUT_PREC = 5
+
+def interior(size_in, size_out, kernel, stride, pad):
+    #output positions whose window is fully inside the input
+    lo = min(size_out, (pad + stride - 1) // stride)
+    hi = max(lo, min(size_out, (size_in - kernel + pad) // stride + 1))
+    return lo, hi
+
+def bit_sum(buffer, k):
+    #unrolled sum over the bit planes of column k
+    terms = ["(int16_t){}[{}{}]".format(buffer, 'LUT_SIZE * {} + '.format(b) if b else '', k) +
+             (" << {}".format(b) if b else '') for b in range(LUT_PREC)]
+    return "\n          + ".join("(" + t + ")" if '<<' in t else t for t in terms)
+
+KERNEL = '''
+/* layer {n}: {input_h}x{input_w}x{in_ch} -> {output_h}x{output_w}x{out_ch}, {filter_y}x{filter_x} stride {stride_y}x{stride_x}, pad {pad_y}x{pad_x}, {generic} */
+#define {P}_IN_W {input_w}
+#define {P}_IN_CH {in_ch}
+#define {P}_OUT_W {output_w}
+#define {P}_OUT_CH {out_ch}
+#define {P}_KY {filter_y}
+#define {P}_KX {filter_x}
+#define {P}_SY {stride_y}
+#define {P}_SX {stride_x}
+#define {P}_PX {pad_x}
+#define {P}_X_LO {x_lo} //interior output columns [X_LO, X_HI)
+#define {P}_X_HI {x_hi}
+
+//one output pixel, the window [ky_start, ky_end) x [kx_start, kx_end) is constant for the interior pixels
+__STATIC_FORCEINLINE void {fn}_pixel(int16_t *conv_out_holder,
+                           const q7_t *input_data,
+                           const int32_t base_y,
+                           const int32_t base_x,
+                           const int32_t ky_start,
+                           const int32_t ky_end,
+                           const int32_t kx_start,
+                           const int32_t kx_end,
+                           const int32_t input_offset,
+                           const uint8_t *kernel_idx,
+                           const uint8_t *filter_pool_data)
+{{
+  uint16_t input_index[LUT_PREC];
+  uint8_t lut_buffer[LUT_PREC * LUT_SIZE];
+  int32_t block_cnt = 0;
+  memset(conv_out_holder, 0, {P}_OUT_CH * sizeof(int16_t));
+  for (int32_t i_ker_y = ky_start; i_ker_y < ky_end; i_ker_y++)
+  {{
+    for (int32_t i_ker_x = kx_start; i_ker_x < kx_end; i_ker_x++)
+    {{
+      const q7_t *in = input_data + ((base_y + i_ker_y) * {P}_IN_W + base_x + i_ker_x) * {P}_IN_CH;
+      for (int32_t i_input_ch = 0; i_input_ch < {P}_IN_CH; i_input_ch += FW_GRAN, block_cnt++)
+      {{
+        lut_nn_bitplane_index(in + i_input_ch, input_offset, LUT_PREC, input_index);
+{copies}
+        const uint8_t *block_idx = kernel_idx + {P}_OUT_CH * block_cnt;
+{lookup}
+      }}
+    }}
+  }}
+}}
+
+__STATIC_FORCEINLINE void {fn}_store(int16_t *conv_out_holder,
+                           const int32_t *bias_data,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const int32_t out_offset,
+                           const int32_t out_activation_min,
+                           const int32_t out_activation_max,
+                           q7_t *out)
+{{
+  for (int32_t i_out_ch = 0; i_out_ch < {P}_OUT_CH; i_out_ch++)
+  {{
+    if (bias_data)
+    {{
+      conv_out_holder[i_out_ch] += bias_data[i_out_ch];
+    }}
+    conv_out_holder[i_out_ch] = arm_nn_requantize(conv_out_holder[i_out_ch], quant_params->multiplier[i_out_ch], quant_params->shift[i_out_ch]);
+    conv_out_holder[i_out_ch] += out_offset;
+    conv_out_holder[i_out_ch] = MAX(conv_out_holder[i_out_ch], out_activation_min);
+    conv_out_holder[i_out_ch] = MIN(conv_out_holder[i_out_ch], out_activation_max);
+    out[i_out_ch] = (int8_t)conv_out_holder[i_out_ch];
+  }}
+}}
+
+arm_status {fn}(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const uint8_t* kernel_idx,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           const uint8_t* filter_pool_data,
+                           q7_t *output_data)
+{{
+  (void)ctx;
+  (void)filter_dims;
+  (void)bias_dims;
+  //rows and vertical padding stay run time parameters for the row band views of lut_layer_run_rows
+  const int32_t input_y = input_dims->h;
+  const int32_t output_y = output_dims->h;
+  const int32_t pad_y = conv_params->padding.h;
+  const int32_t input_offset = conv_params->input_offset;
+  const int32_t out_offset = conv_params->output_offset;
+  const int32_t out_activation_min = conv_params->activation.min;
+  const int32_t out_activation_max = conv_params->activation.max;
+  int16_t conv_out_holder[{P}_OUT_CH];
+
+  for (int32_t i_batch = 0; i_batch < input_dims->n; i_batch++)
+  {{
+    for (int32_t i_out_y = 0; i_out_y < output_y; i_out_y++)
+    {{
+      const int32_t base_y = {P}_SY * i_out_y - pad_y;
+      const int32_t ky_start = MAX(0, -base_y);
+      const int32_t ky_end = MIN({P}_KY, input_y - base_y);
+      q7_t *out = output_data + i_out_y * {P}_OUT_W * {P}_OUT_CH;
+      //border pixels clip the window, [x_lo, x_hi) only exists when the whole row of the window is inside
+      const int32_t x_lo = (ky_start == 0 && ky_end == {P}_KY) ? {P}_X_LO : {P}_OUT_W;
+      const int32_t x_hi = (ky_start == 0 && ky_end == {P}_KY) ? {P}_X_HI : {P}_OUT_W;
+      int32_t i_out_x = 0;
+      for (; i_out_x < x_lo; i_out_x++)
+      {{
+        const int32_t base_x = {P}_SX * i_out_x - {P}_PX;
+        {fn}_pixel(conv_out_holder, input_data, base_y, base_x, ky_start, ky_end, MAX(0, -base_x),
+                   MIN({P}_KX, {P}_IN_W - base_x), input_offset, kernel_idx, filter_pool_data);
+        {fn}_store(conv_out_holder, bias_data, quant_params, out_offset, out_activation_min, out_activation_max,
+                   out + i_out_x * {P}_OUT_CH);
+      }}
+      for (; i_out_x < x_hi; i_out_x++)
+      {{
+        {fn}_pixel(conv_out_holder, input_data, base_y, {P}_SX * i_out_x - {P}_PX, 0, {P}_KY, 0, {P}_KX,
+                   input_offset, kernel_idx, filter_pool_data);
+        {fn}_store(conv_out_holder, bias_data, quant_params, out_offset, out_activation_min, out_activation_max,
+                   out + i_out_x * {P}_OUT_CH);
+      }}
+      for (; i_out_x < {P}_OUT_W; i_out_x++)
+      {{
+        const int32_t base_x = {P}_SX * i_out_x - {P}_PX;
+        {fn}_pixel(conv_out_holder, input_data, base_y, base_x, ky_start, ky_end, MAX(0, -base_x),
+                   MIN({P}_KX, {P}_IN_W - base_x), input_offset, kernel_idx, filter_pool_data);
+        {fn}_store(conv_out_holder, bias_data, quant_params, out_offset, out_activation_min, out_activation_max,
+                   out + i_out_x * {P}_OUT_CH);
+      }}
+    }}
+    input_data += input_y * {P}_IN_W * {P}_IN_CH;
+    output_data += output_y * {P}_OUT_W * {P}_OUT_CH;
+  }}
+  return ARM_MATH_SUCCESS;
+}}
+'''
+
+LOOKUP_V1 = '''        for (int32_t i_out_ch = 0; i_out_ch < {P}_OUT_CH; i_out_ch++)
+        {{
+          const int32_t k = block_idx[i_out_ch];
+          conv_out_holder[i_out_ch] += {sum};
+        }}'''
+
+LOOKUP_V2 = '''        uint16_t result_mem[LUT_SIZE];
+        for (int32_t k = 0; k < LUT_SIZE; k++)
+        {{
+          result_mem[k] = {sum};
+        }}
+        for (int32_t i_out_ch = 0; i_out_ch < {P}_OUT_CH; i_out_ch++)
+        {{
+          conv_out_holder[i_out_ch] += result_mem[block_idx[i_out_ch]];
+        }}'''
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate shape specialised LUT conv kernels")
+    parser.add_argument('--config', required=True, help="config_data.h with the CONVLAYER<n>_* shapes")
+    parser.add_argument('--layers', required=True, help="layers to generate, e.g. 2-9")
+    parser.add_argument('--type', default='LUT_CONV_V2', choices=['LUT_CONV_V1', 'LUT_CONV_V2'],
+                        help="kernel of the layers without a plan entry")
+    parser.add_argument('--v1', default='', help="layers generated as LUT_CONV_V1 whatever --type is, e.g. 1-2")
+    parser.add_argument('--plan', help="kernel plan header of index_stats.py, layers planned on another kernel are skipped")
+    parser.add_argument('--lut-size', type=int, default=32, help="LUT_SIZE of the pool")
+    parser.add_argument('--name', required=True, help="prefix of the generated functions")
+    parser.add_argument('--out', required=True, help="output path without extension, writes <out>.c and <out>.h")
+    args = parser.parse_args()
+
+    shapes = layer_shapes(parse_defines(args.config))
+    plan = {}
+    if args.plan:
+        with open(args.plan) as f:
+            for m in re.finditer(r'#define\s+\w+_LAYER_(\d+)_TYPE\s+LUT_LAYER_(\w+)', f.read()):
+                plan[int(m.group(1))] = m.group(2)
+
+    v1_layers = parse_layers(args.v1) if args.v1 else []
+    kernels = []
+    code = []
+    for n in parse_layers(args.layers):
+        if n not in shapes:
+            parser.error("layer {} is not in the config".format(n))
+        s = shapes[n]
+        type = plan.get(n, 'LUT_CONV_V1' if n in v1_layers else args.type)
+        if type not in ('LUT_CONV_V1', 'LUT_CONV_V2'):
+            print("layer {}: planned on {}, not generated".format(n, type))
+            continue
+        if s['depthwise'] or s['in_ch'] % FW_GRAN:
+            print("layer {}: depthwise or channels not a multiple of {}, not generated".format(n, FW_GRAN))
+            continue
+        v2 = type == 'LUT_CONV_V2'
+        fn = '{}_layer{}_{}'.format(args.name, n, 'v2' if v2 else 'v1')
+        P = fn.upper()
+        x_lo, x_hi = interior(s['input_w'], s['output_w'], s['filter_x'], s['stride_x'], s['pad_x'])
+        copies = '\n'.join('        memcpy(lut_buffer + {}, filter_pool_data + input_index[{}] * LUT_SIZE, LUT_SIZE);'.format(
+            'LUT_SIZE * {}'.format(b) if b else '0', b) for b in range(LUT_PREC))
+        lookup = (LOOKUP_V2 if v2 else LOOKUP_V1).format(P=P, sum=bit_sum('lut_buffer', 'k'))
+        code.append(KERNEL.format(n=n, fn=fn, P=P, x_lo=x_lo, x_hi=x_hi, copies=copies, lookup=lookup,
+                                  generic='lut_conv_zdim_v2_double_lookup' if v2 else 'lut_conv_zdim_v1', **s))
+        kernels.append((n, type, fn, s))
+        print("layer {}: {} {}x{}x{} -> {}x{}x{}, interior columns {}..{}".format(
+            n, fn, s['input_h'], s['input_w'], s['in_ch'], s['output_h'], s['output_w'], s['out_ch'], x_lo, x_hi - 1))
+
+    base = os.path.basename(args.out)
+    guard = '_' + re.sub(r'\W', '_', base).upper() + '_H'
+    with open(args.out + '.h', 'w') as f:
+        f.write('/* Generated by lut_kernel_gen.py from {}, do not edit */\n'.format(os.path.basename(args.config)))
+        f.write('#ifndef {0}\n#define {0}\n\n#include "arm_nnfunctions.h"\n\n'.format(guard))
+        f.write('#ifdef __cplusplus\nextern "C" {\n#endif\n\n')
+        f.write('/* Stores the specialised kernel of every matching layer in layers[i].kernel, returns the number of layers bound */\n')
+        f.write('int32_t {}_bind(lut_layer *layers, const int32_t num_layers);\n\n'.format(args.name))
+        for n, type, fn, s in kernels:
+            f.write('arm_status {}(const cmsis_nn_context *ctx, const cmsis_nn_conv_params *conv_params,\n'
+                    '    const cmsis_nn_per_channel_quant_params *quant_params, const cmsis_nn_dims *input_dims,\n'
+                    '    const q7_t *input_data, const cmsis_nn_dims *filter_dims, const uint8_t *kernel_idx,\n'
+                    '    const cmsis_nn_dims *bias_dims, const int32_t *bias_data, const cmsis_nn_dims *output_dims,\n'
+                    '    const uint8_t *filter_pool_data, q7_t *output_data);\n'.format(fn))
+        f.write('\n#ifdef __cplusplus\n}\n#endif\n\n#endif\n')
+
+    with open(args.out + '.c', 'w') as f:
+        f.write('/*\nGenerated by lut_kernel_gen.py from {}, do not edit.\n'
+                'Shape specialised LUT convolution kernels of {}, bit exact with the generic kernels.\n*/\n'.format(
+                    os.path.basename(args.config), args.name))
+        f.write('#include "{}.h"\n#include "arm_nnsupportfunctions.h"\n#include <string.h>\n\n'.format(base))
+        f.write('#define LUT_PREC {}\n#define FW_GRAN {}\n'.format(LUT_PREC, FW_GRAN))
+        f.write('#ifndef LUT_SIZE\n#define LUT_SIZE {0}\n#endif\n#if LUT_SIZE != {0}\n'
+                '#error "kernels generated for LUT_SIZE {0}"\n#endif\n'.format(args.lut_size))
+        f.write(''.join(code))
+        f.write('\nint32_t {}_bind(lut_layer *layers, const int32_t num_layers)\n{{\n'.format(args.name))
+        f.write('  static const struct\n  {\n    lut_layer_type type;\n    int32_t shape[12]; //in h w c, filter h w, out h w c, stride h w, pad w h\n'
+                '    lut_conv_kernel kernel;\n  } kernels[] = {\n')
+        for n, type, fn, s in kernels:
+            shape = [s[k] for k in ['input_h', 'input_w', 'in_ch', 'filter_y', 'filter_x', 'output_h', 'output_w',
+                                    'out_ch', 'stride_y', 'stride_x', 'pad_x']] + [s['pad_y']]
+            f.write('    {{LUT_LAYER_{}, {{{}}}, {}}},\n'.format(type, ', '.join(str(v) for v in shape), fn))
+        if not kernels:
+            f.write('    {LUT_LAYER_LUT_CONV_V1, {0}, NULL}, //no layer generated, never matches a real layer\n')
+        f.write('  };\n  int32_t bound = 0;\n')
+        f.write('''  for (int32_t i = 0; i < num_layers; i++)
+  {
+    lut_layer *l = &layers[i];
+    const int32_t shape[12] = {l->input_dims.h, l->input_dims.w, l->input_dims.c, l->filter_dims.h, l->filter_dims.w,
+                               l->output_dims.h, l->output_dims.w, l->output_dims.c, l->conv_params.stride.h,
+                               l->conv_params.stride.w, l->conv_params.padding.w, l->conv_params.padding.h};
+    for (uint32_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+      if (kernels[k].type == l->type && memcmp(kernels[k].shape, shape, sizeof(shape)) == 0)
+      {
+        l->kernel = kernels[k].kernel;
+        bound++;
+        break;
+      }
+    }
+  }
+  return bound;
+}
+''')
+    print("{}.c / {}.h: {} kernels".format(args.out, args.out, len(kernels)))
+
+if __name__ == '__main__':
+    main()
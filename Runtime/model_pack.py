@@ -0,0 +1,183 @@
+# -*- coding: utf-8 -*-
+"""
+Packs a weight pool network into one binary model file (.lutm) for lut_model_load.
+
+Inputs are the usual C headers: the layer shapes, bias, multipliers and shifts of a TestData_fullnetwork/* directory
+(config_data.h, biases_data.h, output_mult_data.h, output_shift_data.h, weights_data.h for dense layers), an
+index_data/* header (<name>_layer_<n> arrays) and a LUT header (lut_data[256 * LUT_SIZE]). The kernel of every layer
+is --type, or the LUT_LAYER_* define written by index_stats.py --plan.
+
+Layout (little endian, every section 4-byte aligned, see lut_model_header / lut_model_layer in arm_nn_types.h):
+ header | layer records | LUT | per layer: mult, shift, bias, indices or dense weights
+The indices are stored one uint8 per index, not bit packed, since the kernels read them in place from the model.
+The CRC-32 in the header covers everything after the header. A 2x2 max pool layer is inserted between two selected
+layers when the resolution halves, like in the stream and threads benchmarks.
+
+usage: python3 model_pack.py --data TestData_fullnetwork/resnet_14 --index index_data/resnet_14_data/resnet_14_index_data.h
+           --lut lut_zdim64_data.h --lut-size 32 --layers 2-13 --out resnet_14.lutm
+"""
+
+import re
+import zlib
+import struct
+import argparse
+import os.path
+import numpy as np
+
+from index_stats import parse_defines, parse_arrays, FW_GRAN, LUT_ROWS
+
+MAGIC = 0x4D54554C #"LUTM"
+VERSION = 1
+HEADER = struct.Struct('<IIIIiiII')
+LAYER = struct.Struct('<' + 'i' * 9 + 'i' * 12 + 'I' * 6)
+
+#lut_layer_type
+TYPES = {'CONV_S8': 0, 'LUT_CONV_V1': 1, 'LUT_CONV_V2': 2, 'MAX_POOL_S8': 3, 'LUT_FC': 4,
+         'LUT_CONV_V2_COEFF': 5, 'LUT_CONV_V2_COEFF_SHIFT': 6, 'LUT_CONV_V1_SPARSE': 7, 'LUT_CONV_V2_SPARSE': 8,
+         'LUT_CONV_V1_DYNPREC': 9, 'LUT_CONV_V2_DYNPREC': 10}
+
+def parse_layers(spec):
+    #"2-5,7,9-13" -> [2, 3, 4, 5, 7, 9, ...]
+    layers = []
+    for part in spec.split(','):
+        lo, _, hi = part.partition('-')
+        layers += range(int(lo), int(hi or lo) + 1)
+    return layers
+
+class Packer:
+    def __init__(self):
+        self.data = bytearray()
+        self.base = 0 #offset of self.data in the file
+
+    def add(self, values, dtype):
+        if values is None:
+            return 0
+        offset = self.base + len(self.data)
+        self.data += np.asarray(values).astype(dtype).tobytes()
+        self.data += bytes(-len(self.data) % 4)
+        return offset
+
+def record(type, d, prefix, defines):
+    get = lambda key, default=0: defines.get(prefix + key, default)
+    return dict(type=type, input_offset=get('INPUT_OFFSET'), output_offset=get('OUTPUT_OFFSET'),
+                stride_w=d['stride_x'], stride_h=d['stride_y'], pad_w=d['pad_x'], pad_h=d['pad_y'],
+                act_min=get('OUT_ACTIVATION_MIN', -128), act_max=get('OUT_ACTIVATION_MAX', 127),
+                input_dims=(1, d['input_h'], d['input_w'], d['in_ch']),
+                filter_dims=(d['out_ch'], d['filter_y'], d['filter_x'], d['in_ch']),
+                output_dims=(1, d['output_h'], d['output_w'], d['out_ch']))
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack a weight pool network into a binary model")
+    parser.add_argument('--data', required=True, help="TestData_fullnetwork/<net> directory")
+    parser.add_argument('--index', required=True, help="index header with the <name>_layer_<n> arrays")
+    parser.add_argument('--coeff', help="coefficient header (<name>_layer_<n> arrays) of the coeff layers")
+    parser.add_argument('--lut', required=True, help="LUT header")
+    parser.add_argument('--lut-size', type=int, help="LUT_SIZE the kernels are built with, default is the header width."
+                                                     " A smaller size packs the first 256 * LUT_SIZE bytes, like the kernels read them")
+    parser.add_argument('--layers', required=True, help="layers to pack in order, e.g. 2-13 or 1,2-9")
+    parser.add_argument('--type', default='LUT_CONV_V2', choices=[t for t in TYPES if t not in ('MAX_POOL_S8', 'CONV_S8')],
+                        help="kernel of the LUT layers without a plan entry")
+    parser.add_argument('--plan', help="kernel plan header of index_stats.py")
+    parser.add_argument('--no-pool', action='store_true', help="do not insert max pool layers")
+    parser.add_argument('--out', required=True, help="output model file")
+    args = parser.parse_args()
+
+    defines = parse_defines(os.path.join(args.data, 'config_data.h'))
+    arrays = {}
+    for name in ['biases_data.h', 'output_mult_data.h', 'output_shift_data.h', 'weights_data.h']:
+        path = os.path.join(args.data, name)
+        if os.path.exists(path):
+            arrays.update(parse_arrays(path))
+    indices, coeffs = {}, {}
+    for path, table in [(args.index, indices), (args.coeff, coeffs)]:
+        if path:
+            for name, values in parse_arrays(path).items():
+                m = re.match(r'\w+_layer_(\d+)$', name)
+                if m:
+                    table[int(m.group(1))] = values
+    plan = {}
+    if args.plan:
+        with open(args.plan) as f:
+            for m in re.finditer(r'#define\s+\w+_LAYER_(\d+)_TYPE\s+LUT_LAYER_(\w+)', f.read()):
+                plan[int(m.group(1))] = m.group(2)
+
+    lut = list(parse_arrays(args.lut).values())[0]
+    lut_size = args.lut_size or lut.size // LUT_ROWS
+    if lut.size < LUT_ROWS * lut_size:
+        parser.error("the LUT has {} bytes, LUT_SIZE {} needs {}".format(lut.size, lut_size, LUT_ROWS * lut_size))
+
+    layers = []
+    previous = None
+    for n in parse_layers(args.layers):
+        p = 'CONVLAYER{}_'.format(n)
+        if p + 'OUT_CH' not in defines:
+            parser.error("layer {} is not in the config".format(n))
+        d = dict((k, defines[p + k.upper()]) for k in
+                 ['in_ch', 'out_ch', 'input_w', 'input_h', 'output_w', 'output_h', 'filter_x', 'filter_y',
+                  'stride_x', 'stride_y', 'pad_x', 'pad_y'])
+        if p + 'CH_MULT' in defines:
+            parser.error("layer {} is depthwise, the executor has no depthwise layer".format(n))
+
+        if previous is not None and not args.no_pool and previous['output_w'] == 2 * d['input_w'] \
+                and previous['output_h'] == 2 * d['input_h']:
+            c = previous['out_ch']
+            pool = dict(in_ch=c, out_ch=c, input_w=previous['output_w'], input_h=previous['output_h'],
+                        output_w=d['input_w'], output_h=d['input_h'], filter_x=2, filter_y=2,
+                        stride_x=2, stride_y=2, pad_x=0, pad_y=0)
+            layers.append((record(TYPES['MAX_POOL_S8'], pool, p, defines), {}))
+        elif previous is not None and (previous['output_w'], previous['output_h'], previous['out_ch']) != \
+                (d['input_w'], d['input_h'], d['in_ch']):
+            print("warning: layer {} does not take the output of the previous layer".format(n))
+        previous = d
+
+        name = 'convlayer{}_'.format(n)
+        data = dict(mult=arrays[name + 'output_mult'], shift=arrays[name + 'output_shift'],
+                    bias=arrays.get(name + 'biases'))
+        if n in indices:
+            type = plan.get(n, args.type)
+            expected = d['filter_x'] * d['filter_y'] * d['in_ch'] // FW_GRAN * d['out_ch']
+            if d['in_ch'] % FW_GRAN or indices[n].size != expected:
+                parser.error("layer {}: {} indices, {} expected from the config".format(n, indices[n].size, expected))
+            if indices[n].max() >= lut_size:
+                parser.error("layer {}: index {} is outside the LUT (LUT_SIZE {})".format(n, indices[n].max(), lut_size))
+            data['kernel_idx'] = indices[n]
+            if type.startswith('LUT_CONV_V2_COEFF'):
+                if n not in coeffs:
+                    parser.error("layer {}: {} needs --coeff".format(n, type))
+                data['coeffs'] = coeffs[n]
+        elif name + 'weights' in arrays:
+            type = 'CONV_S8'
+            data['weights'] = arrays[name + 'weights']
+        else:
+            parser.error("layer {} has neither indices nor dense weights".format(n))
+        layers.append((record(TYPES[type], d, p, defines), data))
+
+    #header and layer table first, the data sections follow in layer order
+    packer = Packer()
+    packer.base = HEADER.size + LAYER.size * len(layers)
+    lut_offset = packer.add(lut[:LUT_ROWS * lut_size], np.uint8)
+    table = bytearray()
+    for r, data in layers:
+        offsets = [packer.add(data.get('mult'), '<i4'), packer.add(data.get('shift'), '<i4'),
+                   packer.add(data.get('bias'), '<i4'), packer.add(data.get('kernel_idx'), np.uint8),
+                   packer.add(data.get('coeffs'), np.uint8), packer.add(data.get('weights'), np.int8)]
+        table += LAYER.pack(r['type'], r['input_offset'], r['output_offset'], r['stride_w'], r['stride_h'],
+                            r['pad_w'], r['pad_h'], r['act_min'], r['act_max'],
+                            *(r['input_dims'] + r['filter_dims'] + r['output_dims'] + tuple(offsets)))
+    body = bytes(table) + bytes(packer.data)
+    size = HEADER.size + len(body)
+    header = HEADER.pack(MAGIC, VERSION, size, zlib.crc32(body) & 0xFFFFFFFF, len(layers), lut_size, lut_offset,
+                         HEADER.size)
+    with open(args.out, "wb") as f:
+        f.write(header + body)
+
+    names = dict((v, k) for k, v in TYPES.items())
+    for r, data in layers:
+        print("{:>24} {}x{}x{} -> {}x{}x{}".format(names[r['type']], r['input_dims'][1], r['input_dims'][2],
+                                                  r['input_dims'][3], r['output_dims'][1], r['output_dims'][2],
+                                                  r['output_dims'][3]))
+    print("{}: {} layers, LUT_SIZE {}, {} bytes, crc32 {:08x}".format(args.out, len(layers), lut_size, size,
+                                                                      zlib.crc32(body) & 0xFFFFFFFF))
+
+if __name__ == '__main__':
+    main()